@@ -19,11 +19,11 @@
 #include "common/spi_io.hpp"
 #include "chip/ST7565.hpp"
 #include "common/monograph.hpp"
+#include "common/page_fb.hpp"
+#include "common/page_stream.hpp"
 
 namespace {
 
-	device::trb_io<utils::null_task, uint8_t> timer_b_;
-
 	typedef utils::fifo<uint8_t, 16> buffer;
 	typedef device::uart_io<device::UART0, buffer, buffer> uart;
 	uart uart_;
@@ -49,26 +49,29 @@ namespace {
 	typedef chip::ST7565<SPI, LCD_SEL, LCD_A0, LCD_RES> LCD;
 	LCD 	lcd_(spi_);
 
-	class PLOT {
-	public:
-		typedef int8_t value_type;
+	typedef graphics::page_fb<128, 32> PLOT;
 
-		static const int8_t WIDTH  = 128;
-		static const int8_t HEIGHT = 64;
+	graphics::kfont_null kfont_;
+	graphics::monograph<PLOT> bitmap_(kfont_);
 
-		void clear(uint8_t v = 0)
-		{
-		} 
+	// LCD への転送は、タイマー割り込みで少しずつ行う
+	// （割り込み毎に 32 バイト、リングは 128 バイト）
+	typedef graphics::page_stream<LCD, PLOT, 32> STREAM;
+	STREAM	stream_(lcd_, bitmap_.at_plot());
 
-		void operator() (int8_t x, int8_t y, bool val)
-		{
-			if(x < 0 || x >= WIDTH) return;
-			if(y < 0 || y >= HEIGHT) return;
+	class lcd_task {
+	public:
+		void operator() () {
+			stream_.service();
 		}
 	};
 
-	graphics::kfont_null kfont_;
-	graphics::monograph<PLOT> bitmap_(kfont_);
+	// 1920Hz: 32 バイト毎なら、１フレーム（60Hz）で 1024 バイト転送出来る
+	// （lcd_sim で、copy、page_stream の設定毎の待ち時間を比べられる）
+	static const uint16_t timer_freq_ = 1920;
+	static const uint8_t frame_tick_ = timer_freq_ / 60;
+
+	device::trb_io<lcd_task, uint8_t> timer_b_;
 }
 
 extern "C" {
@@ -152,7 +155,7 @@ int main(int argc, char *argv[])
 	// タイマーＢ初期化
 	{
 		uint8_t ir_level = 2;
-		timer_b_.start(60, ir_level);
+		timer_b_.start(timer_freq_, ir_level);
 	}
 
 	// UART の設定 (P1_4: TXD0[out], P1_5: RXD0[in])
@@ -188,9 +191,28 @@ int main(int argc, char *argv[])
 	uint16_t xx;
 	uint16_t yy;
 	uint8_t loop = 20;
+	uint8_t tick = frame_tick_;
+	uint16_t sec = 0;
+	uint16_t frame = stream_.get_frame();
 	while(1) {
 		timer_b_.sync();
-///		lcd_.copy(bitmap_.fb(), bitmap_.page_num());
+
+		++sec;
+		if(sec >= timer_freq_) {
+			sec = 0;
+			uint16_t n = stream_.get_frame();
+			utils::format("%d fps\n") % (n - frame);
+			frame = n;
+		}
+
+		// コマンド入力と、コマンド解析
+		if(command_.service()) {
+		}
+
+		if(tick < frame_tick_) ++tick;
+		// flip で写し終えた後は、転送中でも、次のフレームを描画出来る
+		if(tick < frame_tick_) continue;
+		tick = 0;
 
 		if(loop >= 20) {
 			loop = 0;
@@ -213,8 +235,6 @@ int main(int argc, char *argv[])
 
 		++cnt;
 
-		// コマンド入力と、コマンド解析
-		if(command_.service()) {
-		}
+		stream_.flip();
 	}
 }
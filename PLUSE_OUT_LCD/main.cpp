@@ -21,6 +21,7 @@
 #include "common/spi_io.hpp"
 #include "chip/ST7565.hpp"
 #include "common/monograph.hpp"
+#include "common/page_fb.hpp"
 
 #include "bitmap/font32.h"
 
@@ -123,38 +124,38 @@ namespace {
 	typedef chip::ST7565<SPI, LCD_SEL, LCD_A0, LCD_RES> LCD;
 	LCD 	lcd_(spi_);
 
-	class PLOT {
-	public:
-		typedef int16_t value_type;
-
-		static const int16_t WIDTH  = 128;
-		static const int16_t HEIGHT = 32;
-
-	private:
-		uint8_t	fb_[WIDTH * HEIGHT / 8];
-
-	public:
-		void clear(uint8_t v = 0)
-		{
-			for(uint16_t i = 0; i < (WIDTH * HEIGHT / 8); ++i) {
-				fb_[i] = v;
-			}
-		} 
-
-		uint8_t* fb() { return fb_; }
-
-		void operator() (int16_t x, int16_t y, bool val)
-		{
-			if(x < 0 || x >= WIDTH) return;
-			if(y < 0 || y >= HEIGHT) return;
-		}
-	};
+	typedef graphics::page_fb<128, 32> PLOT;
 
 	graphics::kfont_null kfont_;
 	graphics::monograph<PLOT> bitmap_(kfont_);
 
 	typedef device::trj_io<utils::null_task> timer_j;
 	timer_j timer_j_;
+
+	// 表示中の文字（nmbs_ の番号）、変化した所だけ描き直す
+	uint8_t disp_[6] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+
+	void put_nmb_(uint8_t pos, uint8_t idx)
+	{
+		if(disp_[pos] == idx) return;
+		disp_[pos] = idx;
+		bitmap_.fill(20 * pos, 0, 20, 32, false);
+		bitmap_.draw_mobj(20 * pos, 0, nmbs_[idx]);
+	}
+
+	void put_unit_(bool khz)
+	{
+		uint8_t idx = khz ? 11 : 10;
+		if(disp_[5] == idx) return;
+		disp_[5] = idx;
+		bitmap_.fill(20 * 5, 0, 128 - 20 * 5, 32, false);
+		if(khz) {
+			bitmap_.draw_mobj(20 * 5, 0, nmbs_[11]);
+			bitmap_.draw_mobj(20 * 5 + 11, 0, nmbs_[10]);
+		} else {
+			bitmap_.draw_mobj(20 * 5, 0, nmbs_[10]);
+		}
+	}
 }
 
 extern "C" {
@@ -313,31 +314,20 @@ int main(int argc, char *argv[])
 			}
 		}
 
-		// 1/15 sec
+		// 1/15 sec（全体を消さずに、変化した桁だけ描き直して、その範囲を転送）
 		if((cnt & 15) == 0) {
-			bitmap_.clear(0);
 			uint32_t n = count;
 			bool khz = false;
 			if(n > 99999) {
 				n /= 1000;
 				khz = true;
 			}
-			bitmap_.draw_mobj(20 * 4, 0, nmbs_[n % 10]);
-			n /= 10;
-			bitmap_.draw_mobj(20 * 3, 0, nmbs_[n % 10]);
-			n /= 10;
-			bitmap_.draw_mobj(20 * 2, 0, nmbs_[n % 10]);
-			n /= 10;
-			bitmap_.draw_mobj(20 * 1, 0, nmbs_[n % 10]);
-			n /= 10;
-			bitmap_.draw_mobj(20 * 0, 0, nmbs_[n % 10]);
-			if(khz) {
-				bitmap_.draw_mobj(20 * 5, 0, nmbs_[11]);
-				bitmap_.draw_mobj(20 * 5 + 11, 0, nmbs_[10]);
-			} else {
-				bitmap_.draw_mobj(20 * 5, 0, nmbs_[10]);
+			for(uint8_t i = 0; i < 5; ++i) {
+				put_nmb_(4 - i, n % 10);
+				n /= 10;
 			}
-			lcd_.copy(bitmap_.at_plot().fb(), 4);
+			put_unit_(khz);
+			lcd_.copy(bitmap_.at_plot().fb(), bitmap_.at_plot().at_dirty());
 		}
 
 		++cnt;
@@ -0,0 +1,106 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	IMA/DVI ADPCM デコーダー @n
+			４ビットのコードから 16 ビットの PCM を復元する。@n
+			（乗算を使わない、リファレンス実装と同じ計算で、結果は一致する）
+	@author	平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+
+namespace audio {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	IMA/DVI ADPCM デコーダー・クラス（１チャネル分）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class ima_adpcm {
+
+		int16_t		pred_;
+		uint8_t		index_;
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		ima_adpcm() : pred_(0), index_(0) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	状態を設定（ブロック・ヘッダーの値）
+			@param[in]	pred	予測値
+			@param[in]	index	ステップ・インデックス
+		*/
+		//-----------------------------------------------------------------//
+		void set(int16_t pred, uint8_t index)
+		{
+			pred_ = pred;
+			index_ = index > 88 ? 88 : index;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	予測値を取得
+			@return 予測値
+		*/
+		//-----------------------------------------------------------------//
+		int16_t get() const { return pred_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	１サンプルをデコード
+			@param[in]	code	４ビット・コード
+			@return PCM 値
+		*/
+		//-----------------------------------------------------------------//
+		int16_t decode(uint8_t code)
+		{
+			static const uint16_t step_table[89] = {
+				7,     8,     9,     10,    11,    12,    13,    14,
+				16,    17,    19,    21,    23,    25,    28,    31,
+				34,    37,    41,    45,    50,    55,    60,    66,
+				73,    80,    88,    97,    107,   118,   130,   143,
+				157,   173,   190,   209,   230,   253,   279,   307,
+				337,   371,   408,   449,   494,   544,   598,   658,
+				724,   796,   876,   963,   1060,  1166,  1282,  1411,
+				1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,
+				3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,
+				7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899,
+				15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+				32767
+			};
+			static const int8_t index_table[8] = {
+				-1, -1, -1, -1, 2, 4, 6, 8
+			};
+
+			uint16_t step = step_table[index_];
+			uint16_t diff = step >> 3;
+			if(code & 4) diff += step;
+			if(code & 2) diff += step >> 1;
+			if(code & 1) diff += step >> 2;
+
+			int32_t v = pred_;
+			if(code & 8) v -= diff; else v += diff;
+			if(v > 32767) v = 32767;
+			else if(v < -32768) v = -32768;
+			pred_ = v;
+
+			int8_t i = static_cast<int8_t>(index_) + index_table[code & 7];
+			if(i < 0) i = 0;
+			else if(i > 88) i = 88;
+			index_ = i;
+
+			return pred_;
+		}
+	};
+}
@@ -19,42 +19,34 @@
 #include "pfatfs/mmc_io.hpp"
 
 #include "wav_in.hpp"
+#include "wav_stream.hpp"
 
 namespace {
 
-	typedef device::trb_io<utils::null_task, uint8_t> timer_b;
-	timer_b timer_b_;
-
 	typedef device::trc_io<utils::null_task> timer_c;
 	timer_c timer_c_;
 
-	struct wave_t {
-		uint8_t	left;
-		uint8_t	right;
-	};
+	// 出力レートの範囲（ファイルのレートが範囲内なら、そのレートで出力し、
+	// 範囲外なら、近い方の端に変換する）
+	static const uint16_t audio_rate_min_ = 8000;
+	static const uint16_t audio_rate_max_ = 22050;
 
-	wave_t wave_buff_[256];
-	volatile uint8_t wave_put_ = 0;
-	volatile uint8_t wave_get_ = 0;
+	static const uint8_t audio_level_ = 2;
 
-	void clear_wave_() {
-		for(uint16_t i = 0; i < 256; ++i) {
-			wave_buff_[i].left  = 128;
-			wave_buff_[i].right = 128;
-		}
-	}
+	typedef audio::wav_stream<> wav_stream;
+	wav_stream wav_stream_;
 
 	class wave_out {
 		public:
 		void operator() () {
-			const volatile wave_t& t = wave_buff_[wave_get_];
+			const wav_stream::wave_t& t = wav_stream_.get();
 			timer_c_.set_pwm_b(t.left);
 			timer_c_.set_pwm_c(t.right);
-			++wave_get_;
 		}
 	};
 
-	typedef device::trb_io<wave_out, uint8_t> timer_audio;
+	typedef device::trb_io<wave_out, uint8_t> timer_b;
+	timer_b timer_b_;
 
 	audio::wav_in wav_in_;
 
@@ -143,30 +135,22 @@ extern "C" {
 
 static void play_wav_()
 {
-//	uint32_t pos = 0;
-	uint16_t n = 0;
-//	while(pos < wav_in_.get_size()) {
-	while(1) {
-		uint8_t d;
-		do {
-			timer_b_.sync();
-			d = wave_get_ - wave_put_;
-		} while(d < 128) ;
-		UINT br;
-		if(pf_read(&wave_buff_[wave_put_], 128 * 2, &br) == FR_OK) {
-			if(br == 0) break;
-			wave_put_ += 128;
-//			pos += 256;
-//			++n;
-//			if(n >= (11025 / 128)) {
-//				n = 0;
-//				sci_putch('.');
-//			}
-		} else {
-			break;
-		}
+	uint32_t rate = wav_in_.get_rate();
+	if(rate < audio_rate_min_) rate = audio_rate_min_;
+	else if(rate > audio_rate_max_) rate = audio_rate_max_;
+
+	if(!wav_stream_.start(wav_in_, rate)) {
+		utils::format("WAV format error: %d ch, %d bits\n")
+			% static_cast<uint32_t>(wav_in_.get_chanel())
+			% static_cast<uint32_t>(wav_in_.get_bits());
+		return;
 	}
-	clear_wave_();
+	timer_b_.start(rate, audio_level_);
+	utils::format("Output: %d Hz\n") % rate;
+	while(wav_stream_.fill()) ;
+	while(wav_stream_.length() > 0) ;
+	wav_stream_.stop();
+	utils::format("Underrun: %d\n") % static_cast<uint32_t>(wav_stream_.get_underrun());
 }
 
 
@@ -185,8 +169,6 @@ int main(int argc, char *argv[])
 	SCKCR.HSCKSEL = 1;
 	CKSTPR.SCKSEL = 1;
 
-	clear_wave_();
-
 	// ＰＷＭモード設定
 	{
 		// PWM cycle F_CLK(20MHz / 2 / 256 ---> 39.0625KHz
@@ -197,10 +179,9 @@ int main(int argc, char *argv[])
 		timer_c_.start(255, timer_c::DIVIDE::F4, pfl, ir_level);
 	}
 
-	// タイマーＢ初期化
+	// タイマーＢ初期化（再生時に、ファイルのレートで再設定する）
 	{
-		uint8_t ir_level = 2;
-		timer_b_.start(11025, ir_level);
+		timer_b_.start(audio_rate_max_, audio_level_);
 	}
 
 	// UART の設定 (P1_4: TXD0[out], P1_5: RXD0[in])
@@ -227,6 +208,9 @@ int main(int argc, char *argv[])
 
 	sci_puts("Start R8C SD WAVE Player\n");
 
+	// 連続したセクターは、マルチ・ブロックで読む
+	mmc_io_.set_multi();
+
 	bool mount = false;
 	// pfatfs を開始
 	{
@@ -271,20 +255,12 @@ int main(int argc, char *argv[])
 				sci_puts("WAV file header error: '");
 				sci_puts(file_name);
 				sci_puts("'\n");		
-			} else if(wav_in_.get_chanel() != 2) {
-				utils::format("WAV chanel error(2): %d '%s'\n")
-					% static_cast<uint32_t>(wav_in_.get_chanel()) % file_name;
-			} else if(wav_in_.get_rate() != 11025) {
-				utils::format("WAV sample rate error(11025): %d '%s'\n")
-					% static_cast<uint32_t>(wav_in_.get_rate()) % file_name;
-			} else if(wav_in_.get_bits() != 8) {
-				utils::format("WAV sample bits error(8): %d '%s'\n")
-					% static_cast<uint32_t>(wav_in_.get_bits()) % file_name;
 			} else {
-				sci_puts("Play WAVE: '");
-				sci_puts(file_name);
-				sci_puts("'\n");
+				utils::format("Play WAVE: '%s' %d Hz, %d ch, %d bits\n") % file_name
+					% wav_in_.get_rate() % static_cast<uint32_t>(wav_in_.get_chanel())
+					% static_cast<uint32_t>(wav_in_.get_bits());
 				play_wav_();
+				mmc_io_.stop();
 			}
 		}
 	}
@@ -1,3 +1,4 @@
+#pragma once
 //=====================================================================//
 /*!	@file
 	@brief	WAV 音声ファイルを扱うクラス
@@ -15,7 +16,18 @@ namespace audio {
 	*/
 	//-----------------------------------------------------------------//
 	class wav_in {
+	public:
+		//=================================================================//
+		/*!
+			@brief	データ形式
+		*/
+		//=================================================================//
+		enum class format : uint16_t {
+			PCM = 0x0001,		///< リニア PCM
+			IMA_ADPCM = 0x0011,	///< IMA/DVI ADPCM（４ビット）
+		};
 
+	private:
 		struct WAVEFILEHEADER {
 			char	   	szRIFF[4];
 			uint32_t	ulRIFFSize;
@@ -40,9 +52,12 @@ namespace audio {
 			uint32_t	guidSubFormat;
 		};
 
+		uint32_t	data_top_;
 		uint32_t	data_size_;
 
 		uint32_t	rate_;
+		uint16_t	format_;
+		uint16_t	block_;
 		uint8_t		chanel_;
 		uint8_t		bits_;
 
@@ -52,7 +67,8 @@ namespace audio {
 			@brief	コンストラクター
 		*/
 		//-----------------------------------------------------------------//
-		wav_in() : data_size_(0), rate_(0), chanel_(0), bits_(0) { }
+		wav_in() : data_top_(0), data_size_(0), rate_(0), format_(0), block_(0),
+			chanel_(0), bits_(0) { }
 
 
 		//-----------------------------------------------------------------//
@@ -90,9 +106,12 @@ namespace audio {
 					}
 					if(br != sizeof(wf)) return false;
 					rate_ = wf.ulSamplesPerSec;
+					format_ = wf.usFormatTag;
+					block_ = wf.usBlockAlign;
 					chanel_ = wf.usChannels;
 					bits_ = wf.usBitsPerSample;
 				} else if(strncmp(rc.szChunkName, "data", 4) == 0) {
+					data_top_ = ofs;
 					data_size_ = rc.ulChunkSize;
 					break;
 				}
@@ -103,6 +122,14 @@ namespace audio {
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	データの先頭位置（ファイル内）を取得
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_top() const { return data_top_; }
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	データサイズを取得
@@ -111,6 +138,8 @@ namespace audio {
 		uint32_t get_size() const { return data_size_; }
 
 		uint32_t get_rate() const { return rate_; }
+		format get_format() const { return static_cast<format>(format_); }
+		uint16_t get_block() const { return block_; }
 		uint8_t get_chanel() const { return chanel_; }
 		uint8_t get_bits() const { return  bits_; }
 
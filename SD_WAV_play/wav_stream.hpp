@@ -0,0 +1,338 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	WAV ストリーム・クラス @n
+			wav_in でヘッダーを読んだファイルを、出力レート（タイマー周期）@n
+			の８ビット・ステレオに変換しながら、リング・バッファに積む。@n
+			・8/16 ビット PCM、4 ビット IMA-ADPCM、モノラル/ステレオの入力 @n
+			・16 ビットから 8 ビットへは、TPDF ディザを加えて丸める @n
+			・ステレオからモノラルへの変換（mono 指定時）@n
+			・線形補間によるサンプリング・レート変換 @n
+			ファイルは CHUNK バイト境界で読むので、セクターを跨ぐ読み出しが無い。@n
+			使い方： @n
+			  1. start() で変換を開始 @n
+			  2. メインループで fill() を呼ぶ（false で終端）@n
+			  3. タイマー割り込みで get() を呼び、出力する
+	@author	平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include "pfatfs/src/pff.h"
+#include "wav_in.hpp"
+#include "ima_adpcm.hpp"
+
+namespace audio {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	WAV ストリーム・クラス
+		@param[in]	CHUNK	ファイルから一度に読むバイト数（512 の約数）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <uint8_t CHUNK = 32>
+	class wav_stream {
+	public:
+
+		struct wave_t {
+			uint8_t	left;
+			uint8_t	right;
+		};
+
+	private:
+		// リング・バッファ（uint8_t の位置で一周する）
+		wave_t		buff_[256];
+		volatile uint8_t	put_;
+		volatile uint8_t	get_;
+
+		volatile uint16_t	underrun_;
+		volatile bool		play_;
+		volatile bool		end_;
+		wave_t		last_;
+
+		uint8_t		src_[CHUNK];
+		uint8_t		src_pos_;
+		uint8_t		src_len_;
+		uint32_t	pos_;
+		uint32_t	remain_;
+
+		uint8_t		chanel_;
+		uint8_t		bits_;
+		bool		mono_;
+
+		// IMA-ADPCM（ブロック毎に、チャネル毎４バイトのヘッダーと、
+		// チャネル毎４バイト（８サンプル）のグループが続く）
+		ima_adpcm	adpcm_[2];
+		uint16_t	block_;
+		uint16_t	block_remain_;
+		uint8_t		pcm_[2][8];
+		uint8_t		pcm_pos_;
+		uint8_t		pcm_len_;
+
+		uint32_t	step_;		///< 入力レート／出力レート（16.16）
+		uint32_t	phase_;
+		wave_t		prev_;
+		wave_t		cur_;
+
+		uint16_t	rand_;
+
+		bool next_byte_(uint8_t& v)
+		{
+			if(src_pos_ >= src_len_) {
+				if(remain_ == 0) return false;
+				uint32_t n = CHUNK - (pos_ % CHUNK);  // CHUNK 境界に合わせる
+				if(n > remain_) n = remain_;
+				UINT br;
+				if(pf_read(src_, n, &br) != FR_OK || br == 0) {
+					remain_ = 0;
+					return false;
+				}
+				src_pos_ = 0;
+				src_len_ = br;
+				pos_ += br;
+				remain_ -= br;
+			}
+			v = src_[src_pos_];
+			++src_pos_;
+			return true;
+		}
+
+		bool sample_(uint8_t& v)
+		{
+			uint8_t lo;
+			if(!next_byte_(lo)) return false;
+			if(bits_ == 8) {
+				v = lo;
+				return true;
+			}
+			uint8_t hi;
+			if(!next_byte_(hi)) return false;
+			v = dither_(static_cast<int16_t>((static_cast<uint16_t>(hi) << 8) | lo));
+			return true;
+		}
+
+		uint8_t dither_(int16_t s)
+		{
+			// TPDF ディザ（±１LSB の三角分布）
+			rand_ = (rand_ >> 1) ^ (-(rand_ & 1) & 0xB400u);
+			int16_t d = static_cast<int16_t>(rand_ & 0xff) + static_cast<int16_t>(rand_ >> 8) - 255;
+			int32_t t = static_cast<int32_t>(s) + d;
+			if(t > 32767) t = 32767;
+			else if(t < -32768) t = -32768;
+			return static_cast<uint8_t>((t >> 8) + 128);
+		}
+
+		bool adpcm_fill_()
+		{
+			uint8_t grp = chanel_ * 4;
+			uint8_t v;
+			if(block_remain_ < grp) {  // ブロックの先頭（端数は捨てる）
+				while(block_remain_ > 0) {
+					if(!next_byte_(v)) return false;
+					--block_remain_;
+				}
+				block_remain_ = block_;
+				for(uint8_t ch = 0; ch < chanel_; ++ch) {
+					uint8_t lo, hi, idx;
+					if(!next_byte_(lo) || !next_byte_(hi) || !next_byte_(idx) || !next_byte_(v)) {
+						return false;
+					}
+					adpcm_[ch].set(static_cast<int16_t>((static_cast<uint16_t>(hi) << 8) | lo), idx);
+					pcm_[ch][0] = dither_(adpcm_[ch].get());
+				}
+				block_remain_ -= grp;
+				pcm_len_ = 1;
+			} else {
+				for(uint8_t ch = 0; ch < chanel_; ++ch) {
+					for(uint8_t i = 0; i < 8; i += 2) {
+						if(!next_byte_(v)) return false;
+						pcm_[ch][i]     = dither_(adpcm_[ch].decode(v & 15));
+						pcm_[ch][i + 1] = dither_(adpcm_[ch].decode(v >> 4));
+					}
+				}
+				block_remain_ -= grp;
+				pcm_len_ = 8;
+			}
+			pcm_pos_ = 0;
+			return true;
+		}
+
+		bool frame_(wave_t& t)
+		{
+			if(bits_ == 4) {
+				if(pcm_pos_ >= pcm_len_) {
+					if(!adpcm_fill_()) return false;
+				}
+				t.left  = pcm_[0][pcm_pos_];
+				t.right = pcm_[chanel_ - 1][pcm_pos_];
+				++pcm_pos_;
+			} else {
+				if(!sample_(t.left)) return false;
+				if(chanel_ == 2) {
+					if(!sample_(t.right)) return false;
+				} else {
+					t.right = t.left;
+				}
+			}
+			if(mono_) {
+				t.left = (static_cast<uint16_t>(t.left) + t.right) >> 1;
+				t.right = t.left;
+			}
+			return true;
+		}
+
+		static uint8_t lerp_(uint8_t a, uint8_t b, uint8_t f)
+		{
+			int16_t d = static_cast<int16_t>(b) - a;
+			return a + static_cast<int16_t>((static_cast<int32_t>(d) * f) >> 8);
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		wav_stream() : put_(0), get_(0), underrun_(0), play_(false), end_(true),
+			last_{ 128, 128 }, src_pos_(0), src_len_(0), pos_(0), remain_(0),
+			chanel_(0), bits_(0), mono_(false), block_(0), block_remain_(0),
+			pcm_pos_(0), pcm_len_(0), step_(0), phase_(0),
+			prev_{ 128, 128 }, cur_{ 128, 128 }, rand_(1) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	変換を開始（load_header の直後に呼ぶ）
+			@param[in]	in		ヘッダーを読んだ wav_in
+			@param[in]	rate	出力レート（入力と同じなら、補間せずにそのまま出力）
+			@param[in]	mono	モノラルに変換する場合「true」
+			@return 扱えない形式なら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool start(const wav_in& in, uint16_t rate, bool mono = false)
+		{
+			play_ = false;
+			if(in.get_format() == wav_in::format::IMA_ADPCM) {
+				if(in.get_bits() != 4 || in.get_block() < (in.get_chanel() * 4u)) return false;
+			} else if(in.get_format() != wav_in::format::PCM) {
+				return false;
+			} else if(in.get_bits() != 8 && in.get_bits() != 16) {
+				return false;
+			}
+			if(in.get_chanel() != 1 && in.get_chanel() != 2) return false;
+			if(in.get_rate() == 0 || in.get_rate() > 65535 || rate == 0) return false;
+
+			chanel_ = in.get_chanel();
+			bits_ = in.get_bits();
+			mono_ = mono;
+			step_ = (in.get_rate() << 16) / rate;
+			phase_ = 0;
+			pos_ = in.get_top();
+			remain_ = in.get_size();
+			src_pos_ = 0;
+			src_len_ = 0;
+			block_ = in.get_block();
+			block_remain_ = 0;
+			pcm_pos_ = 0;
+			pcm_len_ = 0;
+
+			put_ = 0;
+			get_ = 0;
+			underrun_ = 0;
+			end_ = !frame_(prev_);
+			cur_ = prev_;
+			if(!end_) frame_(cur_);
+			play_ = true;
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	バッファを埋める（メインループから呼ぶ）@n
+					バッファの半分が空くまでは、何もしない。
+			@return 入力の終端なら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool fill()
+		{
+			if(end_) return false;
+			uint8_t n = get_ - put_ - 1;
+			if(n < 128) return true;
+
+			while(n > 0) {
+				wave_t t;
+				uint8_t f = phase_ >> 8;
+				if(f == 0) {  // 同じレートでは、常にこちら
+					t = prev_;
+				} else {
+					t.left  = lerp_(prev_.left,  cur_.left,  f);
+					t.right = lerp_(prev_.right, cur_.right, f);
+				}
+				buff_[put_] = t;
+				++put_;
+				--n;
+
+				phase_ += step_;
+				while(phase_ >= 0x10000) {
+					phase_ -= 0x10000;
+					prev_ = cur_;
+					if(!frame_(cur_)) {
+						end_ = true;
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	出力を取得（割り込みから呼ぶ）
+			@return 出力
+		*/
+		//-----------------------------------------------------------------//
+		const wave_t& get()
+		{
+			if(!play_) {
+				last_.left  = 128;
+				last_.right = 128;
+			} else if(get_ == put_) {
+				if(!end_) ++underrun_;  // 直前の値を保持
+			} else {
+				last_ = buff_[get_];
+				++get_;
+			}
+			return last_;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	出力を停止（無音にする）
+		*/
+		//-----------------------------------------------------------------//
+		void stop() { play_ = false; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	バッファ内のフレーム数を取得
+			@return フレーム数
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t length() const { return put_ - get_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	アンダーラン（バッファが空で出力出来なかった）回数を取得
+			@return アンダーラン回数
+		*/
+		//-----------------------------------------------------------------//
+		uint16_t get_underrun() const { return underrun_; }
+	};
+}
@@ -8,6 +8,7 @@
 				https://github.com/hirakuni45/R8C/blob/master/LICENSE
 */
 //=====================================================================//
+#include <cstring>
 #include "common/renesas.hpp"
 
 #include "common/fifo.hpp"
@@ -18,6 +19,7 @@
 #include "common/spi_io.hpp"
 #include "chip/ST7565.hpp"
 #include "common/monograph.hpp"
+#include "common/page_fb.hpp"
 #include "common/font6x12.hpp"
 #include "common/fixed_string.hpp"
 
@@ -114,36 +116,11 @@ namespace app {
 		typedef chip::ST7565<SPI, LCD_SEL, LCD_A0, LCD_RES> LCD;
 		LCD 	lcd_;
 
-		class PLOT {
-		public:
-			typedef int16_t value_type;
-
-			static const int16_t WIDTH  = 128;
-			static const int16_t HEIGHT = 24;
-			static const int8_t PAGE_NUM = 2;
-
-		private:
-			uint8_t		fb_[WIDTH * HEIGHT / 8];
-
-		public:
-			void clear(uint8_t v = 0)
-			{
-				for(uint16_t i = 0; i < (WIDTH * HEIGHT / 8); ++i) {
-					fb_[i] = v;
-				}
-			} 
-
-			uint8_t* fb() { return fb_; }
-
-			void operator() (value_type x, value_type y, bool val)
-			{
-				if(x < 0 || x >= WIDTH) return;
-				if(y < 0 || y >= HEIGHT) return;
-
-				if(val) { fb_[(x >> 3) * y] |= 1 << (x & 7); }
-				else { fb_[(x >> 3) * y] &= ~(1 << (x & 7)); }
-			}
-		};
+		// 128 x 24 の領域を、上下２回に分けて転送する
+		// グラフは、各半分の 0 ～ 23 行に描く（47 - v、下半分は -24）ので、
+		// 転送は３ページ（LCD のページ 0 ～ 2、3 ～ 5）で、以前の２ページ転送
+		// では、16 ～ 23 行、40 ～ 47 行が表示されなかった。
+		typedef graphics::page_fb<128, 24> PLOT;
 
 
 		typedef graphics::font6x12 afont;
@@ -172,6 +149,22 @@ namespace app {
 
 		TASK		task_;
 
+		// フレームバッファは上下で使い回し、毎回消して描き直すので、書き込みの
+		// 記録では全てが更新になる、上下それぞれ、前回転送した内容と比べて、
+		// 変化した範囲だけを転送する
+		struct half_t {
+			char	text[16];
+			TASK	task;
+			uint8_t	log;
+			uint8_t	gain;
+		};
+		half_t		half_[2];
+		TASK		draw_task_;
+		uint8_t		graph_org_;
+		uint8_t		graph_end_;
+		uint8_t		graph_log_;
+		uint8_t		graph_gain_;
+
 		uint8_t		log_;
 		uint8_t		log_itv_;
 		uint8_t		gain_idx_;
@@ -194,13 +187,17 @@ namespace app {
         //-------------------------------------------------------------//
 		checker() : lcd_(spi_), bitmap_(kfont_), loop_(0), page_(0),
 					volt_(0.0f), current_(0.0f), watt_(0.0f),
-					task_(TASK::MAIN),
+					task_(TASK::MAIN), draw_task_(TASK::MAIN), graph_org_(0), graph_end_(0),
+					graph_log_(0), graph_gain_(0),
 					log_(0), log_itv_(0), gain_idx_(0), interval_(12),
 					usb_m_(0.0f), usb_p_(0.0f)
 #ifdef UART
 					, list_cnt_(0)
 #endif
-			{ }
+			{
+				half_[0].task = TASK::limit;
+				half_[1].task = TASK::limit;
+			}
 
 
         //-------------------------------------------------------------//
@@ -311,6 +308,11 @@ namespace app {
 				bitmap_.line(o, 1, o + v, 1, true);
 			}
 
+			graph_org_ = o;
+			graph_end_ = o + w + 1;
+			graph_log_ = log_;
+			graph_gain_ = gain_idx_;
+
 			uint8_t pos = log_ - w - 1;
 			pos &= 127;
 			int16_t v0 = static_cast<int16_t>(buff_[pos]);
@@ -450,8 +452,11 @@ namespace app {
 
 			if(loop_ == 0) {
 				bitmap_.clear(0);
+				str_[0] = 0;
+				graph_org_ = graph_end_ = 0;
 			} else if(loop_ == 1) {
-				switch(task_) {
+				draw_task_ = task_;
+				switch(draw_task_) {
 				case TASK::MAIN:
 					vc();
 					graph(64, 64 - 1);
@@ -480,7 +485,32 @@ namespace app {
 					break;
 				}
 			} else if(loop_ == 2) {
-				lcd_.copy(bitmap_.at_plot().fb(), PLOT::PAGE_NUM, page_ * 3);
+				auto& d = bitmap_.at_plot().at_dirty();
+				d.clear();
+				auto& h = half_[page_];
+				if(h.task != draw_task_) {
+					d.all();
+				} else {
+					// テキストは、最初に異なる文字から、長い方の終わりまで
+					uint8_t i = 0;
+					while(str_[i] != 0 && str_[i] == h.text[i]) ++i;
+					if(str_[i] != h.text[i]) {
+						uint8_t n = std::strlen(str_);
+						uint8_t m = std::strlen(h.text);
+						if(m > n) n = m;
+						d.mark_area(i * afont::WIDTH, 0, (n - i) * afont::WIDTH, afont::HEIGHT);
+					}
+					// グラフは、ログが進むか、ゲインが変わった場合
+					if(graph_org_ < graph_end_ && (h.log != graph_log_ || h.gain != graph_gain_)) {
+						d.mark_area(graph_org_, 0, graph_end_ - graph_org_, PLOT::HEIGHT);
+					}
+				}
+				h.task = draw_task_;
+				std::strncpy(h.text, str_, sizeof(h.text) - 1);
+				h.text[sizeof(h.text) - 1] = 0;
+				h.log = graph_log_;
+				h.gain = graph_gain_;
+				lcd_.copy(bitmap_.at_plot().fb(), d, page_ * 3);
 				++page_;
 				page_ &= 1;
 			}
@@ -0,0 +1,178 @@
+//=====================================================================//
+/*!	@file
+	@brief	IMA-ADPCM デコーダー（SD_WAV_play/ima_adpcm.hpp）の検査 @n
+			小さな参照ベクター（初期の予測値、インデックスと、WAV と同じ @n
+			下位ニブルが先のコード列）をデコードし、期待する 16 ビット PCM @n
+			と、全てのサンプルが一致するかを検査する。@n
+			期待値は、ima_adpcm とは別の実装（Python の audioop.adpcm2lin、@n
+			IMA/DVI のリファレンス実装と同じ計算）で作成した。@n
+			・全てのコード（0 〜 15） @n
+			・正、負の飽和（32767、-32768 とインデックス 88） @n
+			・乱数のコード列、インデックス 88 からの開始 @n
+			・正弦波（audioop.lin2adpcm でエンコード） @n
+			使い方： adpcm_test [-v]
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <string>
+#include "SD_WAV_play/ima_adpcm.hpp"
+
+namespace {
+
+	// all codes（予測値 0、インデックス 0）
+	const uint8_t code0_[] = {
+		0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE, 0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE,
+	};
+	const int16_t pcm0_[] = {
+		0, 1, 4, 8, 15, 27, 47, 88,
+		82, 66, 41, 10, -28, -84, -181, -380,
+		-352, -274, -156, -6, 170, 430, 882, 1807,
+		1675, 1315, 768, 72, -742, -1946, -4029, -8289,
+	};
+	// positive clamp（予測値 0、インデックス 0）
+	const uint8_t code1_[] = {
+		0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77,
+		0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77,
+	};
+	const int16_t pcm1_[] = {
+		11, 41, 104, 240, 533, 1164, 2521, 5431,
+		11667, 25039, 32767, 32767, 32767, 32767, 32767, 32767,
+		32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+		32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+		32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+		32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+	};
+	// negative clamp（予測値 0、インデックス 0）
+	const uint8_t code2_[] = {
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	};
+	const int16_t pcm2_[] = {
+		-11, -41, -104, -240, -533, -1164, -2521, -5431,
+		-11667, -25039, -32768, -32768, -32768, -32768, -32768, -32768,
+		-32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+		-32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+		-32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+		-32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+	};
+	// random（予測値 1234、インデックス 40）
+	const uint8_t code3_[] = {
+		0x4C, 0xA5, 0xDF, 0xAD, 0x5A, 0xBC, 0xFE, 0x03, 0xC9, 0x0D, 0x9F, 0x0F, 0x4D, 0x4C, 0x2D, 0x6B,
+		0x38, 0x2A, 0xFF, 0x7E, 0x98, 0xE1, 0x09, 0x8B, 0x55, 0x9C, 0x19, 0x6F, 0x26, 0xFE, 0x9C, 0xD5,
+	};
+	const int16_t pcm3_[] = {
+		855, 1314, 1992, 1540, 307, -1632, -4472, -6362,
+		-8079, -4644, -8761, -12635, -19177, -32549, -19172, -17435,
+		-22172, -32768, -32768, -30225, -32768, -32768, -32768, -28673,
+		-32768, 4094, -32768, 4094, -32768, -12290, -32768, 11246,
+		7151, 32767, 15839, 31227, -10744, -32768, -32768, 28668,
+		24573, 13401, 23557, -16454, -28740, -25016, -32768, -32768,
+		-1989, 32767, -4095, -16381, -27553, -17397, -32768, 20477,
+		32767, 32767, -15648, -32768, -32768, -32768, 8198, -32768,
+	};
+	// index 88（予測値 -32000、インデックス 88）
+	const uint8_t code4_[] = {
+		0x80, 0xF7, 0xB3, 0x91, 0x80, 0xF7, 0xB3, 0x91, 0x80, 0xF7, 0xB3, 0x91, 0x80, 0xF7, 0xB3, 0x91,
+	};
+	const int16_t pcm4_[] = {
+		-27905, -31629, 19156, -32768, -4099, -30168, -20012, -29244,
+		-26446, -28989, 5698, -32768, -4099, -30168, -20012, -29244,
+		-26446, -28989, 5698, -32768, -4099, -30168, -20012, -29244,
+		-26446, -28989, 5698, -32768, -4099, -30168, -20012, -29244,
+	};
+	// sine（予測値 0、インデックス 0）
+	const uint8_t code5_[] = {
+		0x70, 0x77, 0x77, 0x77, 0xEE, 0xAB, 0x08, 0x53, 0x34, 0x22, 0x80, 0xCB, 0xBD, 0xAA, 0x19, 0x52,
+		0x34, 0x22, 0x91, 0xDA, 0xBC, 0xAA, 0x19, 0x52, 0x34, 0x22, 0x91, 0xDA, 0xBC, 0xAA, 0x19, 0x52,
+	};
+	const int16_t pcm5_[] = {
+		0, 11, 41, 104, 240, 533, 1164, 2521,
+		-1, -4467, -8727, -11494, -11997, -11540, -8631, -4473,
+		508, 5195, 8238, 11005, 11508, 11051, 8142, 4740,
+		-292, -4979, -8022, -10789, -12298, -10926, -8848, -4690,
+		291, 4978, 8021, 10788, 12297, 10925, 8847, 4689,
+		-292, -4979, -8022, -10789, -12298, -10926, -8848, -4690,
+		291, 4978, 8021, 10788, 12297, 10925, 8847, 4689,
+		-292, -4979, -8022, -10789, -12298, -10926, -8848, -4690,
+	};
+
+	struct vector_t {
+		const char*		name;
+		int16_t			pred;
+		uint8_t			index;
+		const uint8_t*	code;
+		uint16_t		code_len;
+		const int16_t*	pcm;
+	};
+
+#define VECTOR(name, pred, index, n) { name, pred, index, code##n##_, sizeof(code##n##_), pcm##n##_ }
+
+	const vector_t vectors_[] = {
+		VECTOR("all codes",      0,      0,  0),
+		VECTOR("positive clamp", 0,      0,  1),
+		VECTOR("negative clamp", 0,      0,  2),
+		VECTOR("random",         1234,   40, 3),
+		VECTOR("index 88",       -32000, 88, 4),
+		VECTOR("sine",           0,      0,  5),
+	};
+
+#undef VECTOR
+
+	// WAV と同じく、下位ニブルを先にデコードする
+	uint32_t check_(const vector_t& t, bool verbose)
+	{
+		audio::ima_adpcm dec;
+		dec.set(t.pred, t.index);
+		uint32_t err = 0;
+		uint16_t n = 0;
+		for(uint16_t i = 0; i < t.code_len; ++i) {
+			int16_t v[2];
+			v[0] = dec.decode(t.code[i] & 15);
+			v[1] = dec.decode(t.code[i] >> 4);
+			for(uint8_t j = 0; j < 2; ++j) {
+				if(v[j] != t.pcm[n]) {
+					if(verbose || err == 0) {
+						std::cout << "  " << t.name << " [" << n << "]: " << v[j]
+							<< " (expected " << t.pcm[n] << ")" << std::endl;
+					}
+					++err;
+				}
+				++n;
+			}
+		}
+		return err;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	bool verbose = false;
+	for(int i = 1; i < argc; ++i) {
+		std::string s = argv[i];
+		if(s == "-v") {
+			verbose = true;
+		} else {
+			std::cout << "IMA-ADPCM decoder reference vector test" << std::endl;
+			std::cout << "usage: " << argv[0] << " [-v]" << std::endl;
+			return 0;
+		}
+	}
+
+	uint32_t total = 0;
+	uint32_t err = 0;
+	for(const auto& t : vectors_) {
+		uint32_t e = check_(t, verbose);
+		std::cout << t.name << ": " << (t.code_len * 2) << " samples, "
+			<< (e == 0 ? "OK" : "NG") << std::endl;
+		total += t.code_len * 2;
+		err += e;
+	}
+	std::cout << "Samples: " << total << ", error: " << err << std::endl;
+	std::cout << (err == 0 ? "Pass" : "Fail") << std::endl;
+	return err != 0 ? 1 : 0;
+}
@@ -0,0 +1,95 @@
+//=====================================================================//
+/*!	@file
+	@brief	ASCII フォントをページ構成に変換するツール @n
+			font6x12 の行単位（LSB から）のビットマップを、LCD と同じ @n
+			カラム毎に縦８ピクセルを１バイト（下位ビットが上）とした構成に @n
+			変換して、font6x12_page::page_ の C++ ソースを出力する。@n
+			monograph は、PLOT が blit_bytes を持つ場合、このテーブルから @n
+			バイト単位で書き込む。@n
+			使い方： afont_page output.cpp
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "common/font6x12.hpp"
+
+namespace {
+
+	// 行単位（LSB から）のビットマップを、カラム毎のページ構成に変換
+	template <class AFONT>
+	std::vector<uint8_t> to_page_(uint8_t code)
+	{
+		static const int n = (AFONT::HEIGHT + 7) / 8;
+		std::vector<uint8_t> out(AFONT::WIDTH * n, 0);
+		const uint8_t* src = AFONT::get(code);
+		for(int y = 0; y < AFONT::HEIGHT; ++y) {
+			for(int x = 0; x < AFONT::WIDTH; ++x) {
+				int pos = y * AFONT::WIDTH + x;
+				if(src[pos >> 3] & (1 << (pos & 7))) {
+					out[x * n + (y >> 3)] |= 1 << (y & 7);
+				}
+			}
+		}
+		return out;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	typedef graphics::font6x12 AFONT;
+
+	if(argc != 2) {
+		std::cout << "ASCII font to page layout converter" << std::endl;
+		std::cout << "usage: " << argv[0] << " output.cpp" << std::endl;
+		return 0;
+	}
+
+	std::ofstream ofs(argv[1]);
+	if(!ofs) {
+		std::cerr << "Can't open: '" << argv[1] << "'" << std::endl;
+		return 1;
+	}
+
+	static const int n = (AFONT::HEIGHT + 7) / 8;
+	ofs << "//=====================================================================//" << std::endl;
+	ofs << "/*!\t@file" << std::endl;
+	ofs << "\t@brief\t６×１２フォント（ページ構成） @n" << std::endl;
+	ofs << "\t\t\tafont_page で、font6x12.cpp から作成したテーブル（編集しない事）@n" << std::endl;
+	ofs << "\t\t\t文字毎に、カラム（" << static_cast<int>(AFONT::WIDTH) << "）×ページ（"
+		<< n << "）バイト、下位ビットが上" << std::endl;
+	ofs << "    @author 平松邦仁 (hira@rvf-rc45.net)" << std::endl;
+	ofs << "\t@copyright\tCopyright (C) 2021 Kunihito Hiramatsu @n" << std::endl;
+	ofs << "\t\t\t\tReleased under the MIT license @n" << std::endl;
+	ofs << "\t\t\t\thttps://github.com/hirakuni45/R8C/blob/master/LICENSE" << std::endl;
+	ofs << "*/" << std::endl;
+	ofs << "//=====================================================================//" << std::endl;
+	ofs << "#include \"common/font6x12.hpp\"" << std::endl;
+	ofs << std::endl;
+	ofs << "namespace graphics {" << std::endl;
+	ofs << std::endl;
+	ofs << "\tconst uint8_t font6x12_page::page_[] = {" << std::endl;
+	uint32_t size = 0;
+	for(uint16_t code = 0; code < 128; ++code) {
+		auto page = to_page_<AFONT>(code);
+		for(auto v : page) {
+			ofs << "0x" << std::uppercase << std::hex << std::setw(2) << std::setfill('0')
+				<< static_cast<int>(v) << ",";
+		}
+		ofs << std::dec << std::endl;
+		size += page.size();
+	}
+	ofs << "\t};" << std::endl;
+	ofs << "}" << std::endl;
+
+	std::cout << "font6x12: " << 128 << " glyphs, " << size << " bytes" << std::endl;
+	return 0;
+}
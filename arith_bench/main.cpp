@@ -0,0 +1,198 @@
+//=====================================================================//
+/*!	@file
+	@brief	basic_arith と arith_code の評価速度ベンチマーク @n
+			ADC の値（0 ～ 4095）を、スケーリングの数式で変換する場合を想定し、@n
+			basic_arith は、値を埋め込んだテキストを毎回解析、@n
+			arith_code は、一度だけ変換したコードを、変数を変えて評価する。@n
+			型（int32_t、fixed_point、float）毎に、一秒当たりの評価回数 @n
+			（eval/s）を表示し、全ての ADC 値で、結果が一致するかを検査する。@n
+			使い方： arith_bench [-time ms]
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include "common/basic_arith.hpp"
+#include "common/arith_code.hpp"
+#include "common/fixed_point.hpp"
+
+namespace {
+
+	typedef utils::fixed_point<int32_t, 16> FIXED;
+
+	static const uint16_t ADC_NUM = 4096;
+
+	// 変数「x」をスロット０にする
+	struct symbol_t {
+		int16_t find(const char* name, uint8_t len) const {
+			if(len == 1 && name[0] == 'x') return 0;
+			return -1;
+		}
+	};
+
+
+	// 数式の「x」を、数値に置き換える
+	std::string bind_(const char* text, uint16_t x)
+	{
+		std::string s;
+		char tmp[8];
+		snprintf(tmp, sizeof(tmp), "%u", x);
+		for(const char* p = text; *p != 0; ++p) {
+			if(*p == 'x') s += tmp;
+			else s += *p;
+		}
+		return s;
+	}
+
+
+	template <typename FUNC>
+	double ops_(FUNC func, uint32_t ms)
+	{
+		uint32_t n = 0;
+		auto org = std::chrono::steady_clock::now();
+		auto end = org + std::chrono::milliseconds(ms);
+		auto now = org;
+		do {
+			for(uint32_t i = 0; i < 256; ++i) func(n + i);
+			n += 256;
+			now = std::chrono::steady_clock::now();
+		} while(now < end);
+		double t = std::chrono::duration<double>(now - org).count();
+		return static_cast<double>(n) / t;
+	}
+
+
+	volatile int32_t	sink_;
+
+	int32_t raw_(int32_t v) { return v; }
+	int32_t raw_(const FIXED& v) { return v.raw(); }
+	int32_t raw_(float v) { return static_cast<int32_t>(v * 65536.0f); }
+
+
+	struct result_t {
+		double	arith;		///< basic_arith（0 なら対象外）
+		double	code;
+		uint8_t	size;
+		bool	ok;
+	};
+
+
+	// basic_arith と比較
+	template <typename VTYPE>
+	result_t bench_(const char* text, uint32_t ms)
+	{
+		result_t t;
+		utils::arith_code<VTYPE> code;
+		t.ok = code.compile(text, symbol_t());
+		t.size = code.size();
+
+		std::vector<std::string> src;
+		for(uint16_t x = 0; x < ADC_NUM; ++x) src.push_back(bind_(text, x));
+
+		utils::basic_arith<VTYPE> arith;
+		for(uint16_t x = 0; x < ADC_NUM && t.ok; ++x) {
+			VTYPE v = x;
+			VTYPE a = code.run(&v);
+			if(!arith.analize(src[x].c_str()) || !(arith() == a)) t.ok = false;
+		}
+
+		t.arith = ops_([&](uint32_t i) {
+			arith.analize(src[i & (ADC_NUM - 1)].c_str());
+			sink_ = raw_(arith());
+		}, ms);
+		t.code = ops_([&](uint32_t i) {
+			VTYPE v = static_cast<int32_t>(i & (ADC_NUM - 1));
+			sink_ = raw_(code.run(&v));
+		}, ms);
+		return t;
+	}
+
+
+	// 浮動小数点（basic_arith は、整数専用の演算があり使えない）
+	result_t bench_float_(const char* text, float (*ref)(float), uint32_t ms)
+	{
+		result_t t;
+		utils::arith_code<float> code;
+		t.ok = code.compile(text, symbol_t());
+		t.size = code.size();
+		for(uint16_t x = 0; x < ADC_NUM && t.ok; ++x) {
+			float v = x;
+			if(std::fabs(code.run(&v) - ref(v)) > 1e-4f) t.ok = false;
+		}
+		// 整数専用の演算は、変換時にエラーとなる事
+		utils::arith_code<float> tmp;
+		if(tmp.compile("x // 3", symbol_t()) || tmp.compile("x << 2", symbol_t())) t.ok = false;
+
+		t.arith = 0.0;
+		t.code = ops_([&](uint32_t i) {
+			float v = static_cast<float>(i & (ADC_NUM - 1));
+			sink_ = raw_(code.run(&v));
+		}, ms);
+		return t;
+	}
+
+
+	void report_(const char* type, const char* text, const result_t& t)
+	{
+		std::cout << std::left << std::setw(8) << type << std::setw(30) << text << std::right
+			<< std::fixed << std::setprecision(0);
+		if(t.arith > 0.0) std::cout << std::setw(14) << t.arith;
+		else std::cout << std::setw(14) << "-";
+		std::cout << std::setw(14) << t.code;
+		if(t.arith > 0.0) {
+			std::cout << std::setw(7) << std::setprecision(1) << t.code / t.arith << "x";
+		} else {
+			std::cout << std::setw(8) << "-";
+		}
+		std::cout << std::setw(6) << static_cast<int>(t.size) << "  " << (t.ok ? "OK" : "NG")
+			<< std::endl;
+	}
+
+
+	float ref_float_(float x) { return x * (3.0f + 3.0f / 10.0f) / 4096.0f - 0.5f; }
+}
+
+
+int main(int argc, char* argv[])
+{
+	uint32_t ms = 200;
+	for(int i = 1; i < argc; ++i) {
+		std::string s = argv[i];
+		if(s == "-time" && (i + 1) < argc) {
+			ms = std::atoi(argv[++i]);
+		} else {
+			std::cout << "basic_arith / arith_code evaluation benchmark" << std::endl;
+			std::cout << "usage: " << argv[0] << " [-time ms]" << std::endl;
+			return 0;
+		}
+	}
+
+	static const char* int_text = "(x * 3300 / 4096 - 500) * 10 / 25";
+	static const char* bit_text = "(x >> 4) & 15 | (x // 7) << 8";
+	static const char* fix_text = "x * 3.3 / 4096 - 0.5";
+
+	std::cout << "type    expression                basic(eval/s)  code(eval/s)  ratio  code  result"
+		<< std::endl;
+	int err = 0;
+	auto a = bench_<int32_t>(int_text, ms);
+	report_("int32", int_text, a);
+	auto b = bench_<int32_t>(bit_text, ms);
+	report_("int32", bit_text, b);
+	auto c = bench_<FIXED>(fix_text, ms);
+	report_("fixed", fix_text, c);
+	auto d = bench_float_(fix_text, ref_float_, ms);
+	report_("float", fix_text, d);
+	if(!a.ok || !b.ok || !c.ok || !d.ok) ++err;
+
+	std::cout << (err == 0 ? "Pass" : "Fail") << std::endl;
+	return err != 0 ? 1 : 0;
+}
@@ -141,9 +141,7 @@ namespace chip {
 		uint8_t read_(REG reg) const noexcept
 		{
 			uint8_t tmp[1];
-			tmp[0] = static_cast<uint8_t>(reg);
-			i2c_.send(DEV_ADR, tmp, 1);
-			i2c_.recv(DEV_ADR, tmp, 1);
+			i2c_.write_then_read(DEV_ADR, static_cast<uint8_t>(reg), tmp, 1);
 			return tmp[0];
 		}
 
@@ -151,9 +149,7 @@ namespace chip {
 		uint8_t fast_(REG reg) const noexcept
 		{
 			uint8_t tmp[1];
-			tmp[0] = static_cast<uint8_t>(reg);
-			i2c_.send(DEV_ADR, tmp, 1);
-			i2c_.recv(DEV_ADR, tmp, 1);
+			i2c_.write_then_read(DEV_ADR, static_cast<uint8_t>(reg), tmp, 1);
 			return tmp[0];
 		}
 
@@ -342,9 +338,7 @@ namespace chip {
 		ivector3 get_raw() const noexcept
 		{
 			uint8_t tmp[6];
-			tmp[0] = static_cast<uint8_t>(REG::OUT_X_L) | (1 << 7);
-			i2c_.send(DEV_ADR, tmp, 1);
-			i2c_.recv(DEV_ADR, tmp, 6);
+			i2c_.write_then_read(DEV_ADR, static_cast<uint8_t>(REG::OUT_X_L) | (1 << 7), tmp, 6);
 			ivector3 v;
 			v.x = (tmp[1] << 8) | tmp[0];
 			v.y = (tmp[3] << 8) | tmp[2];
@@ -5,7 +5,9 @@
 			LED Display Driver (VCC: 4V to 5.5V) @n
 			※輝度を大きく設定すると、消費電流が大きくなるので注意が必要。 @n
 			※初期化前は、レジスター値が不定なので、大きな消費電流が流れる恐れがある @n
-			※デージーチェイン接続した場合のバッファ配置に注意
+			※デージーチェイン接続した場合のバッファ配置に注意 @n
+			※転送済みの値を保持して、変化した桁だけを送る（他のデバイスは NO-OP）@n
+			※シフトはリングバッファの位置を動かすだけで、コピーしない
     @author 平松邦仁 (hira@rvf-rc45.net)
 	@copyright	Copyright (C) 2017, 2021 Kunihito Hiramatsu @n
 				Released under the MIT license @n
@@ -27,9 +29,14 @@ namespace chip {
 	template <class SPI, class SELECT, uint8_t CHAIN = 1>
 	class MAX7219 {
 
+		static const uint8_t NUM = 8 * CHAIN;
+
 		SPI&		spi_;
 
-		uint8_t		fb_[8 * CHAIN];
+		uint8_t		fb_[NUM];
+		uint8_t		sent_[NUM];	///< デバイスに転送済みの値
+		uint8_t		ofs_;		///< リングバッファの先頭
+		bool		force_;
 
 		enum class COMMAND : uint8_t {
 			NO_OP        = 0x00,
@@ -63,13 +70,36 @@ namespace chip {
 		}
 
 
+		uint8_t pos_(uint8_t idx) const noexcept
+		{
+			idx += ofs_;
+			if(idx >= NUM) idx -= NUM;
+			return idx;
+		}
+
+
+		// 変化したデバイスだけ桁を送り、他は NO-OP で埋める
 		void out_digit_(COMMAND cmd, uint8_t idx) noexcept
 		{
+			bool diff = force_;
+			for(uint8_t i = 0; i < CHAIN; ++i) {
+				if(fb_[pos_(8 * i + idx)] != sent_[8 * i + idx]) diff = true;
+			}
+			if(!diff) return;
+
 			SELECT::P = 0;
 			uint8_t tmp[2];
-			tmp[0] = static_cast<uint8_t>(cmd);
 			for(uint8_t i = 0; i < CHAIN; ++i) {
-				tmp[1] = fb_[8 * (CHAIN - i - 1) + idx];
+				uint8_t n = 8 * (CHAIN - i - 1) + idx;
+				uint8_t v = fb_[pos_(n)];
+				if(force_ || v != sent_[n]) {
+					tmp[0] = static_cast<uint8_t>(cmd);
+					tmp[1] = v;
+					sent_[n] = v;
+				} else {
+					tmp[0] = static_cast<uint8_t>(COMMAND::NO_OP);
+					tmp[1] = 0;
+				}
 				spi_.send(tmp, 2);
 			}
 			SELECT::P = 1;  // load
@@ -82,7 +112,7 @@ namespace chip {
 			@param[in]	spi	SPI クラスを参照で渡す
 		 */
 		//-----------------------------------------------------------------//
-		MAX7219(SPI& spi) noexcept : spi_(spi), fb_{ 0 } { }
+		MAX7219(SPI& spi) noexcept : spi_(spi), fb_{ 0 }, sent_{ 0 }, ofs_(0), force_(true) { }
 
 
 		//-----------------------------------------------------------------//
@@ -105,6 +135,7 @@ namespace chip {
 
 			set_intensity(0);  // 輝度（最低）
 
+			refresh();
 			service();
 
 			return true;
@@ -125,10 +156,27 @@ namespace chip {
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief 次の service で全桁を転送させる
+		 */
+		//-----------------------------------------------------------------//
+		void refresh() noexcept { force_ = true; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief バッファのサイズを取得
+			@return バッファのサイズ（８×CHAIN）
+		 */
+		//-----------------------------------------------------------------//
+		static uint8_t size() noexcept { return NUM; }
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief サービス @n
-				   フレームバッファを転送
+				   フレームバッファの変化した桁だけを転送
 		 */
 		//-----------------------------------------------------------------//
 		void service() noexcept
@@ -136,8 +184,9 @@ namespace chip {
 			auto cmd = COMMAND::DIGIT_0;
 			for(uint8_t i = 0; i < 8; ++i) {
 				out_digit_(cmd, i);
-				cmd = static_cast<COMMAND>(static_cast<uint8_t>(cmd) + 1);					
+				cmd = static_cast<COMMAND>(static_cast<uint8_t>(cmd) + 1);
 			}
+			force_ = false;
 		}
 
 
@@ -150,9 +199,9 @@ namespace chip {
 		//-----------------------------------------------------------------//
 		void set(uint8_t idx, uint8_t val) noexcept
 		{
-			if(idx >= (CHAIN * 8)) return;
+			if(idx >= NUM) return;
 
-			fb_[idx] = val;
+			fb_[pos_(idx)] = val;
 		}
 
 
@@ -165,21 +214,21 @@ namespace chip {
 		//-----------------------------------------------------------------//
 		uint8_t get(uint8_t idx) const noexcept
 		{
-			if(idx >= (CHAIN * 8)) return 0;
+			if(idx >= NUM) return 0;
 
-			return fb_[idx];
+			return fb_[pos_(idx)];
 		}
 
 
 		//-----------------------------------------------------------------//
 		/*!
-			@brief キャラクターの設定
-			@param[in]	idx	インデックス
+			@brief ７セグメントのパターンを取得
 			@param[in]	cha	キャラクターコード
 			@param[in]	dp	小数点
+			@return パターン
 		 */
 		//-----------------------------------------------------------------//
-		void set_cha(uint8_t idx, char cha, bool dp = false) noexcept {
+		static uint8_t get_cha(char cha, bool dp = false) noexcept {
 			uint8_t d = 0;
 			switch(cha) {
 			case ' ':
@@ -333,7 +382,20 @@ namespace chip {
 				break;
 			}
 			if(dp) d |= 0x80;
-			set(idx, d);
+			return d;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief キャラクターの設定
+			@param[in]	idx	インデックス
+			@param[in]	cha	キャラクターコード
+			@param[in]	dp	小数点
+		 */
+		//-----------------------------------------------------------------//
+		void set_cha(uint8_t idx, char cha, bool dp = false) noexcept {
+			set(idx, get_cha(cha, dp));
 		}
 
 
@@ -346,9 +408,9 @@ namespace chip {
 		//-----------------------------------------------------------------//
 		uint8_t shift_top(uint8_t fill = 0) noexcept
 		{
-			uint8_t full = fb_[0];
-			std::memmove(&fb_[1], &fb_[0], CHAIN * 8 - 1);
-			fb_[0] = fill;
+			ofs_ = pos_(NUM - 1);
+			uint8_t full = fb_[ofs_];
+			fb_[ofs_] = fill;
 			return full;
 		}
 
@@ -362,9 +424,9 @@ namespace chip {
 		//-----------------------------------------------------------------//
 		uint8_t shift_end(uint8_t fill = 0) noexcept
 		{
-			uint8_t full = fb_[CHAIN * 8 - 1];
-			std::memmove(&fb_[0], &fb_[1], CHAIN * 8 - 1);
-			fb_[CHAIN * 8 - 1] = fill;
+			uint8_t full = fb_[ofs_];
+			fb_[ofs_] = fill;
+			ofs_ = pos_(1);
 			return full;
 		}
 
@@ -377,10 +439,111 @@ namespace chip {
 		//-----------------------------------------------------------------//
 		uint8_t& operator [] (uint8_t idx)
 		{
-			if(idx >= (CHAIN * 8)) {
-				idx %= CHAIN * 8;
+			if(idx >= NUM) {
+				idx %= NUM;
+			}
+			return fb_[pos_(idx)];
+		}
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  MAX7219 スクロール表示クラス @n
+				テキストを、１桁（７セグメント）又は１カラム（8x8 マトリックス）@n
+				ずつ、shift_top で送り込む。@n
+				７セグメントでは、文字に続く「.」は小数点として合成する。@n
+				（文字に続かない「.」は、小数点だけの桁）
+		@param[in]	DEV	MAX7219 クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class DEV>
+	class MAX7219_marquee {
+
+		DEV&			dev_;
+		const uint8_t*	font_;
+		const char*		text_;
+		const char*		ptr_;
+		uint8_t			col_;
+		uint8_t			tail_;
+		bool			loop_;
+
+		uint8_t next_() noexcept
+		{
+			char ch = *ptr_;
+			if(font_ == nullptr) {
+				++ptr_;
+				bool dp = ch == '.';  // 前の文字に合成されない小数点は、小数点だけの桁
+				if(ch != '.' && *ptr_ == '.') {
+					dp = true;
+					++ptr_;
+				}
+				return DEV::get_cha(ch, dp);
+			}
+			uint8_t v = 0;
+			if(ch >= 0x20 && ch < 0x7f) {
+				v = font_[(static_cast<uint16_t>(ch) - 0x20) * 8 + col_];
+			}
+			++col_;
+			if(col_ >= 8) {
+				col_ = 0;
+				++ptr_;
+			}
+			return v;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+			@param[in]	dev		MAX7219 クラス
+			@param[in]	font	8x8 フォント（0x20 ～ 0x7e、１文字８カラム）@n
+								「nullptr」なら７セグメント
+		 */
+		//-----------------------------------------------------------------//
+		MAX7219_marquee(DEV& dev, const uint8_t* font = nullptr) noexcept :
+			dev_(dev), font_(font), text_(""), ptr_(""), col_(0), tail_(0), loop_(false) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	スクロール開始
+			@param[in]	text	テキスト（終了まで保持する事）
+			@param[in]	loop	繰り返す場合「true」
+		 */
+		//-----------------------------------------------------------------//
+		void start(const char* text, bool loop = false) noexcept
+		{
+			text_ = text;
+			ptr_ = text;
+			col_ = 0;
+			tail_ = DEV::size();
+			loop_ = loop;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	１ステップ進める（転送は MAX7219::service で行う）
+			@return 全て送り出したら「false」
+		 */
+		//-----------------------------------------------------------------//
+		bool step() noexcept
+		{
+			if(*ptr_ != 0) {
+				dev_.shift_top(next_());
+				return true;
+			}
+			if(tail_ > 0) {  // テキストが全て抜けるまで空白を送る
+				dev_.shift_top(0);
+				--tail_;
+				return true;
+			}
+			if(loop_ && *text_ != 0) {
+				start(text_, true);
+				return step();
 			}
-			return fb_[idx];
+			return false;
 		}
 	};
 }
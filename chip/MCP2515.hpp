@@ -179,6 +179,7 @@ namespace chip {
 		static const uint8_t MCP_WRITE   = 0x03;
 		static const uint8_t MCP_BITMOD  = 0x05;
 		static const uint8_t MCP_STATUS  = 0xA0;
+		static const uint8_t MCP_READ_RX = 0x90;
 		static const uint8_t MCP_RESET   = 0xC0;
 
 		static const uint8_t MCP_RX0IF   = 0x01;
@@ -892,6 +893,105 @@ namespace chip {
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	チップ選択（spi_queue の select）
+			@param[in]	ena	選択する場合「true」
+		 */
+		//-----------------------------------------------------------------//
+		static void select(bool ena) noexcept
+		{
+			SEL::P = !ena;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ステータス読み出しを、転送キューに積む（spi_queue） @n
+					完了タスクで、buf[1] を get_recv_buffer に渡す。
+			@param[in]	que		転送キュー
+			@param[in]	buf		バッファ（２バイト、完了まで保持する事）
+			@param[in]	task	完了タスク
+			@param[in]	ctx		完了タスクへ渡す値
+			@return キューが一杯なら「false」
+		 */
+		//-----------------------------------------------------------------//
+		template <class QUEUE>
+		static bool status(QUEUE& que, uint8_t* buf, typename QUEUE::task_type task, void* ctx = nullptr) noexcept
+		{
+			buf[0] = MCP_STATUS;
+			buf[1] = 0xff;
+			return que.put(select, buf, buf, 2, task, ctx);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ステータスから、受信したバッファを取得
+			@param[in]	sts	ステータス
+			@return バッファ番号（０、１）、受信が無ければ「0xff」
+		 */
+		//-----------------------------------------------------------------//
+		static uint8_t get_recv_buffer(uint8_t sts) noexcept
+		{
+			if(sts & MCP_STAT_RX0IF) return 0;
+			else if(sts & MCP_STAT_RX1IF) return 1;
+			return 0xff;
+		}
+
+
+		static const uint8_t RECV_BUFF_SIZE = 14;	///< 命令、ID（４）、DLC、データ（８）
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	受信バッファの読み出しを、転送キューに積む（spi_queue） @n
+					READ RX BUFFER 命令なので、読み終えると受信フラグは @n
+					クリアされる、完了タスクで decode_recv に渡す。
+			@param[in]	que		転送キュー
+			@param[in]	n		バッファ番号（０、１）
+			@param[in]	buf		バッファ（RECV_BUFF_SIZE バイト、完了まで保持する事）
+			@param[in]	task	完了タスク
+			@param[in]	ctx		完了タスクへ渡す値
+			@return キューが一杯なら「false」
+		 */
+		//-----------------------------------------------------------------//
+		template <class QUEUE>
+		static bool recv_buffer(QUEUE& que, uint8_t n, uint8_t* buf, typename QUEUE::task_type task,
+			void* ctx = nullptr) noexcept
+		{
+			buf[0] = MCP_READ_RX | ((n & 1) << 2);
+			std::memset(&buf[1], 0xff, RECV_BUFF_SIZE - 1);
+			return que.put(select, buf, buf, RECV_BUFF_SIZE, task, ctx);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	読み出した受信バッファを、メッセージに変換
+			@param[in]	buf	recv_buffer で読み出したバッファ
+			@param[out]	id	ID
+			@param[out]	ext	拡張フラグ
+			@param[out]	dst	データ（８バイト）
+			@param[out]	len	データのバイト数
+		 */
+		//-----------------------------------------------------------------//
+		static void decode_recv(const uint8_t* buf, uint32_t& id, uint8_t& ext, void* dst, uint8_t& len) noexcept
+		{
+			const uint8_t* tmp = &buf[1];
+			ext = 0;
+			id = (static_cast<uint32_t>(tmp[MCP_SIDH]) << 3) | (static_cast<uint32_t>(tmp[MCP_SIDL]) >> 5);
+			if((tmp[MCP_SIDL] & MCP_TXB_EXIDE_M) == MCP_TXB_EXIDE_M) {  // extended id
+				id = (id << 2) | static_cast<uint32_t>(tmp[MCP_SIDL] & 0x03);
+				id = (id << 8) | static_cast<uint32_t>(tmp[MCP_EID8]);
+				id = (id << 8) + tmp[MCP_EID0];
+				ext = 1;
+			}
+			len = tmp[4] & MCP_DLC_MASK;
+			if(len > 8) len = 8;
+			std::memcpy(dst, &tmp[5], len);
+		}
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	エラーの取得（警告を含む）
@@ -410,9 +410,7 @@ DMP_MEMORY_CHUNK_SIZE   16
 
 		uint8_t recv_(REG reg) const {
 			uint8_t tmp[1];
-			tmp[0] = static_cast<uint8_t>(reg);
-			i2c_.send(MPU6050_ADR_, tmp, 1);
-			i2c_.recv(MPU6050_ADR_, tmp, 1);
+			i2c_.write_then_read(MPU6050_ADR_, static_cast<uint8_t>(reg), tmp, 1);
 			return tmp[0];
 		}
 
@@ -426,8 +424,7 @@ DMP_MEMORY_CHUNK_SIZE   16
 		void set_bit_(REG reg, uint8_t bpos, bool f) {
 			uint8_t tmp[2];
 			tmp[0] = static_cast<uint8_t>(reg);
-			i2c_.send(MPU6050_ADR_, tmp, 1);
-			i2c_.recv(MPU6050_ADR_, &tmp[1], 1);
+			i2c_.write_then_read(MPU6050_ADR_, tmp[0], &tmp[1], 1);
 			if(f) tmp[1] |= 1 << bpos;
 			else tmp[1] &= ~(1 << bpos);
  			i2c_.send(MPU6050_ADR_, tmp, 2);
@@ -436,8 +433,7 @@ DMP_MEMORY_CHUNK_SIZE   16
 		void set_bits_(REG reg, uint8_t bpos, uint8_t len, uint8_t v) {
 			uint8_t tmp[2];
 			tmp[0] = static_cast<uint8_t>(reg);
-			i2c_.send(MPU6050_ADR_, tmp, 1);
-			i2c_.recv(MPU6050_ADR_, &tmp[1], 1);
+			i2c_.write_then_read(MPU6050_ADR_, tmp[0], &tmp[1], 1);
 			tmp[1] &= ((1 << len) - 1) << bpos;
 			tmp[1] |= v << bpos;
  			i2c_.send(MPU6050_ADR_, tmp, 2);
@@ -445,25 +441,19 @@ DMP_MEMORY_CHUNK_SIZE   16
 
 		void get_8_(REG reg, uint8_t& v) const {
 			uint8_t tmp[1];
-			tmp[0] = static_cast<uint8_t>(reg);
-			i2c_.send(MPU6050_ADR_, tmp, 1);
-			i2c_.recv(MPU6050_ADR_, tmp, 1);
+			i2c_.write_then_read(MPU6050_ADR_, static_cast<uint8_t>(reg), tmp, 1);
 			v = tmp[0];
 		}
 
 		void get_16_(REG reg, uint16_t& v) const {
 			uint8_t tmp[2];
-			tmp[0] = static_cast<uint8_t>(reg);
-			i2c_.send(MPU6050_ADR_, tmp, 1);
-			i2c_.recv(MPU6050_ADR_, tmp, 2);
+			i2c_.write_then_read(MPU6050_ADR_, static_cast<uint8_t>(reg), tmp, 2);
 		    v = static_cast<uint16_t>((tmp[0] << 8) | tmp[1]);
 		}
 
 		void get_vec_(REG reg, int16_vec& vec) const {
 			uint8_t tmp[6];
-			tmp[0] = static_cast<uint8_t>(reg);
-			i2c_.send(MPU6050_ADR_, tmp, 1);
-			i2c_.recv(MPU6050_ADR_, tmp, 6);
+			i2c_.write_then_read(MPU6050_ADR_, static_cast<uint8_t>(reg), tmp, 6);
 		    vec.x = static_cast<int16_t>((tmp[0] << 8) | tmp[1]);
 		    vec.y = static_cast<int16_t>((tmp[2] << 8) | tmp[3]);
 		    vec.z = static_cast<int16_t>((tmp[4] << 8) | tmp[5]);
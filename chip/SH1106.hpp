@@ -8,6 +8,7 @@
 //=====================================================================//
 #include <cstdint>
 #include "common/delay.hpp"
+#include "common/dirty_page.hpp"
 
 namespace chip {
 
@@ -26,6 +27,9 @@ namespace chip {
 
 		CSI_IO&	csi_;
 
+		/// SH1106 の RAM は 132 カラムで、128 ドットのパネルは２カラム目から
+		static const uint8_t COLUMN_OFS = 2;
+
 		enum class CMD : uint8_t {
 			SETCONTRAST			= 0x81,
 			DISPLAYALLON_RESUME	= 0xA4,
@@ -47,6 +51,7 @@ namespace chip {
 
 			SETLOWCOLUMN		= 0x00,
 			SETHIGHCOLUMN		= 0x10,
+			SETPAGE				= 0xB0,
 
 			SETSTARTLINE		= 0x40,
 
@@ -119,6 +124,16 @@ namespace chip {
 		}
 
 
+		// CS、DC は呼び出し側で制御する
+		void set_pointer_(uint8_t x, uint8_t page)
+		{
+			x += COLUMN_OFS;
+			csi_.xchg(static_cast<uint8_t>(CMD::SETPAGE) | page);
+			csi_.xchg(static_cast<uint8_t>(CMD::SETLOWCOLUMN) | (x & 0x0f));
+			csi_.xchg(static_cast<uint8_t>(CMD::SETHIGHCOLUMN) | (x >> 4));
+		}
+
+
 #if 0
 
 // startscrollright
@@ -397,5 +412,100 @@ void Adafruit_SH1106::stopscroll(void){
 				write_cmd_(CMD::NORMALDISPLAY);
 			}
 		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  コピー
+			@param[in]	src	フレームバッファソース
+			@param[in]	num	転送ページ数
+			@param[in]	ofs	転送先オフセット
+		*/
+		//-----------------------------------------------------------------//
+		void copy(const uint8_t* src, uint8_t num, uint8_t ofs = 0)
+		{
+			CS::P = 0;
+			for(uint8_t page = 0; page < num; ++page) {
+				DC::P = 0;
+				set_pointer_(0, page + ofs);
+				DC::P = 1;
+				csi_.send(src, 128);
+				src += 128;
+			}
+			DC::P = 0;
+			CS::P = 1;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  更新範囲だけコピー（転送後、更新範囲はクリアされる）
+			@param[in]	src		フレームバッファソース
+			@param[in]	dirty	更新範囲
+			@param[in]	ofs		転送先オフセット
+		*/
+		//-----------------------------------------------------------------//
+		template <int16_t W, uint8_t PAGES>
+		void copy(const uint8_t* src, graphics::dirty_page<W, PAGES>& dirty, uint8_t ofs = 0)
+		{
+			CS::P = 0;
+			for(uint8_t page = 0; page < PAGES; ++page) {
+				uint8_t org;
+				uint8_t end;
+				if(dirty.get(page, org, end)) {
+					DC::P = 0;
+					set_pointer_(org, page + ofs);
+					DC::P = 1;
+					csi_.send(&src[org], end - org);
+				}
+				src += W;
+			}
+			DC::P = 0;
+			CS::P = 1;
+			dirty.clear();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  転送開始（チップを選択して、アドレスを設定） @n
+					以降 write でデータを送り、end_area で終了する。@n
+					割り込み内から、少しずつ転送する場合に使う。
+			@param[in]	page	ページ
+			@param[in]	col		カラム
+		*/
+		//-----------------------------------------------------------------//
+		void set_area(uint8_t page, uint8_t col)
+		{
+			CS::P = 0;
+			DC::P = 0;
+			set_pointer_(col, page);
+			DC::P = 1;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  データを送る（カラムは自動で進む）
+			@param[in]	src	ソース
+			@param[in]	len	バイト数
+		*/
+		//-----------------------------------------------------------------//
+		void write(const uint8_t* src, uint16_t len)
+		{
+			csi_.send(src, len);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  転送終了（チップの選択を解除）
+		*/
+		//-----------------------------------------------------------------//
+		void end_area()
+		{
+			DC::P = 0;
+			CS::P = 1;
+		}
 	};
 }
@@ -8,6 +8,7 @@
 //=====================================================================//
 #include <cstdint>
 #include "common/delay.hpp"
+#include "common/dirty_page.hpp"
 
 namespace chip {
 
@@ -218,5 +219,129 @@ namespace chip {
 			chip_enable_(false);
 		}
 
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  更新範囲だけコピー（転送後、更新範囲はクリアされる）
+			@param[in]	src		フレームバッファソース
+			@param[in]	dirty	更新範囲
+			@param[in]	ofs		転送先オフセット
+		*/
+		//-----------------------------------------------------------------//
+		template <int16_t W, uint8_t PAGES>
+		void copy(const uint8_t* src, graphics::dirty_page<W, PAGES>& dirty, uint8_t ofs = 0) {
+			chip_enable_();
+			for(uint8_t page = 0; page < PAGES; ++page) {
+				uint8_t org;
+				uint8_t end;
+				if(dirty.get(page, org, end)) {
+					reg_select_(0);
+					write_(CMD::SET_COLUMN_LOWER, org & 0x0f);
+					write_(CMD::SET_COLUMN_UPPER, org >> 4);
+					write_(CMD::SET_PAGE, page + ofs);
+					reg_select_(1);
+					csi_.send(&src[org], end - org);
+				}
+				src += W;
+			}
+			reg_select_(0);
+			chip_enable_(false);
+			dirty.clear();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  コマンドのチップ選択（spi_queue の select）
+			@param[in]	ena	選択する場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		static void select_command(bool ena) {
+			A0::P = 0;
+			CS::P = !ena;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  データのチップ選択（spi_queue の select）
+			@param[in]	ena	選択する場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		static void select_data(bool ena) {
+			A0::P = ena;
+			CS::P = !ena;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  範囲を転送キューに積む（spi_queue） @n
+					アドレス設定とデータの、二つの要求を積む。@n
+					完了タスクが呼ばれるまで、src と cmd は書き換えない事。
+			@param[in]	que		転送キュー
+			@param[in]	src		ソース（開始カラムの位置）
+			@param[in]	page	ページ
+			@param[in]	col		開始カラム
+			@param[in]	len		バイト数
+			@param[in]	cmd		コマンド・バッファ（３バイト）
+			@param[in]	task	完了タスク
+			@param[in]	ctx		完了タスクへ渡す値
+			@return キューに空きが無い場合「false」（何も積まない）
+		*/
+		//-----------------------------------------------------------------//
+		template <class QUEUE>
+		bool copy(QUEUE& que, const uint8_t* src, uint8_t page, uint8_t col, uint16_t len, uint8_t* cmd,
+			typename QUEUE::task_type task = nullptr, void* ctx = nullptr) {
+			if(que.space() < 2) return false;
+			cmd[0] = static_cast<uint8_t>(CMD::SET_COLUMN_LOWER) | (col & 0x0f);
+			cmd[1] = static_cast<uint8_t>(CMD::SET_COLUMN_UPPER) | (col >> 4);
+			cmd[2] = static_cast<uint8_t>(CMD::SET_PAGE) | page;
+			que.put(select_command, cmd, nullptr, 3);
+			que.put(select_data, src, nullptr, len, task, ctx);
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  転送開始（チップを選択して、アドレスを設定） @n
+					以降 write でデータを送り、end_area で終了する。@n
+					割り込み内から、少しずつ転送する場合に使う。
+			@param[in]	page	ページ
+			@param[in]	col		カラム
+		*/
+		//-----------------------------------------------------------------//
+		void set_area(uint8_t page, uint8_t col) {
+			chip_enable_();
+			reg_select_(0);
+			write_(CMD::SET_COLUMN_LOWER, col & 0x0f);
+			write_(CMD::SET_COLUMN_UPPER, col >> 4);
+			write_(CMD::SET_PAGE, page);
+			reg_select_(1);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  データを送る（カラムは自動で進む）
+			@param[in]	src	ソース
+			@param[in]	len	バイト数
+		*/
+		//-----------------------------------------------------------------//
+		void write(const uint8_t* src, uint16_t len) {
+			csi_.send(src, len);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  転送終了（チップの選択を解除）
+		*/
+		//-----------------------------------------------------------------//
+		void end_area() {
+			reg_select_(0);
+			chip_enable_(false);
+		}
 	};
 }
@@ -8,6 +8,7 @@
 //=====================================================================//
 #include <cstdint>
 #include "common/delay.hpp"
+#include "common/dirty_page.hpp"
 
 namespace chip {
 
@@ -132,5 +133,72 @@ namespace chip {
 			chip_enable_(false);
 		}
 
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  更新範囲だけコピー（転送後、更新範囲はクリアされる）
+			@param[in]	src		フレームバッファソース
+			@param[in]	dirty	更新範囲
+			@param[in]	ofs		転送オフセット
+		*/
+		//-----------------------------------------------------------------//
+		template <int16_t W, uint8_t PAGES>
+		void copy(const uint8_t* src, graphics::dirty_page<W, PAGES>& dirty, uint8_t ofs = 0) {
+			chip_enable_();
+			for(uint8_t page = 0; page < PAGES; ++page) {
+				uint8_t org;
+				uint8_t end;
+				if(dirty.get(page, org, end)) {
+					reg_select_(0);
+					set_pointer_(org, page + ofs);
+					reg_select_(1);
+					csi_.send(&src[org], end - org);
+				}
+				src += W;
+			}
+			reg_select_(0);
+			chip_enable_(false);
+			dirty.clear();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  転送開始（チップを選択して、アドレスを設定） @n
+					以降 write でデータを送り、end_area で終了する。@n
+					割り込み内から、少しずつ転送する場合に使う。
+			@param[in]	page	ページ
+			@param[in]	col		カラム
+		*/
+		//-----------------------------------------------------------------//
+		void set_area(uint8_t page, uint8_t col) {
+			chip_enable_();
+			reg_select_(0);
+			set_pointer_(col, page);
+			reg_select_(1);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  データを送る（カラムは自動で進む）
+			@param[in]	src	ソース
+			@param[in]	len	バイト数
+		*/
+		//-----------------------------------------------------------------//
+		void write(const uint8_t* src, uint16_t len) {
+			csi_.send(src, len);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  転送終了（チップの選択を解除）
+		*/
+		//-----------------------------------------------------------------//
+		void end_area() {
+			reg_select_(0);
+			chip_enable_(false);
+		}
 	};
 }
@@ -229,35 +229,25 @@ namespace chip {
 		uint8_t read_(reg_addr reg)
 		{
 			uint8_t tmp[1];
-			tmp[0] = static_cast<uint8_t>(reg);
-			last_status_ = i2c_io_.send(ADR_, tmp, 1);
+			last_status_ = i2c_io_.write_then_read(ADR_, static_cast<uint8_t>(reg), tmp, 1);
 			if(!last_status_) return 0;
 
-			last_status_ = i2c_io_.recv(ADR_, tmp, 1);
 			return tmp[0];
 		}
 
 
 		bool read_(reg_addr reg, uint8_t* dst, uint8_t len)
 		{
-			uint8_t tmp[1];
-			tmp[0] = static_cast<uint8_t>(reg);
-			if(!i2c_io_.send(ADR_, tmp, 1)) {
-				return false;
-			}
-
-			return i2c_io_.recv(ADR_, dst, len);
+			return i2c_io_.write_then_read(ADR_, static_cast<uint8_t>(reg), dst, len);
 		}
 
 
 		uint16_t read16_(reg_addr reg)
 		{
 			uint8_t tmp[2];
-			tmp[0] = static_cast<uint8_t>(reg);
-			last_status_ = i2c_io_.send(ADR_, tmp, 1);
+			last_status_ = i2c_io_.write_then_read(ADR_, static_cast<uint8_t>(reg), tmp, 2);
 			if(!last_status_) return 0;
 
-			last_status_ =  i2c_io_.recv(ADR_, tmp, 2);
 			uint16_t value = static_cast<uint16_t>(tmp[0]) << 8;
 			value |= static_cast<uint16_t>(tmp[1]);
 			return value;
@@ -267,11 +257,9 @@ namespace chip {
 		uint32_t read32_(reg_addr reg)
 		{
 			uint8_t tmp[4];
-			tmp[0] = static_cast<uint8_t>(reg);
-			last_status_ = i2c_io_.send(ADR_, tmp, 1);
+			last_status_ = i2c_io_.write_then_read(ADR_, static_cast<uint8_t>(reg), tmp, 4);
 			if(!last_status_) return 0;
 
-			last_status_ =  i2c_io_.recv(ADR_, tmp, 4);
 			uint32_t value = static_cast<uint32_t>(tmp[0]) << 24;
 			value |= static_cast<uint32_t>(tmp[1]) << 16;
 			value |= static_cast<uint32_t>(tmp[2]) << 8;
@@ -0,0 +1,487 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	Arithmetic コード・テンプレート @n
+			※basic_arith と同じ文法の数式を、一度だけ解析して、@n
+			後置記法のバイトコードに変換する。@n
+			定数同士の演算は、変換時に畳み込まれる。@n
+			変数（シンボル）は、変換時にスロット番号に置き換えられ、@n
+			評価時に、値の配列を与える。@n
+			VTYPE が浮動小数点の場合、整数専用の演算（//、<<、>>、&、^、|）は、@n
+			変換時にエラーとなる。@n
+			SYMBOL クラスには、以下の関数が必要 @n
+			int16_t find(const char* name, uint8_t len) const;  // スロット番号、無ければ負の値
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <type_traits>
+#include "common/basic_arith.hpp"
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	シンボル無しクラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	struct arith_null_symbol {
+		int16_t find(const char* name, uint8_t len) const { return -1; }
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	Arithmetic コード・クラス
+		@param[in]	VTYPE	基本型（整数、浮動小数点、fixed_point）
+		@param[in]	CSIZE	コード・バッファの最大サイズ
+		@param[in]	NSIZE	定数の最大数
+		@param[in]	SSIZE	評価スタックの最大深さ
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <typename VTYPE, uint8_t CSIZE = 32, uint8_t NSIZE = 8, uint8_t SSIZE = 8>
+	class arith_code {
+	public:
+		typedef typename basic_arith<VTYPE>::error error;
+		typedef typename basic_arith<VTYPE>::error_t error_t;
+
+	private:
+		// 命令コード（上位２ビットが 0b11 の場合、下位６ビットは変数スロット）
+		enum class opc : uint8_t {
+			END,
+			NUM,	///< 定数（次のバイトが定数番号）
+			NEG,
+			ADD,
+			SUB,
+			MUL,
+			DIV,
+			MOD,
+			SHL,
+			SHR,
+			AND,
+			XOR,
+			OR,
+			VAR = 0xc0,
+		};
+
+		uint8_t		code_[CSIZE];
+		VTYPE		num_[NSIZE];
+
+		uint8_t		cpos_;
+		uint8_t		npos_;
+		uint8_t		depth_;
+
+		const char*	tx_;
+		char		ch_;
+
+		error_t		error_;
+
+		void emit_(opc c) {
+			if(cpos_ >= CSIZE) {
+				error_.set(error::fatal);
+				return;
+			}
+			code_[cpos_] = static_cast<uint8_t>(c);
+			++cpos_;
+		}
+
+
+		void check_depth_(uint8_t n) {
+			if(n > SSIZE) {
+				error_.set(error::fatal);
+			}
+		}
+
+
+		void emit_num_(const VTYPE& v) {
+			if(npos_ >= NSIZE || (cpos_ + 1) >= CSIZE) {
+				error_.set(error::fatal);
+				return;
+			}
+			num_[npos_] = v;
+			code_[cpos_++] = static_cast<uint8_t>(opc::NUM);
+			code_[cpos_++] = npos_;
+			++npos_;
+			++depth_;
+			check_depth_(depth_);
+		}
+
+
+		void emit_var_(uint8_t slot) {
+			emit_(static_cast<opc>(static_cast<uint8_t>(opc::VAR) | slot));
+			++depth_;
+			check_depth_(depth_);
+		}
+
+
+		// 末尾の命令が定数なら、その位置を返す
+		int16_t last_num_(uint8_t back) const {
+			int16_t pos = cpos_;
+			for(uint8_t i = 0; i <= back; ++i) {
+				pos -= 2;
+				if(pos < 0) return -1;
+				if(code_[pos] != static_cast<uint8_t>(opc::NUM)) return -1;
+				// 定数番号は、必ず直前の定数から連続している
+				if(code_[pos + 1] != (npos_ - 1 - i)) return -1;
+			}
+			return pos;
+		}
+
+
+		// 整数専用の演算（浮動小数点では、変換時に弾く）
+		static void calc_int_(opc c, VTYPE& a, const VTYPE& b, std::false_type) {
+			switch(c) {
+			case opc::MOD: a %= b; break;
+			case opc::SHL: a <<= b; break;
+			case opc::SHR: a >>= b; break;
+			case opc::AND: a &= b; break;
+			case opc::XOR: a ^= b; break;
+			case opc::OR:  a |= b; break;
+			default:
+				break;
+			}
+		}
+
+		static void calc_int_(opc c, VTYPE& a, const VTYPE& b, std::true_type) { }
+
+
+		static bool calc_(opc c, VTYPE& a, const VTYPE& b) {
+			switch(c) {
+			case opc::ADD: a += b; break;
+			case opc::SUB: a -= b; break;
+			case opc::MUL: a *= b; break;
+			case opc::DIV:
+				if(b == 0) return false;
+				a /= b;
+				break;
+			case opc::MOD:
+				if(b == 0) return false;
+				calc_int_(c, a, b, std::is_floating_point<VTYPE>());
+				break;
+			default:
+				calc_int_(c, a, b, std::is_floating_point<VTYPE>());
+				break;
+			}
+			return true;
+		}
+
+
+		void emit_op_(opc c) {
+			if(error_() != 0) return;
+			if(std::is_floating_point<VTYPE>::value && c >= opc::MOD) {
+				error_.set(error::fatal);
+				return;
+			}
+			--depth_;
+			auto pos = last_num_(1);
+			if(pos >= 0) {  // 定数の畳み込み
+				VTYPE a = num_[npos_ - 2];
+				if(!calc_(c, a, num_[npos_ - 1])) {
+					error_.set(error::zero_divide);
+					return;
+				}
+				num_[npos_ - 2] = a;
+				--npos_;
+				cpos_ -= 2;
+			} else {
+				emit_(c);
+			}
+		}
+
+
+		void emit_neg_() {
+			auto pos = last_num_(0);
+			if(pos >= 0) {
+				num_[npos_ - 1] = -num_[npos_ - 1];
+			} else {
+				emit_(opc::NEG);
+			}
+		}
+
+
+		void skip_space_() {
+			while(ch_ == ' ' || ch_ == '\t') {
+				ch_ = *tx_++;
+			}
+		}
+
+
+		static bool symbol_top_(char ch) {
+			return (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') || ch == '_' || ch == '?';
+		}
+
+
+		template <class SYMBOL>
+		void number_(const SYMBOL& sym) {
+			bool inv = false;
+			skip_space_();
+
+			if(ch_ == '-') {
+				inv = true;
+				ch_ = *tx_++;
+			} else if(ch_ == '+') {
+				ch_ = *tx_++;
+			}
+
+			skip_space_();
+
+			if(ch_ == '(') {
+				factor_(sym);
+			} else if(symbol_top_(ch_)) {
+				const char* top = tx_ - 1;
+				while(symbol_top_(ch_) || (ch_ >= '0' && ch_ <= '9')) {
+					ch_ = *tx_++;
+				}
+				auto slot = sym.find(top, static_cast<uint8_t>(tx_ - 1 - top));
+				if(slot < 0 || slot >= 0x40) {
+					error_.set(error::symbol_fatal);
+					return;
+				}
+				emit_var_(static_cast<uint8_t>(slot));
+				skip_space_();
+			} else {
+				bool point = false;
+				bool digit = false;
+				uint32_t v = 0;
+				uint32_t fp = 0;
+				uint32_t fs = 1;
+				while(ch_ != 0) {
+					if(ch_ == '.') {
+						if(point) {
+							error_.set(error::fatal);
+							return;
+						}
+						point = true;
+					} else if(ch_ >= '0' && ch_ <= '9') {
+						digit = true;
+						if(point) {
+							fp *= 10;
+							fp += ch_ - '0';
+							fs *= 10;
+						} else {
+							v *= 10;
+							v += ch_ - '0';
+						}
+					} else if(ch_ == ' ' || ch_ == '\t') {
+					} else {
+						break;
+					}
+					ch_ = *tx_++;
+				}
+				if(!digit) {
+					error_.set(error::number_fatal);
+					return;
+				}
+				if(point) {
+					emit_num_(static_cast<VTYPE>(v) + static_cast<VTYPE>(fp) / static_cast<VTYPE>(fs));
+				} else {
+					emit_num_(static_cast<VTYPE>(v));
+				}
+			}
+			if(inv) emit_neg_();
+		}
+
+
+		template <class SYMBOL>
+		void factor_(const SYMBOL& sym) {
+			if(ch_ == '(') {
+				ch_ = *tx_++;
+				expression_(sym);
+				if(ch_ == ')') {
+					ch_ = *tx_++;
+				} else {
+					error_.set(error::fatal);
+				}
+			} else {
+				number_(sym);
+			}
+		}
+
+
+		template <class SYMBOL>
+		void term_(const SYMBOL& sym) {
+			factor_(sym);
+			while(error_() == 0) {
+				opc c;
+				switch(ch_) {
+				case ' ':
+				case '\t':
+					ch_ = *tx_++;
+					continue;
+				case '*':
+					c = opc::MUL;
+					break;
+				case '%':  // basic_arith と同じく除算
+					c = opc::DIV;
+					break;
+				case '/':
+					if(*tx_ == '/') {
+						++tx_;
+						c = opc::MOD;
+					} else {
+						c = opc::DIV;
+					}
+					break;
+				case '<':
+				case '>':
+					if(*tx_ != ch_) {
+						error_.set(error::fatal);
+						return;
+					}
+					c = ch_ == '<' ? opc::SHL : opc::SHR;
+					++tx_;
+					break;
+				default:
+					return;
+				}
+				ch_ = *tx_++;
+				factor_(sym);
+				emit_op_(c);
+			}
+		}
+
+
+		template <class SYMBOL>
+		void expression_(const SYMBOL& sym) {
+			term_(sym);
+			while(error_() == 0) {
+				opc c;
+				switch(ch_) {
+				case ' ':
+				case '\t':
+					ch_ = *tx_++;
+					continue;
+				case '+': c = opc::ADD; break;
+				case '-': c = opc::SUB; break;
+				case '&': c = opc::AND; break;
+				case '^': c = opc::XOR; break;
+				case '|': c = opc::OR;  break;
+				default:
+					return;
+				}
+				ch_ = *tx_++;
+				term_(sym);
+				emit_op_(c);
+			}
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		arith_code() : cpos_(0), npos_(0), depth_(0), tx_(nullptr), ch_(0), error_() {
+			code_[0] = static_cast<uint8_t>(opc::END);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	数式をコードに変換
+			@param[in]	text	数式テキスト
+			@param[in]	sym		シンボル・クラス
+			@return	文法にエラーがあった場合、「false」
+		*/
+		//-----------------------------------------------------------------//
+		template <class SYMBOL>
+		bool compile(const char* text, const SYMBOL& sym) {
+			cpos_ = 0;
+			npos_ = 0;
+			depth_ = 0;
+			error_.clear();
+			code_[0] = static_cast<uint8_t>(opc::END);
+			if(text == nullptr) {
+				error_.set(error::fatal);
+				return false;
+			}
+			tx_ = text;
+			ch_ = *tx_++;
+			if(ch_ != 0) {
+				expression_(sym);
+			} else {
+				error_.set(error::fatal);
+			}
+			if(error_() == 0 && ch_ != 0) {
+				error_.set(error::fatal);
+			}
+			emit_(opc::END);
+			if(error_() != 0) {
+				cpos_ = 0;
+				code_[0] = static_cast<uint8_t>(opc::END);
+				return false;
+			}
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	数式をコードに変換（シンボル無し）
+			@param[in]	text	数式テキスト
+			@return	文法にエラーがあった場合、「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool compile(const char* text) { return compile(text, arith_null_symbol()); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コードを評価
+			@param[in]	var	変数スロットの値配列
+			@return	結果（０除算の場合、エラーを設定して０を返す）
+		*/
+		//-----------------------------------------------------------------//
+		VTYPE run(const VTYPE* var = nullptr) {
+			VTYPE st[SSIZE];
+			int8_t sp = -1;
+			const uint8_t* pc = code_;
+			while(1) {
+				uint8_t c = *pc++;
+				if(c >= static_cast<uint8_t>(opc::VAR)) {
+					st[++sp] = var[c & 0x3f];
+					continue;
+				}
+				switch(static_cast<opc>(c)) {
+				case opc::END:
+					if(sp < 0) return VTYPE(0);
+					return st[sp];
+				case opc::NUM:
+					st[++sp] = num_[*pc++];
+					break;
+				case opc::NEG:
+					st[sp] = -st[sp];
+					break;
+				default:
+					--sp;
+					if(!calc_(static_cast<opc>(c), st[sp], st[sp + 1])) {
+						error_.set(error::zero_divide);
+						return VTYPE(0);
+					}
+					break;
+				}
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コードの長さを取得（終端を含む）
+			@return	コードの長さ
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t size() const { return cpos_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	エラーを受け取る
+			@return エラー
+		*/
+		//-----------------------------------------------------------------//
+		const error_t& get_error() const { return error_; }
+	};
+}
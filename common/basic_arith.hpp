@@ -18,7 +18,7 @@ namespace utils {
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 	/*!
 		@brief	Arithmetic クラス
-		@param[in]	VTYPE	基本型
+		@param[in]	VTYPE	基本型（整数、fixed_point）
 		@param[in]	SYMBOL	シンボルクラス
 	*/
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
@@ -82,7 +82,9 @@ namespace utils {
 			skip_space_();
 
 			if(ch_ == '(') {
-				v = factor_();
+				VTYPE t = factor_();  // VTYPE のまま返す（fixed_point、浮動小数点）
+				if(inv) t = -t;
+				return t;
 			} else {
 				skip_space_();
 
@@ -217,7 +219,7 @@ namespace utils {
 					ch_ = *tx_++;
 					if(ch_ == '>') {
 						ch_ = *tx_++;
-						v <<= factor_();
+						v >>= factor_();
 					} else {
 						error_.set(error::fatal);
 					}
@@ -21,17 +21,31 @@ namespace utils {
 
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
     /*!
-        @brief  command class
+        @brief  command class @n
+				VT-100 のカーソルキーによる行内編集と、ヒストリー呼び出しに対応 @n
+				（↑↓：ヒストリー、←→：カーソル移動、Home/End、Delete）
 		@param[in]	buffsize	バッファサイズ（最小でも９）
+		@param[in]	histsize	ヒストリー・バッファのサイズ（０なら、ヒストリー無し）
     */
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
-	template <int16_t buffsize>
+	template <int16_t buffsize, int16_t histsize = 0>
 	class command {
 		char	buff_[buffsize];
+		char	hist_[histsize > 0 ? histsize : 1];
 		int16_t	bpos_;
 		int16_t	pos_;
+		int16_t	end_;
 		int16_t	len_;
 		int16_t tab_top_;
+		int16_t tab_end_;
+
+		int16_t	htop_;
+		int16_t	hlen_;
+		uint8_t	hnum_;
+		uint8_t	hidx_;
+
+		uint8_t	esc_;
+		uint8_t	esc_num_;
 
 		const char*	prompt_;
 
@@ -45,6 +59,12 @@ namespace utils {
 			sci_putch('J');
 		}
 
+		static void erase_eol_() {
+			sci_putch(0x1b);
+			sci_putch('[');
+			sci_putch('K');
+		}
+
 		static void save_cursor_() {
 			sci_putch(0x1b);
 			sci_putch('7');
@@ -59,13 +79,212 @@ namespace utils {
 			sci_putch('\r');	///< CR
 			sci_putch('\n');	///< LF
 		}
+
+		// カーソルを左に移動（少ない移動は BS の方が短い）
+		static void left_(int16_t n) {
+			if(n <= 0) return;
+			if(n <= 3) {
+				while(n > 0) {
+					sci_putch(0x08);
+					--n;
+				}
+				return;
+			}
+			sci_putch(0x1b);
+			sci_putch('[');
+			if(n >= 100) sci_putch('0' + (n / 100));
+			if(n >= 10) sci_putch('0' + ((n / 10) % 10));
+			sci_putch('0' + (n % 10));
+			sci_putch('D');
+		}
+
+		// ctrl コードは「^X」の２桁で表示する
+		int16_t width_(int16_t org, int16_t end) const {
+			int16_t w = 0;
+			for(int16_t i = org; i < end; ++i) {
+				w += buff_[i] < 0x20 ? 2 : 1;
+			}
+			return w;
+		}
+
+		void put_(int16_t org, int16_t end) const {
+			for(int16_t i = org; i < end; ++i) {
+				char ch = buff_[i];
+				if(ch < 0x20) {
+					sci_putch('^');
+					sci_putch(ch + 0x40);
+				} else {
+					sci_putch(ch);
+				}
+			}
+		}
+
+		void insert_(char ch) {
+			std::memmove(&buff_[pos_ + 1], &buff_[pos_], end_ - pos_);
+			buff_[pos_] = ch;
+			++end_;
+			buff_[end_] = 0;
+			put_(pos_, end_);
+			++pos_;
+			left_(width_(pos_, end_));
+		}
+
+		void remove_() {
+			std::memmove(&buff_[pos_], &buff_[pos_ + 1], end_ - pos_);
+			--end_;
+			put_(pos_, end_);
+			erase_eol_();
+			left_(width_(pos_, end_));
+		}
+
+		int16_t hnext_(int16_t p) const {
+			++p;
+			if(p >= histsize) p = 0;
+			return p;
+		}
+
+		void hist_drop_() {
+			while(hlen_ > 0) {
+				char ch = hist_[htop_];
+				htop_ = hnext_(htop_);
+				--hlen_;
+				if(ch == 0) break;
+			}
+			--hnum_;
+		}
+
+		// idx 番目に新しい行の先頭（１が最新）
+		int16_t hist_find_(uint8_t idx) const {
+			int16_t p = htop_;
+			for(uint8_t n = hnum_ - idx; n > 0; --n) {
+				while(hist_[p] != 0) p = hnext_(p);
+				p = hnext_(p);
+			}
+			return p;
+		}
+
+		void hist_add_() {
+			if(histsize <= 0 || end_ == 0 || end_ >= histsize) return;
+			if(hnum_ > 0) {  // 直前と同じ行は登録しない
+				int16_t p = hist_find_(1);
+				int16_t n = 0;
+				while(n < end_ && hist_[p] == buff_[n]) {
+					p = hnext_(p);
+					++n;
+				}
+				if(n == end_ && hist_[p] == 0) return;
+			}
+			while((hlen_ + end_ + 1) > histsize || hnum_ == 255) hist_drop_();
+			int16_t p = htop_ + hlen_;
+			if(p >= histsize) p -= histsize;
+			for(int16_t i = 0; i <= end_; ++i) {
+				hist_[p] = buff_[i];
+				p = hnext_(p);
+			}
+			hlen_ += end_ + 1;
+			++hnum_;
+		}
+
+		// ヒストリーの行に置き換える（idx が０なら空行） @n
+		// ヒストリーから直接 buff_ に写し、変化した部分だけ再描画する
+		void recall_(uint8_t idx) {
+			int16_t p = idx > 0 ? hist_find_(idx) : -1;
+			int16_t n = 0;
+			if(p >= 0) {
+				while(n < end_ && hist_[p] != 0 && hist_[p] == buff_[n]) {
+					p = hnext_(p);
+					++n;
+				}
+			}
+			if(pos_ > n) {
+				left_(width_(n, pos_));
+			} else {
+				put_(pos_, n);
+			}
+			int16_t w = width_(n, end_);
+			int16_t len = n;
+			if(p >= 0) {
+				while(hist_[p] != 0 && len < (buffsize - 1)) {
+					buff_[len] = hist_[p];
+					p = hnext_(p);
+					++len;
+				}
+			}
+			end_ = pos_ = len;
+			buff_[end_] = 0;
+			put_(n, end_);
+			if(w > width_(n, end_)) erase_eol_();
+			hidx_ = idx;
+		}
+
+		// ESC シーケンスの一部で無い場合「false」（単独の ESC）
+		bool escape_(char ch) {
+			if(esc_ == 1) {
+				if(ch == '[' || ch == 'O') {
+					esc_ = 2;
+					return true;
+				}
+				esc_ = 0;
+				return false;
+			}
+			if(ch >= '0' && ch <= '9') {
+				esc_num_ = esc_num_ * 10 + (ch - '0');
+				return true;
+			}
+			esc_ = 0;
+			tab_top_ = -1;
+			switch(ch) {
+			case 'A':	// ↑
+				if(histsize > 0 && hidx_ < hnum_) recall_(hidx_ + 1);
+				break;
+			case 'B':	// ↓
+				if(histsize > 0 && hidx_ > 0) recall_(hidx_ - 1);
+				break;
+			case 'C':	// →
+				if(pos_ < end_) {
+					put_(pos_, pos_ + 1);
+					++pos_;
+				}
+				break;
+			case 'D':	// ←
+				if(pos_ > 0) {
+					--pos_;
+					left_(width_(pos_, pos_ + 1));
+				}
+				break;
+			case 'H':	// Home
+				left_(width_(0, pos_));
+				pos_ = 0;
+				break;
+			case 'F':	// End
+				put_(pos_, end_);
+				pos_ = end_;
+				break;
+			case '~':
+				if(esc_num_ == 1) {  // Home
+					left_(width_(0, pos_));
+					pos_ = 0;
+				} else if(esc_num_ == 4) {  // End
+					put_(pos_, end_);
+					pos_ = end_;
+				} else if(esc_num_ == 3 && pos_ < end_) {  // Delete
+					remove_();
+				}
+				break;
+			default:
+				break;
+			}
+			return true;
+		}
+
 	public:
         //-----------------------------------------------------------------//
         /*!
             @brief  コンストラクター
         */
         //-----------------------------------------------------------------//
-		command() : bpos_(-1), pos_(0), len_(0), tab_top_(-1),
+		command() : bpos_(-1), pos_(0), end_(0), len_(0), tab_top_(-1), tab_end_(0),
+			htop_(0), hlen_(0), hnum_(0), hidx_(0), esc_(0), esc_num_(0),
 			prompt_(nullptr), tab_(false) { buff_[0] = 0; }
 
 
@@ -86,44 +305,56 @@ namespace utils {
         */
         //-----------------------------------------------------------------//
 		bool service() {
-			if(bpos_ < 0 && pos_ == 0) {
+			if(bpos_ < 0 && end_ == 0) {
 				if(prompt_) sci_puts(prompt_);
 			}
-			bpos_ = pos_;
+			bpos_ = end_;
 			tab_ = false;
 			while(sci_length()) {
-				if(pos_ >= (buffsize - 1)) {	///< バッファが溢れた・・
+				if(end_ >= (buffsize - 1)) {	///< バッファが溢れた・・
 					sci_putch('\\');		///< バックスラッシュ
 					buff_[buffsize - 1] = 0;
 					pos_ = 0;
+					end_ = 0;
 					bpos_ = -1;
+					hidx_ = 0;
 					crlf_();
 					return false;
-				} else if(pos_ >= (buffsize - 8)) {	///< バッファが溢れそうな警告
+				} else if(end_ >= (buffsize - 8)) {	///< バッファが溢れそうな警告
 					sci_putch('G' - 0x40);	///< Ctrl-G
 				}
 
 				char ch = sci_getch();
+				if(esc_ != 0 && escape_(ch)) {
+					continue;
+				}
 				switch(ch) {
 				case '\r':	// Enter キー
-					buff_[pos_] = 0;
-					len_ = pos_;
+					buff_[end_] = 0;
+					len_ = end_;
+					hist_add_();
 					clear_line_();
 					crlf_();
 					pos_ = 0;
+					end_ = 0;
 					bpos_ = -1;
+					hidx_ = 0;
 					tab_top_ = -1;
 					return true;
 
+				case 0x1b:	// ESC シーケンス
+					esc_ = 1;
+					esc_num_ = 0;
+					break;
+
 				case 0x08:	// バックスペース
+				case 0x7f:
+					tab_top_ = -1;
 					if(pos_) {
 						--pos_;
-						sci_putch(0x08);
-						if(buff_[pos_] < 0x20) {
-							sci_putch(0x08);
-						}
-					} else {
-						pos_ = 0;
+						left_(width_(pos_, pos_ + 1));
+						remove_();
+					} else if(end_ == 0) {
 						bpos_ = -1;
 						crlf_();
 					}
@@ -131,24 +362,15 @@ namespace utils {
 
 				case '\t':  // TAB キー
 					if(tab_top_ < 0) {
-						tab_top_ = pos_;
+						tab_top_ = tab_end_ = pos_;
 						save_cursor_();
 					}
 					tab_ = true;
 					break;
 
 				default:
-					if(ch < 0x20) {	///< 他の ctrl コード
-						buff_[pos_] = ch;
-						++pos_;
-						sci_putch('^');
-						sci_putch(ch + 0x40);
-					} else {
-						buff_[pos_] = ch;
-						++pos_;
-						sci_putch(ch);
-					}
-					buff_[pos_] = 0;
+					tab_top_ = -1;
+					insert_(ch);
 					break;
 				}
 			}
@@ -279,16 +501,35 @@ namespace utils {
 
         //-----------------------------------------------------------------//
         /*!
-            @brief  TAB キーの候補を注入
+            @brief  TAB キーが押された位置を取得
+			@return TAB 位置（TAB が押されていない場合「-1」）
+        */
+        //-----------------------------------------------------------------//
+		int16_t get_tab_top() const { return tab_top_; }
+
+
+        //-----------------------------------------------------------------//
+        /*!
+            @brief  TAB キーの候補を注入 @n
+					※TAB が押された位置に挿入し、前回注入した候補を置き換える @n
+					（カーソルより後ろの文字は残す）
 			@param[in]	key	注入文字列
         */
         //-----------------------------------------------------------------//
 		void injection_tab(const char* key) {
 			if(tab_top_ < 0) return;
-			std::strcpy(&buff_[tab_top_], key);
+			int16_t len = std::strlen(key);
+			int16_t tail = end_ - tab_end_;
+			if((tab_top_ + len + tail) >= (buffsize - 1)) return;
+			std::memmove(&buff_[tab_top_ + len], &buff_[tab_end_], tail + 1);
+			std::memcpy(&buff_[tab_top_], key, len);
+			tab_end_ = pos_ = tab_top_ + len;
+			end_ = pos_ + tail;
 
 			load_cursor_();
-			sci_puts(key);
+			clear_line_();
+			put_(tab_top_, end_);
+			left_(width_(pos_, end_));
 		}
 	};
 }
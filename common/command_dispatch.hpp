@@ -0,0 +1,333 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	コマンド・ディスパッチ・クラス @n
+			command クラスの入力行を一度だけ分解して、コマンド・テーブル @n
+			から、ハッシュで処理関数を引く。@n
+			ハッシュ値はコンパイル時に計算されるので、テーブルは ROM に置ける。@n
+			使用例： @n
+			static bool help_(const utils::command_args& args) { ... } @n
+			static constexpr utils::command_entry cmd_tbl_[] = { @n
+				utils::make_command("help", 0, 0, help_), @n
+				utils::make_command("read", 1, 2, read_), @n
+			}; @n
+			utils::command_dispatch<CMD> disp_(cmd_, cmd_tbl_); @n
+			コマンド数が HSIZE 以上のテーブルは、コンパイル・エラーになる。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <cstring>
+
+namespace utils {
+
+	//-----------------------------------------------------------------//
+	/*!
+		@brief	コマンド名のハッシュ（FNV-1a 16 ビット畳み込み）
+		@param[in]	str	文字列
+		@param[in]	len	文字数
+		@return ハッシュ値
+	*/
+	//-----------------------------------------------------------------//
+	static constexpr uint16_t command_hash(const char* str, uint8_t len)
+	{
+		uint32_t h = 2166136261u;
+		for(uint8_t i = 0; i < len; ++i) {
+			h ^= static_cast<uint8_t>(str[i]);
+			h *= 16777619u;
+		}
+		return static_cast<uint16_t>(h ^ (h >> 16));
+	}
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  分解済みコマンド行クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class command_args {
+	public:
+		static const uint8_t max_words = 8;	///< 最大ワード数
+
+	private:
+		const char*	line_;
+		uint8_t		num_;
+		uint8_t		top_[max_words];
+		uint8_t		len_[max_words];
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		command_args() : line_(""), num_(0) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  行を分解
+			@param[in]	line	コマンド行
+			@return ワード数が上限を超えた場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool parse(const char* line) {
+			line_ = line;
+			num_ = 0;
+			const char* p = line;
+			char bc = ' ';
+			while(1) {
+				char ch = *p;
+				if(bc == ' ' && ch != ' ' && ch != 0) {
+					if(num_ >= max_words) return false;
+					top_[num_] = p - line;
+				}
+				if(bc != ' ' && (ch == ' ' || ch == 0)) {
+					len_[num_] = p - line - top_[num_];
+					++num_;
+				}
+				if(ch == 0) break;
+				bc = ch;
+				++p;
+			}
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ワード数を取得
+			@return ワード数
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t get_words() const { return num_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ワードの先頭を取得（終端はスペース、又は「０」）
+			@param[in]	argc	ワード位置
+			@return ワードの先頭
+		*/
+		//-----------------------------------------------------------------//
+		const char* top(uint8_t argc) const { return &line_[top_[argc]]; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ワードの長さを取得
+			@param[in]	argc	ワード位置
+			@return ワードの長さ
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t length(uint8_t argc) const { return len_[argc]; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ワードを取得
+			@param[in]	argc	ワード位置
+			@param[in]	limit	ワード文字列リミット数（終端を含む）
+			@param[out]	word	ワード文字列格納ポインター
+			@return 取得できたら「true」を返す
+		*/
+		//-----------------------------------------------------------------//
+		bool get_word(uint8_t argc, uint8_t limit, char* word) const {
+			if(argc >= num_ || limit == 0) return false;
+			uint8_t n = len_[argc];
+			if(n >= limit) n = limit - 1;
+			std::strncpy(word, top(argc), n);
+			word[n] = 0;
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ワードを比較
+			@param[in]	argc	ワード位置
+			@param[in]	key		比較文字列
+			@return 一致したら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool cmp_word(uint8_t argc, const char* key) const {
+			if(argc >= num_ || key == nullptr) return false;
+			if(std::strlen(key) != len_[argc]) return false;
+			return std::strncmp(key, top(argc), len_[argc]) == 0;
+		}
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  コマンド・テーブル要素
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	struct command_entry {
+		typedef bool (*func_type)(const command_args& args);
+
+		uint16_t	hash;	///< コマンド名のハッシュ
+		const char*	name;	///< コマンド名
+		uint8_t		min;	///< 最小引数の数（コマンド名を除く）
+		uint8_t		max;	///< 最大引数の数（コマンド名を除く）
+		func_type	func;	///< 処理関数（エラーなら「false」を返す）
+	};
+
+
+	//-----------------------------------------------------------------//
+	/*!
+		@brief	コマンド・テーブル要素を作成（コンパイル時）
+		@param[in]	name	コマンド名
+		@param[in]	min		最小引数の数
+		@param[in]	max		最大引数の数
+		@param[in]	func	処理関数
+		@return コマンド・テーブル要素
+	*/
+	//-----------------------------------------------------------------//
+	static constexpr command_entry make_command(const char* name, uint8_t min, uint8_t max,
+		command_entry::func_type func)
+	{
+		uint8_t len = 0;
+		while(name[len] != 0) ++len;
+		return command_entry { command_hash(name, len), name, min, max, func };
+	}
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  コマンド・ディスパッチ・クラス
+		@param[in]	COMMAND	command クラス
+		@param[in]	HSIZE	ハッシュ表のサイズ（２のべき乗、コマンド数の２倍程度、@n
+							コマンド数より大きい事）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class COMMAND, uint8_t HSIZE = 16>
+	class command_dispatch {
+
+		static_assert((HSIZE & (HSIZE - 1)) == 0, "HSIZE must be a power of 2");
+
+	public:
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  ディスパッチ結果
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class result : uint8_t {
+			none,		///< 入力途中
+			ok,			///< 処理関数が正常終了
+			empty,		///< 空行
+			unknown,	///< 登録されていないコマンド
+			arg_count,	///< 引数の数が範囲外
+			fail,		///< 処理関数がエラーを返した
+		};
+
+	private:
+		static const uint8_t empty_ = 0xff;
+
+		COMMAND&				cmd_;
+		const command_entry*	tbl_;
+		uint8_t					num_;
+		uint8_t					index_[HSIZE];
+		uint8_t					tab_idx_;
+
+		command_args			args_;
+
+		const command_entry* find_(const char* key, uint8_t len) const {
+			auto h = command_hash(key, len);
+			uint8_t i = h & (HSIZE - 1);
+			while(index_[i] != empty_) {
+				const command_entry& e = tbl_[index_[i]];
+				if(e.hash == h && std::strncmp(e.name, key, len) == 0 && e.name[len] == 0) {
+					return &e;
+				}
+				i = (i + 1) & (HSIZE - 1);
+			}
+			return nullptr;
+		}
+
+
+		void tab_() {
+			auto top = cmd_.get_tab_top();
+			if(top <= 0) return;
+			const char* line = cmd_.get_command();
+			for(int16_t i = 0; i < top; ++i) {
+				if(line[i] == ' ') return;  // コマンド名のみ補完する
+			}
+			// 候補を巡回する
+			for(uint8_t n = 0; n < num_; ++n) {
+				++tab_idx_;
+				if(tab_idx_ >= num_) tab_idx_ = 0;
+				const char* name = tbl_[tab_idx_].name;
+				if(std::strncmp(name, line, top) == 0 && name[top] != 0) {
+					cmd_.injection_tab(&name[top]);
+					return;
+				}
+			}
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  コンストラクター @n
+					ハッシュ表には、探索を止める空きが必要なので、@n
+					コマンド数は HSIZE 未満（コンパイル時に検査）
+			@param[in]	cmd	command クラス
+			@param[in]	tbl	コマンド・テーブル（配列）
+		*/
+		//-----------------------------------------------------------------//
+		template <uint32_t NUM>
+		command_dispatch(COMMAND& cmd, const command_entry (&tbl)[NUM]) :
+			cmd_(cmd), tbl_(tbl), num_(NUM), tab_idx_(NUM - 1), args_()
+		{
+			static_assert(NUM > 0 && NUM < HSIZE, "command table must have 1 to HSIZE - 1 entries");
+			for(uint8_t i = 0; i < HSIZE; ++i) index_[i] = empty_;
+			for(uint8_t n = 0; n < num_; ++n) {
+				uint8_t i = tbl_[n].hash & (HSIZE - 1);
+				while(index_[i] != empty_) {
+					i = (i + 1) & (HSIZE - 1);
+				}
+				index_[i] = n;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  サービス @n
+					定期的に呼び出す（command::service を内部で呼ぶ）
+			@return ディスパッチ結果
+		*/
+		//-----------------------------------------------------------------//
+		result service() {
+			if(!cmd_.service()) {
+				if(cmd_.probe_tab()) tab_();
+				return result::none;
+			}
+			tab_idx_ = num_ - 1;
+			if(!args_.parse(cmd_.get_command())) {
+				return result::arg_count;
+			}
+			if(args_.get_words() == 0) return result::empty;
+
+			const command_entry* e = find_(args_.top(0), args_.length(0));
+			if(e == nullptr) return result::unknown;
+
+			uint8_t n = args_.get_words() - 1;
+			if(n < e->min || n > e->max) return result::arg_count;
+
+			return e->func(args_) ? result::ok : result::fail;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  分解済みコマンド行を取得
+			@return 分解済みコマンド行
+		*/
+		//-----------------------------------------------------------------//
+		const command_args& get_args() const { return args_; }
+	};
+}
@@ -0,0 +1,155 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	ページ単位の更新領域管理クラス @n
+			ページ（縦８ピクセル）毎に、書き換えられたカラムの範囲を記録し、@n
+			LCD ドライバーは、その範囲だけを転送する。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+
+namespace graphics {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	ページ単位の更新領域管理クラス
+		@param[in]	W		横幅（最大２５５）
+		@param[in]	PAGES	ページ数
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <int16_t W, uint8_t PAGES>
+	class dirty_page {
+
+		static_assert(W <= 255, "W must be 255 or less");
+
+		uint8_t		org_[PAGES];
+		uint8_t		end_[PAGES];
+
+	public:
+		static const int16_t WIDTH = W;			///< 横幅
+		static const uint8_t PAGE_NUM = PAGES;	///< ページ数
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター（全領域を更新対象とする）
+		*/
+		//-----------------------------------------------------------------//
+		dirty_page() { all(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	全ページを更新無しにする（転送後に呼ぶ）
+		*/
+		//-----------------------------------------------------------------//
+		void clear()
+		{
+			for(uint8_t i = 0; i < PAGES; ++i) {
+				org_[i] = W;
+				end_[i] = 0;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	全ページを更新対象とする
+		*/
+		//-----------------------------------------------------------------//
+		void all()
+		{
+			for(uint8_t i = 0; i < PAGES; ++i) {
+				org_[i] = 0;
+				end_[i] = W;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	更新範囲を追加
+			@param[in]	page	ページ
+			@param[in]	org		開始カラム
+			@param[in]	end		終了カラム（含まない）
+		*/
+		//-----------------------------------------------------------------//
+		void mark(uint8_t page, uint8_t org, uint8_t end)
+		{
+			if(org < org_[page]) org_[page] = org;
+			if(end > end_[page]) end_[page] = end;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	矩形（ピクセル単位）を更新範囲に追加
+			@param[in]	x	開始位置 X
+			@param[in]	y	開始位置 Y
+			@param[in]	w	横幅
+			@param[in]	h	高さ
+		*/
+		//-----------------------------------------------------------------//
+		void mark_area(int16_t x, int16_t y, int16_t w, int16_t h)
+		{
+			if(x < 0) { w += x; x = 0; }
+			if(y < 0) { h += y; y = 0; }
+			if((x + w) > W) w = W - x;
+			if((y + h) > (PAGES * 8)) h = PAGES * 8 - y;
+			if(w <= 0 || h <= 0) return;
+			for(int16_t page = y >> 3; page <= ((y + h - 1) >> 3); ++page) {
+				mark(page, x, x + w);
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	他の更新範囲を合成 @n
+					一つのフレームバッファを、複数の転送先で使い回す場合に使う
+			@param[in]	src	合成する更新範囲
+		*/
+		//-----------------------------------------------------------------//
+		void merge(const dirty_page& src)
+		{
+			for(uint8_t i = 0; i < PAGES; ++i) {
+				if(src.org_[i] < src.end_[i]) mark(i, src.org_[i], src.end_[i]);
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ページの更新範囲を取得
+			@param[in]	page	ページ
+			@param[out]	org		開始カラム
+			@param[out]	end		終了カラム（含まない）
+			@return 更新が無い場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool get(uint8_t page, uint8_t& org, uint8_t& end) const
+		{
+			org = org_[page];
+			end = end_[page];
+			return org < end;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	更新の有無
+			@return 更新があれば「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool any() const
+		{
+			for(uint8_t i = 0; i < PAGES; ++i) {
+				if(org_[i] < end_[i]) return true;
+			}
+			return false;
+		}
+	};
+}
@@ -29,6 +29,19 @@ namespace utils {
 
 		DT	buff_[SIZE];
 
+		static PTS next_(PTS n) {
+			++n;
+			if(SIZE == 8 || SIZE == 16 || SIZE == 32 || SIZE == 64 || SIZE == 128) {
+				n &= SIZE - 1;
+			} else if(SIZE == 256) {
+			} else {
+				if(n >= SIZE) {
+					n = 0;
+				}
+			}
+			return n;
+		}
+
 	public:
         //-----------------------------------------------------------------//
         /*!
@@ -46,15 +59,25 @@ namespace utils {
         //-----------------------------------------------------------------//
 		void put(DT v) {
 			buff_[put_] = v;
-			++put_;
-			if(SIZE == 8 || SIZE == 16 || SIZE == 32 || SIZE == 64 || SIZE == 128) {
-				put_ &= SIZE - 1;
-			} else if(SIZE == 256) {
-			} else {
-				if(put_ >= SIZE) {
-					put_ = 0;
-				}
+			put_ = next_(put_);
+		}
+
+
+        //-----------------------------------------------------------------//
+        /*!
+            @brief  複数の値の格納（空きは呼ぶ側で確認する事）@n
+					put 位置は、全てを書いてから一度だけ更新する。
+			@param[in]	src	値の並び
+			@param[in]	num	数
+        */
+        //-----------------------------------------------------------------//
+		void put(const DT* src, PTS num) {
+			PTS p = put_;
+			for(PTS i = 0; i < num; ++i) {
+				buff_[p] = src[i];
+				p = next_(p);
 			}
+			put_ = p;
 		}
 
 
@@ -66,15 +89,7 @@ namespace utils {
         //-----------------------------------------------------------------//
 		DT get() {
 			DT data = buff_[get_];
-			++get_;
-			if(SIZE == 8 || SIZE == 16 || SIZE == 32 || SIZE == 64 || SIZE == 128) {
-				get_ &= SIZE - 1;
-			} else if(SIZE == 256) {
-			} else {
-				if(get_ >= SIZE) {
-					get_ = 0;
-				}
-			}
+			get_ = next_(get_);
 			return data;
 		}
 
@@ -0,0 +1,118 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	固定小数点テンプレート @n
+			※basic_arith、arith_code の VTYPE として利用出来る。@n
+			乗算、除算の中間値は WIDE 型で計算する。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <type_traits>
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	固定小数点クラス
+		@param[in]	T		基本型
+		@param[in]	FRAC	小数部のビット数
+		@param[in]	WIDE	乗除算の中間型
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <typename T, uint8_t FRAC, typename WIDE = int64_t>
+	class fixed_point {
+
+		T	raw_;
+
+		struct raw_tag { };
+		fixed_point(T raw, raw_tag) noexcept : raw_(raw) { }
+
+		// 負の値の左シフトは未定義なので、符号無しで行う
+		template <typename U>
+		static U shl_(U v, uint8_t n) noexcept {
+			typedef typename std::make_unsigned<U>::type UU;
+			return static_cast<U>(static_cast<UU>(v) << n);
+		}
+
+	public:
+		typedef T value_type;	///< 基本型
+
+		static const uint8_t frac_bits = FRAC;	///< 小数部のビット数
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+			@param[in]	v	整数値
+		*/
+		//-----------------------------------------------------------------//
+		fixed_point(int32_t v = 0) noexcept : raw_(shl_(static_cast<T>(v), FRAC)) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	生の値から作成
+			@param[in]	raw	固定小数点の生の値
+			@return 固定小数点
+		*/
+		//-----------------------------------------------------------------//
+		static fixed_point from_raw(T raw) noexcept { return fixed_point(raw, raw_tag()); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	生の値を取得
+			@return 生の値
+		*/
+		//-----------------------------------------------------------------//
+		T raw() const noexcept { return raw_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	整数部を取得（－∞方向に丸め）
+			@return 整数部
+		*/
+		//-----------------------------------------------------------------//
+		int32_t to_int() const noexcept { return static_cast<int32_t>(raw_ >> FRAC); }
+
+
+		fixed_point operator - () const noexcept { return from_raw(-raw_); }
+
+		fixed_point& operator += (const fixed_point& t) noexcept { raw_ += t.raw_; return *this; }
+		fixed_point& operator -= (const fixed_point& t) noexcept { raw_ -= t.raw_; return *this; }
+		fixed_point& operator &= (const fixed_point& t) noexcept { raw_ &= t.raw_; return *this; }
+		fixed_point& operator ^= (const fixed_point& t) noexcept { raw_ ^= t.raw_; return *this; }
+		fixed_point& operator |= (const fixed_point& t) noexcept { raw_ |= t.raw_; return *this; }
+
+		fixed_point& operator *= (const fixed_point& t) noexcept {
+			raw_ = static_cast<T>((static_cast<WIDE>(raw_) * static_cast<WIDE>(t.raw_)) >> FRAC);
+			return *this;
+		}
+
+		fixed_point& operator /= (const fixed_point& t) noexcept {
+			raw_ = static_cast<T>(shl_(static_cast<WIDE>(raw_), FRAC) / static_cast<WIDE>(t.raw_));
+			return *this;
+		}
+
+		fixed_point& operator %= (const fixed_point& t) noexcept { raw_ %= t.raw_; return *this; }
+
+		/// シフトは、右辺の整数部をビット数とする
+		fixed_point& operator <<= (const fixed_point& t) noexcept { raw_ = shl_(raw_, t.to_int()); return *this; }
+		fixed_point& operator >>= (const fixed_point& t) noexcept { raw_ >>= t.to_int(); return *this; }
+
+		fixed_point operator + (const fixed_point& t) const noexcept { fixed_point a(*this); a += t; return a; }
+		fixed_point operator - (const fixed_point& t) const noexcept { fixed_point a(*this); a -= t; return a; }
+		fixed_point operator * (const fixed_point& t) const noexcept { fixed_point a(*this); a *= t; return a; }
+		fixed_point operator / (const fixed_point& t) const noexcept { fixed_point a(*this); a /= t; return a; }
+		fixed_point operator % (const fixed_point& t) const noexcept { fixed_point a(*this); a %= t; return a; }
+
+		bool operator == (const fixed_point& t) const noexcept { return raw_ == t.raw_; }
+		bool operator != (const fixed_point& t) const noexcept { return raw_ != t.raw_; }
+		bool operator <  (const fixed_point& t) const noexcept { return raw_ <  t.raw_; }
+		bool operator >  (const fixed_point& t) const noexcept { return raw_ >  t.raw_; }
+	};
+}
@@ -0,0 +1,352 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	データ・フラッシュ・キー／バリュー・ストア @n
+			二つのバンク（BANK0、BANK1）の片方を使い、値の書き換えは、@n
+			レコードの追記（バイト書き込み）で行い、バンクの消去はしない。@n
+			バンクが一杯になったら、有効なレコードだけを、もう片方のバンク @n
+			に写し（ガベージ・コレクション）、ヘッダーを書いて切り替える。@n
+			バンク・ヘッダー： @n
+			  gen（２バイト、世代）、gen の CRC-8、'K'、'V'（最後に書く）@n
+			バンクを消去する前に、'K'、'V' を 0x00 に書いて無効にするので、@n
+			消去の途中で電源が切れても、古いヘッダーが有効に見える事は無い。@n
+			レコード： @n
+			  key、len、data[len]、CRC-8、commit（0x00、最後に書く）@n
+			len が 0 のレコードは、削除を表す。@n
+			書き込み途中で電源が切れたレコード（commit が無い、CRC が合わない）@n
+			は無視して、次の書き込みで、ガベージ・コレクションを行う。@n
+			start() で、キー毎の最新レコードの位置を RAM に作るので、@n
+			読み出しは、ログを辿らない。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	データ・フラッシュ・キー／バリュー・ストア・クラス
+		@param[in]	FLASH	フラッシュ制御クラス（device::flash_io）
+		@param[in]	KEYS	キーの数（キーは 0 ～ KEYS - 1）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class FLASH, uint8_t KEYS = 16>
+	class flash_kv {
+
+		static_assert(KEYS < 255, "KEYS must be 254 or less");
+
+		static const uint16_t BANK_SIZE = 0x0400;
+		static const uint16_t HEAD_SIZE = 5;
+		static const uint16_t NONE = 0xffff;
+
+	public:
+		static const uint8_t MAX_LEN = 250;		///< 値の最大バイト数
+
+	private:
+		FLASH&		flash_;
+
+		uint16_t	index_[KEYS];	///< キー毎のレコード位置
+		uint8_t		bank_;
+		uint16_t	gen_;
+		uint16_t	tail_;			///< 追記位置
+		bool		torn_;			///< 途中で切れたレコードがある
+
+		static uint8_t crc8_(uint8_t crc, uint8_t v) {
+			crc ^= v;
+			for(uint8_t i = 0; i < 8; ++i) {
+				if(crc & 0x80) crc = (crc << 1) ^ 0x07;
+				else crc <<= 1;
+			}
+			return crc;
+		}
+
+		static uint16_t base_(uint8_t bank) { return bank == 0 ? 0x0000 : BANK_SIZE; }
+
+		static typename FLASH::DATA_AREA area_(uint8_t bank) {
+			return bank == 0 ? FLASH::DATA_AREA::BANK0 : FLASH::DATA_AREA::BANK1;
+		}
+
+		bool head_(uint8_t bank, uint16_t& gen) const {
+			uint8_t tmp[HEAD_SIZE];
+			flash_.read(base_(bank), HEAD_SIZE, tmp);
+			if(tmp[3] != 'K' || tmp[4] != 'V') return false;
+			if(crc8_(crc8_(0, tmp[0]), tmp[1]) != tmp[2]) return false;
+			gen = tmp[0] | (static_cast<uint16_t>(tmp[1]) << 8);
+			return true;
+		}
+
+		// ヘッダーを書く（'V' を最後に書く）
+		bool write_head_(uint8_t bank, uint16_t gen) const {
+			uint8_t tmp[HEAD_SIZE];
+			tmp[0] = gen & 0xff;
+			tmp[1] = gen >> 8;
+			tmp[2] = crc8_(crc8_(0, tmp[0]), tmp[1]);
+			tmp[3] = 'K';
+			tmp[4] = 'V';
+			return flash_.write(tmp, base_(bank), HEAD_SIZE);
+		}
+
+		// 'K'、'V' を 0x00 にしてから消去する
+		bool erase_(uint8_t bank) const {
+			static const uint8_t zero[2] = { 0x00, 0x00 };
+			if(!flash_.write(zero, base_(bank) + 3, 2)) return false;
+			return flash_.erase(area_(bank));
+		}
+
+		// バンクを辿り、キー毎の最新レコードと、追記位置を求める
+		void scan_(uint8_t bank) {
+			for(uint8_t i = 0; i < KEYS; ++i) index_[i] = NONE;
+			bank_ = bank;
+			torn_ = false;
+			uint16_t end = base_(bank) + BANK_SIZE;
+			uint16_t pos = base_(bank) + HEAD_SIZE;
+			while((pos + 2) <= end) {
+				uint8_t key = flash_.read(pos);
+				if(key == 0xff) break;
+				uint8_t len = flash_.read(pos + 1);
+				if(len > MAX_LEN || (pos + 4 + len) > end) {
+					torn_ = true;
+					break;
+				}
+				uint8_t crc = crc8_(crc8_(0, key), len);
+				for(uint8_t i = 0; i < len; ++i) {
+					crc = crc8_(crc, flash_.read(pos + 2 + i));
+				}
+				if(crc != flash_.read(pos + 2 + len) || flash_.read(pos + 3 + len) != 0x00) {
+					torn_ = true;
+					break;
+				}
+				if(key < KEYS) {
+					index_[key] = len != 0 ? pos : NONE;
+				}
+				pos += 4 + len;
+			}
+			tail_ = pos;
+		}
+
+		bool append_(uint16_t pos, uint8_t key, const uint8_t* src, uint8_t len) const {
+			uint8_t tmp[2];
+			tmp[0] = key;
+			tmp[1] = len;
+			if(!flash_.write(tmp, pos, 2)) return false;
+			uint8_t crc = crc8_(crc8_(0, key), len);
+			for(uint8_t i = 0; i < len; ++i) crc = crc8_(crc, src[i]);
+			if(len > 0 && !flash_.write(src, pos + 2, len)) return false;
+			tmp[0] = crc;
+			tmp[1] = 0x00;  // commit
+			return flash_.write(tmp, pos + 2 + len, 2);
+		}
+
+		uint16_t size_(uint16_t pos) const { return 4 + flash_.read(pos + 1); }
+
+		// 有効なレコードを、もう片方のバンクへ写して、切り替える
+		bool collect_(uint8_t key, const uint8_t* src, uint8_t len) {
+			uint16_t need = HEAD_SIZE;
+			for(uint8_t i = 0; i < KEYS; ++i) {
+				if(i != key && index_[i] != NONE) need += size_(index_[i]);
+			}
+			if(len > 0) need += 4 + len;
+			if(need > BANK_SIZE) return false;
+
+			uint8_t next = bank_ ^ 1;
+			if(!erase_(next)) return false;
+			uint16_t pos = base_(next) + HEAD_SIZE;
+			for(uint8_t i = 0; i < KEYS; ++i) {
+				if(i == key || index_[i] == NONE) continue;
+				uint16_t ofs = index_[i];
+				uint16_t n = size_(ofs);
+				while(n > 0) {
+					uint8_t tmp[16];
+					uint8_t l = n > sizeof(tmp) ? sizeof(tmp) : n;
+					flash_.read(ofs, l, tmp);
+					if(!flash_.write(tmp, pos, l)) return false;
+					ofs += l;
+					pos += l;
+					n -= l;
+				}
+			}
+			if(len > 0) {
+				if(!append_(pos, key, src, len)) return false;
+			}
+
+			uint16_t gen = gen_ + 1;
+			if(!write_head_(next, gen)) return false;
+			gen_ = gen;
+			scan_(next);
+			return true;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+			@param[in]	flash	フラッシュ制御クラス
+		*/
+		//-----------------------------------------------------------------//
+		flash_kv(FLASH& flash) : flash_(flash), bank_(0), gen_(0), tail_(0), torn_(true) {
+			for(uint8_t i = 0; i < KEYS; ++i) index_[i] = NONE;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	開始（新しい方のバンクを辿り、索引を作る）@n
+					有効なバンクが無い場合は、初期化する。
+			@return エラーなら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool start()
+		{
+			uint16_t g0 = 0;
+			uint16_t g1 = 0;
+			bool v0 = head_(0, g0);
+			bool v1 = head_(1, g1);
+			if(!v0 && !v1) return format();
+
+			uint8_t bank;
+			if(v0 && v1) {
+				bank = static_cast<int16_t>(g1 - g0) > 0 ? 1 : 0;
+			} else {
+				bank = v0 ? 0 : 1;
+			}
+			gen_ = bank == 0 ? g0 : g1;
+			scan_(bank);
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	初期化（全てのキーを消す）
+			@return エラーなら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool format()
+		{
+			if(!erase_(1)) return false;
+			if(!erase_(0)) return false;
+			if(!write_head_(0, 1)) return false;
+			gen_ = 1;
+			scan_(0);
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	値のバイト数を取得
+			@param[in]	key	キー
+			@return バイト数（無い場合は 0）
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t length(uint8_t key) const {
+			if(key >= KEYS || index_[key] == NONE) return 0;
+			return flash_.read(index_[key] + 1);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	値を読み出す
+			@param[in]	key	キー
+			@param[out]	dst	先
+			@param[in]	len	先の大きさ
+			@return 値のバイト数（無い場合は 0）
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t read(uint8_t key, void* dst, uint8_t len) const
+		{
+			uint8_t n = length(key);
+			if(n == 0) return 0;
+			flash_.read(index_[key] + 2, n < len ? n : len, static_cast<uint8_t*>(dst));
+			return n;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	値を書き込む（同じ値なら、何もしない）
+			@param[in]	key	キー
+			@param[in]	src	値
+			@param[in]	len	バイト数（1 ～ MAX_LEN）
+			@return エラー、又は、空きが無い場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool write(uint8_t key, const void* src, uint8_t len)
+		{
+			if(key >= KEYS || len == 0 || len > MAX_LEN) return false;
+			const uint8_t* p = static_cast<const uint8_t*>(src);
+			if(length(key) == len) {
+				uint16_t ofs = index_[key] + 2;
+				uint8_t i = 0;
+				while(i < len && flash_.read(ofs + i) == p[i]) ++i;
+				if(i == len) return true;
+			}
+			return put_(key, p, len);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	キーを消す
+			@param[in]	key	キー
+			@return エラーなら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool erase(uint8_t key)
+		{
+			if(key >= KEYS) return false;
+			if(index_[key] == NONE) return true;
+			return put_(key, nullptr, 0);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	追記出来る残りバイト数を取得
+			@return 残りバイト数
+		*/
+		//-----------------------------------------------------------------//
+		uint16_t get_free() const {
+			if(torn_) return 0;
+			return base_(bank_) + BANK_SIZE - tail_;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	使用中のバンクを取得
+			@return バンク（0、1）
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t get_bank() const { return bank_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	世代（ガベージ・コレクションの度に増える）を取得
+			@return 世代
+		*/
+		//-----------------------------------------------------------------//
+		uint16_t get_gen() const { return gen_; }
+
+	private:
+		bool put_(uint8_t key, const uint8_t* src, uint8_t len) {
+			if(torn_ || (tail_ + 4 + len) > (base_(bank_) + BANK_SIZE)) {
+				return collect_(key, src, len);
+			}
+			uint16_t pos = tail_;
+			tail_ += 4 + len;  // 失敗しても、書いた所は使わない
+			if(!append_(pos, key, src, len)) {
+				torn_ = true;
+				return false;
+			}
+			index_[key] = len != 0 ? pos : NONE;
+			return true;
+		}
+	};
+}
@@ -84,4 +84,32 @@ namespace graphics {
 			return 0;
 		}
 	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	ページ構成付きフォント・クラス @n
+				font6x12 に、LCD と同じページ構成のテーブルを加えたもの。@n
+				page_fb の様に blit_bytes を持つ PLOT では、monograph は @n
+				このテーブルから、バイト単位で書き込む。@n
+				テーブル（font6x12_page.cpp）は afont_page で作成する。
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class font6x12_page : public font6x12 {
+		static const uint8_t page_[];
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ページ構成の文字を取得 @n
+					カラム毎に２バイト（下位ビットが上）
+			@param[in]	code	文字コード
+			@return ページ構成の文字
+		*/
+		//-----------------------------------------------------------------//
+		static const uint8_t* get_page(uint8_t code)
+		{
+			return &page_[static_cast<uint16_t>(code) * (WIDTH * ((HEIGHT + 7) / 8))];
+		}
+	};
 }
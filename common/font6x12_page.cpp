@@ -0,0 +1,146 @@
+//=====================================================================//
+/*!	@file
+	@brief	６×１２フォント（ページ構成） @n
+			afont_page で、font6x12.cpp から作成したテーブル（編集しない事）@n
+			文字毎に、カラム（6）×ページ（2）バイト、下位ビットが上
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include "common/font6x12.hpp"
+
+namespace graphics {
+
+	const uint8_t font6x12_page::page_[] = {
+0xFF,0x0F,0x01,0x08,0x01,0x08,0x01,0x08,0x01,0x08,0xFF,0x0F,
+0x55,0x05,0xAA,0x0A,0x55,0x05,0xAA,0x0A,0x55,0x05,0xAA,0x0A,
+0xFF,0x0F,0x01,0x08,0xFD,0x0B,0xFD,0x0B,0x01,0x08,0xFF,0x0F,
+0xFF,0x0F,0xAB,0x0A,0x55,0x0D,0xAB,0x0A,0x55,0x0D,0xFF,0x0F,
+0xFF,0x0F,0xFE,0x07,0xFC,0x03,0xF8,0x01,0xF0,0x00,0x60,0x00,
+0xFE,0x03,0xFC,0x01,0xF8,0x00,0x70,0x00,0x20,0x00,0x00,0x00,
+0x70,0x00,0x70,0x00,0x70,0x00,0x70,0x00,0x70,0x00,0x00,0x00,
+0x06,0x03,0x8C,0x01,0xD8,0x00,0x70,0x00,0x20,0x00,0x00,0x00,
+0xFF,0x0F,0x01,0x00,0xFD,0x0F,0x05,0x00,0x05,0x00,0x05,0x00,
+0x05,0x00,0x05,0x00,0x05,0x00,0x05,0x00,0x05,0x00,0x05,0x00,
+0x05,0x00,0x05,0x00,0x05,0x00,0xFD,0x0F,0x01,0x00,0xFF,0x0F,
+0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0x0F,0x00,0x00,0xFF,0x0F,
+0x00,0x0A,0x00,0x0A,0x00,0x0A,0xFF,0x0B,0x00,0x08,0xFF,0x0F,
+0x00,0x0A,0x00,0x0A,0x00,0x0A,0x00,0x0A,0x00,0x0A,0x00,0x0A,
+0xFF,0x0F,0x00,0x08,0xFF,0x0B,0x00,0x0A,0x00,0x0A,0x00,0x0A,
+0xFF,0x0F,0x00,0x00,0xFF,0x0F,0x00,0x00,0x00,0x00,0x00,0x00,
+0x08,0x00,0x04,0x00,0xFE,0x07,0xFE,0x07,0x04,0x00,0x08,0x00,
+0x00,0x01,0x00,0x02,0xFE,0x07,0xFE,0x07,0x00,0x02,0x00,0x01,
+0xFF,0x0F,0x01,0x08,0x01,0x08,0x01,0x08,0x01,0x08,0x01,0x08,
+0x01,0x08,0x01,0x08,0x01,0x08,0x01,0x08,0x01,0x08,0xFF,0x0F,
+0x60,0x00,0xF0,0x00,0xF8,0x01,0xFC,0x03,0xFE,0x07,0xFF,0x0F,
+0x20,0x00,0x70,0x00,0xF8,0x00,0xFC,0x01,0xFE,0x03,0x00,0x00,
+0x00,0x00,0x00,0x00,0xFF,0x07,0xFF,0x07,0xFF,0x07,0x00,0x00,
+0x20,0x00,0x70,0x00,0xD8,0x00,0x8C,0x01,0x06,0x03,0x00,0x00,
+0xFC,0x0F,0xFE,0x0F,0x07,0x00,0x03,0x00,0x03,0x00,0x03,0x00,
+0x03,0x00,0x03,0x00,0x03,0x00,0x03,0x00,0x03,0x00,0x03,0x00,
+0x03,0x00,0x03,0x00,0x03,0x00,0x07,0x00,0xFE,0x0F,0xFC,0x0F,
+0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0x0F,0xFF,0x0F,
+0x00,0x0C,0x00,0x0C,0x00,0x0C,0x00,0x0E,0xFF,0x07,0xFF,0x03,
+0x00,0x0C,0x00,0x0C,0x00,0x0C,0x00,0x0C,0x00,0x0C,0x00,0x0C,
+0xFF,0x03,0xFF,0x07,0x00,0x0E,0x00,0x0C,0x00,0x0C,0x00,0x0C,
+0xFF,0x0F,0xFF,0x0F,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+0x00,0x00,0x00,0x00,0x3F,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
+0x04,0x00,0x03,0x00,0x04,0x00,0x03,0x00,0x00,0x00,0x00,0x00,
+0x04,0x01,0xFF,0x07,0x04,0x01,0xFF,0x07,0x04,0x01,0x00,0x00,
+0x8C,0x01,0x12,0x02,0xFF,0x07,0x22,0x02,0xCC,0x01,0x00,0x00,
+0x06,0x03,0xC9,0x00,0xB6,0x01,0x4C,0x02,0x83,0x01,0x00,0x00,
+0xE6,0x01,0x19,0x02,0x66,0x02,0x80,0x01,0x60,0x02,0x00,0x00,
+0x00,0x00,0x05,0x00,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+0x00,0x00,0xF8,0x00,0x06,0x03,0x01,0x04,0x00,0x00,0x00,0x00,
+0x00,0x00,0x01,0x04,0x06,0x03,0xF8,0x00,0x00,0x00,0x00,0x00,
+0xD8,0x00,0x20,0x00,0xFC,0x01,0x20,0x00,0xD8,0x00,0x00,0x00,
+0x20,0x00,0x20,0x00,0xFC,0x01,0x20,0x00,0x20,0x00,0x00,0x00,
+0x00,0x00,0x00,0x05,0x00,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
+0x20,0x00,0x20,0x00,0x20,0x00,0x20,0x00,0x00,0x00,0x00,0x00,
+0x00,0x00,0x00,0x03,0x00,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
+0x00,0x06,0x80,0x01,0x70,0x00,0x0C,0x00,0x03,0x00,0x00,0x00,
+0xFC,0x01,0x02,0x02,0x02,0x02,0xFC,0x01,0x00,0x00,0x00,0x00,
+0x00,0x00,0x04,0x00,0xFE,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
+0x0C,0x03,0xC2,0x02,0x22,0x02,0x1C,0x02,0x00,0x00,0x00,0x00,
+0x8C,0x01,0x22,0x02,0x22,0x02,0xDC,0x01,0x00,0x00,0x00,0x00,
+0xC0,0x00,0xB0,0x00,0x8C,0x00,0xFE,0x03,0x80,0x00,0x00,0x00,
+0xBE,0x01,0x12,0x02,0x12,0x02,0xE2,0x01,0x00,0x00,0x00,0x00,
+0xFC,0x01,0x22,0x02,0x22,0x02,0xCC,0x01,0x00,0x00,0x00,0x00,
+0x02,0x00,0x82,0x03,0x72,0x00,0x0E,0x00,0x00,0x00,0x00,0x00,
+0xDC,0x01,0x22,0x02,0x22,0x02,0xDC,0x01,0x00,0x00,0x00,0x00,
+0x9C,0x01,0x22,0x02,0x22,0x02,0xFC,0x01,0x00,0x00,0x00,0x00,
+0x00,0x00,0x18,0x03,0x18,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
+0x00,0x00,0x18,0x05,0x18,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
+0x20,0x00,0x50,0x00,0x88,0x00,0x04,0x01,0x02,0x02,0x00,0x00,
+0x48,0x00,0x48,0x00,0x48,0x00,0x48,0x00,0x00,0x00,0x00,0x00,
+0x02,0x02,0x04,0x01,0x88,0x00,0x50,0x00,0x20,0x00,0x00,0x00,
+0x0C,0x00,0x02,0x00,0x62,0x03,0x1C,0x00,0x00,0x00,0x00,0x00,
+0xFC,0x01,0x4A,0x02,0x7A,0x02,0x82,0x02,0x7C,0x01,0x00,0x00,
+0xC0,0x03,0xB8,0x00,0x86,0x00,0xB8,0x00,0xC0,0x03,0x00,0x00,
+0xFE,0x03,0x22,0x02,0x22,0x02,0x22,0x02,0xDC,0x01,0x00,0x00,
+0xFC,0x01,0x02,0x02,0x02,0x02,0x02,0x02,0x8C,0x01,0x00,0x00,
+0xFE,0x03,0x02,0x02,0x02,0x02,0x04,0x01,0xF8,0x00,0x00,0x00,
+0xFE,0x03,0x22,0x02,0x22,0x02,0x22,0x02,0x02,0x02,0x00,0x00,
+0xFE,0x03,0x22,0x00,0x22,0x00,0x22,0x00,0x02,0x00,0x00,0x00,
+0xFC,0x01,0x02,0x02,0x02,0x02,0x42,0x01,0xCC,0x03,0x00,0x00,
+0xFE,0x03,0x20,0x00,0x20,0x00,0x20,0x00,0xFE,0x03,0x00,0x00,
+0x00,0x00,0x02,0x02,0xFE,0x03,0x02,0x02,0x00,0x00,0x00,0x00,
+0x80,0x01,0x00,0x02,0x00,0x02,0xFE,0x01,0x00,0x00,0x00,0x00,
+0xFE,0x03,0x20,0x00,0xD8,0x00,0x06,0x03,0x00,0x00,0x00,0x00,
+0xFE,0x03,0x00,0x02,0x00,0x02,0x00,0x02,0x00,0x02,0x00,0x00,
+0xFE,0x03,0x38,0x00,0xC0,0x03,0x38,0x00,0xFE,0x03,0x00,0x00,
+0xFE,0x03,0x0C,0x00,0x70,0x00,0x80,0x01,0xFE,0x03,0x00,0x00,
+0xFC,0x01,0x02,0x02,0x02,0x02,0x02,0x02,0xFC,0x01,0x00,0x00,
+0xFE,0x03,0x22,0x00,0x22,0x00,0x22,0x00,0x1C,0x00,0x00,0x00,
+0xFC,0x01,0x02,0x02,0x82,0x02,0x02,0x01,0xFC,0x02,0x00,0x00,
+0xFE,0x03,0x22,0x00,0x22,0x00,0x62,0x00,0x9C,0x03,0x00,0x00,
+0x8C,0x01,0x12,0x02,0x22,0x02,0x42,0x02,0x8C,0x01,0x00,0x00,
+0x02,0x00,0x02,0x00,0xFE,0x03,0x02,0x00,0x02,0x00,0x00,0x00,
+0xFE,0x01,0x00,0x02,0x00,0x02,0x00,0x02,0xFE,0x01,0x00,0x00,
+0x0E,0x00,0x70,0x00,0x80,0x03,0x70,0x00,0x0E,0x00,0x00,0x00,
+0x3E,0x00,0xC0,0x03,0x3E,0x00,0xC0,0x03,0x3E,0x00,0x00,0x00,
+0x06,0x03,0xD8,0x00,0x20,0x00,0xD8,0x00,0x06,0x03,0x00,0x00,
+0x06,0x00,0x18,0x00,0xE0,0x03,0x18,0x00,0x06,0x00,0x00,0x00,
+0x02,0x03,0xC2,0x02,0x22,0x02,0x1A,0x02,0x06,0x02,0x00,0x00,
+0x00,0x00,0x00,0x00,0xFF,0x07,0x01,0x04,0x01,0x04,0x00,0x00,
+0xA6,0x00,0xB8,0x00,0xE0,0x03,0xB8,0x00,0xA6,0x00,0x00,0x00,
+0x01,0x04,0x01,0x04,0xFF,0x07,0x00,0x00,0x00,0x00,0x00,0x00,
+0x00,0x00,0x02,0x00,0x01,0x00,0x02,0x00,0x00,0x00,0x00,0x00,
+0x00,0x08,0x00,0x08,0x00,0x08,0x00,0x08,0x00,0x08,0x00,0x08,
+0x00,0x00,0x01,0x00,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+0xA0,0x01,0x50,0x02,0x50,0x02,0xE0,0x01,0x00,0x02,0x00,0x00,
+0xFE,0x03,0x10,0x02,0x10,0x02,0x10,0x02,0xE0,0x01,0x00,0x00,
+0xE0,0x01,0x10,0x02,0x10,0x02,0x10,0x02,0x20,0x01,0x00,0x00,
+0xE0,0x01,0x10,0x02,0x10,0x02,0x10,0x02,0xFE,0x03,0x00,0x00,
+0xE0,0x01,0x50,0x02,0x50,0x02,0x50,0x02,0x60,0x01,0x00,0x00,
+0x10,0x00,0xFC,0x03,0x12,0x00,0x02,0x00,0x00,0x00,0x00,0x00,
+0xA0,0x02,0x50,0x05,0x50,0x05,0x20,0x05,0x10,0x02,0x00,0x00,
+0xFE,0x03,0x10,0x00,0x10,0x00,0x10,0x00,0xE0,0x03,0x00,0x00,
+0x00,0x00,0x00,0x00,0xF6,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
+0x00,0x04,0x00,0x04,0xF6,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
+0xFE,0x03,0x80,0x00,0xC0,0x00,0x20,0x01,0x10,0x02,0x00,0x00,
+0x00,0x00,0x00,0x00,0xFE,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
+0xF0,0x03,0x10,0x00,0xE0,0x03,0x10,0x00,0xE0,0x03,0x00,0x00,
+0xF0,0x03,0x10,0x00,0x10,0x00,0x10,0x00,0xE0,0x03,0x00,0x00,
+0xE0,0x01,0x10,0x02,0x10,0x02,0x10,0x02,0xE0,0x01,0x00,0x00,
+0xF0,0x07,0x10,0x01,0x10,0x01,0x10,0x01,0xE0,0x00,0x00,0x00,
+0xE0,0x00,0x10,0x01,0x10,0x01,0x10,0x01,0xF0,0x07,0x00,0x00,
+0x00,0x00,0xF0,0x03,0x20,0x00,0x10,0x00,0x10,0x00,0x00,0x00,
+0x20,0x01,0x50,0x02,0x50,0x02,0x90,0x02,0x20,0x01,0x00,0x00,
+0x10,0x00,0xFE,0x01,0x10,0x02,0x00,0x02,0x00,0x00,0x00,0x00,
+0xF0,0x01,0x00,0x02,0x00,0x02,0x00,0x02,0xF0,0x03,0x00,0x00,
+0x30,0x00,0xC0,0x00,0x00,0x03,0xC0,0x00,0x30,0x00,0x00,0x00,
+0x70,0x00,0x80,0x03,0x70,0x00,0x80,0x03,0x70,0x00,0x00,0x00,
+0x10,0x02,0x20,0x01,0xC0,0x00,0x20,0x01,0x10,0x02,0x00,0x00,
+0x30,0x04,0xC0,0x04,0x00,0x03,0xC0,0x00,0x30,0x00,0x00,0x00,
+0x10,0x02,0x10,0x03,0x90,0x02,0x50,0x02,0x30,0x02,0x00,0x00,
+0x00,0x00,0x20,0x00,0xDF,0x07,0x01,0x04,0x00,0x00,0x00,0x00,
+0x00,0x00,0x00,0x00,0xFF,0x0F,0x00,0x00,0x00,0x00,0x00,0x00,
+0x00,0x00,0x01,0x04,0xDF,0x07,0x20,0x00,0x00,0x00,0x00,0x00,
+0x02,0x00,0x01,0x00,0x01,0x00,0x02,0x00,0x01,0x00,0x00,0x00,
+0xFF,0x0F,0xFF,0x0F,0xFF,0x0F,0xFF,0x0F,0xFF,0x0F,0xFF,0x0F,
+	};
+}
@@ -1,7 +1,10 @@
 #pragma once
 //=====================================================================//
 /*!	@file
-	@brief	IICA(I2C) テンプレートクラス (20MHz system clock) 
+	@brief	IICA(I2C) テンプレートクラス (20MHz system clock) @n
+			ビット単位のループは、標準／高速の待ち時間を定数で展開する。@n
+			レジスタ読み出し（write_then_read）と、複数転送（transfer）は、@n
+			リピーテッド・スタートで、一回のバス・セッションで行う。
     @author 平松邦仁 (hira@rvf-rc45.net)
 	@copyright	Copyright (C) 2015, 2017 Kunihito Hiramatsu @n
 				Released under the MIT license @n
@@ -50,6 +53,21 @@ namespace device {
 			stop,		///< ストップ・コンディション
 		};
 
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  転送要素（transfer で使う）@n
+					同じアドレスへの、同じ方向の要素は、続けて転送する。@n
+					（送信は、レジスタ番号とデータを別のバッファから送れる）
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct transfer_t {
+			uint8_t			address;	///< スレーブアドレス（７ビット）
+			const uint8_t*	src;		///< 送信元（受信の場合 nullptr）
+			uint8_t*		dst;		///< 受信先（送信の場合 nullptr）
+			uint8_t			num;		///< 数
+		};
+
 	private:
 		uint8_t		clock_;
 		error		error_;
@@ -73,9 +91,9 @@ namespace device {
 			SDA::DIR = 0;
 			utils::delay::micro_second(clock_);
 			bool f = SDA::P();
+			SCL::P = 0;  // SCL を先に下げる（NACK の時、スタート・コンディションにしない）
 			SDA::P = 0;
 			SDA::DIR = 1;
-			SCL::P = 0;
 			return f;
 		}
 
@@ -107,62 +125,79 @@ namespace device {
 
 
 		void stop_() const {
+			SDA::P = 0;  // NACK の後は SDA が「H」なので、一度下げる
 			utils::delay::micro_second(clock_);
 			SCL::P = 1;
+			wait_();
 			utils::delay::micro_second(clock_);
 			SDA::P = 1;
 		}
 
 
-		bool write_(uint8_t val, bool sync) const {
+		void restart_() const {
+			SDA::P = 1;
+			utils::delay::micro_second(clock_);
+			SCL::P = 1;
+			wait_();
+			utils::delay::micro_second(clock_);
+			start_();
+		}
+
+
+		// CLK が 0 以外なら、定数の待ち時間
+		template <uint8_t CLK>
+		void delay_() const {
+			if(CLK != 0) utils::delay::micro_second(CLK);
+			else utils::delay::micro_second(clock_);
+		}
+
+
+		template <uint8_t CLK>
+		bool write_bits_(uint8_t val, bool sync) const {
 			for(uint8_t n = 0; n < 8; ++n) {
 				SDA::P = (val & 0x80) != 0 ? 1 : 0;
-				utils::delay::micro_second(clock_);
+				delay_<CLK>();
 				SCL::P = 1;
 				if(n == 0 && sync) {
 					if(!wait_()) return false;
 				}
 				val <<= 1;
-				utils::delay::micro_second(clock_);
+				delay_<CLK>();
 				SCL::P = 0;
 			}
 			return true;
 		}
 
 
+		bool write_(uint8_t val, bool sync) const {
+			if(clock_ == fast_clock_) return write_bits_<fast_clock_>(val, sync);
+			else if(clock_ == slow_clock_) return write_bits_<slow_clock_>(val, sync);
+			else return write_bits_<0>(val, sync);
+		}
+
+
+		// 失敗しても、ストップ・コンディションは呼び出し側で出す
 		bool write_(uint8_t data) const {
-			if(!write_(data, true)) {
-				stop_();
-				return false;
-			}
-			if(ack_()) {
-				stop_();
-				return false;
-			}
-			return true;
+			if(!write_(data, true)) return false;
+			return !ack_();
 		}
 
 
 		bool write_(const uint8_t* src, uint8_t num) const {
 			for(uint8_t n = 0; n < num; ++n) {
-				if(!write_(*src, true)) {
-					stop_();
-					return false;
-				}
+				if(!write_(*src, true)) return false;
 				++src;
-				if(ack_()) {
-					stop_();
-					return false;
-				}
+				if(ack_()) return false;
 			}
 			return true;
 		}
 
 
-		bool read_(uint8_t& val, bool sync) const {
+		template <uint8_t CLK>
+		bool read_bits_(uint8_t& val, bool sync) const {
 			SDA::DIR = 0;
 			for(uint8_t n = 0; n < 8; ++n) {
-				utils::delay::micro_second(clock_);
+				delay_<CLK>();
 				val <<= 1;
 				SCL::P = 1;
 				if(n == 0 && sync) {
@@ -171,7 +206,7 @@ namespace device {
 						return false;
 					}
 				}
-				utils::delay::micro_second(clock_);
+				delay_<CLK>();
 				if(SDA::P()) val |= 1;
 				SCL::P = 0;
 			}
@@ -179,6 +214,41 @@ namespace device {
 			return true;
 		}
 
+
+		bool read_(uint8_t& val, bool sync) const {
+			if(clock_ == fast_clock_) return read_bits_<fast_clock_>(val, sync);
+			else if(clock_ == slow_clock_) return read_bits_<slow_clock_>(val, sync);
+			else return read_bits_<0>(val, sync);
+		}
+
+
+		bool address_(uint8_t address, bool read) {
+			write_((address << 1) | (read ? 1 : 0), false);
+			if(ack_()) {
+				stop_();
+				error_ = error::address;
+				return false;
+			}
+			return true;
+		}
+
+
+		// last が「true」なら、最後のバイトに NACK を返す
+		bool recv_data_(uint8_t* dst, uint8_t num, bool last) {
+			for(uint8_t n = 0; n < num; ++n) {
+				if(!read_(*dst, true)) {
+					stop_();
+					error_ = error::recv_data;
+					return false;
+				}
+				bool f = 0;
+				if(last && n == (num - 1)) f = 1;
+				out_ack_(f);
+				++dst;
+			}
+			return true;
+		}
+
 	public:
 		//-----------------------------------------------------------------//
 		/*!
@@ -269,24 +339,9 @@ namespace device {
 		//-----------------------------------------------------------------//
 		bool recv(uint8_t address, uint8_t* dst, uint8_t num) {
 			start_();
-			write_((address << 1) | 1, false);
-			if(ack_()) {
-				stop_();
-				error_ = error::address;
-				return false;
-			}
+			if(!address_(address, true)) return false;
 
-			for(uint8_t n = 0; n < num; ++n) {
-				if(!read_(*dst, true)) {
-					stop_();
-					error_ = error::recv_data;
-					return false;
-				}
-				bool f = 0;
-				if(n == (num - 1)) f = 1;
-				out_ack_(f);
-				++dst;
-			}
+			if(!recv_data_(dst, num, true)) return false;
 			stop_();
 			return true;
 		}
@@ -393,5 +448,90 @@ namespace device {
 			stop_();
 			return true;
 		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  レジスタ番号を送り、リピーテッド・スタートで受信
+			@param[in] address スレーブアドレス（７ビット）
+			@param[in]	reg	レジスタ番号
+			@param[out]	dst	先
+			@param[in]	num	数
+			@return 失敗なら「false」が返る
+		*/
+		//-----------------------------------------------------------------//
+		bool write_then_read(uint8_t address, uint8_t reg, uint8_t* dst, uint8_t num) {
+			return write_then_read(address, &reg, 1, dst, num);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  レジスタ番号（複数バイト）を送り、リピーテッド・スタートで受信
+			@param[in] address スレーブアドレス（７ビット）
+			@param[in]	reg	レジスタ番号
+			@param[in]	rnum	レジスタ番号のバイト数
+			@param[out]	dst	先
+			@param[in]	num	数
+			@return 失敗なら「false」が返る
+		*/
+		//-----------------------------------------------------------------//
+		bool write_then_read(uint8_t address, const uint8_t* reg, uint8_t rnum, uint8_t* dst, uint8_t num) {
+			start_();
+			if(!address_(address, false)) return false;
+
+			if(!write_(reg, rnum)) {
+				stop_();
+				error_ = error::send_data;
+				return false;
+			}
+
+			restart_();
+			if(!address_(address, true)) return false;
+
+			if(!recv_data_(dst, num, true)) return false;
+			stop_();
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  複数の転送を、一回のバス・セッションで行う @n
+					アドレスか方向が変わる所で、リピーテッド・スタートを入れる。
+			@param[in]	list	転送要素の並び
+			@param[in]	num	要素数
+			@return 失敗なら「false」が返る
+		*/
+		//-----------------------------------------------------------------//
+		bool transfer(const transfer_t* list, uint8_t num) {
+			for(uint8_t i = 0; i < num; ++i) {
+				const transfer_t& t = list[i];
+				bool rd = t.dst != nullptr;
+				if(i == 0) {
+					start_();
+					if(!address_(t.address, rd)) return false;
+				} else if(list[i - 1].address != t.address || (list[i - 1].dst != nullptr) != rd) {
+					restart_();
+					if(!address_(t.address, rd)) return false;
+				}
+
+				if(rd) {
+					bool last = true;  // 次も同じアドレスの受信なら、ACK で続ける
+					if((i + 1) < num && list[i + 1].address == t.address && list[i + 1].dst != nullptr) {
+						last = false;
+					}
+					if(!recv_data_(t.dst, t.num, last)) return false;
+				} else {
+					if(!write_(t.src, t.num)) {
+						stop_();
+						error_ = error::send_data;
+						return false;
+					}
+				}
+			}
+			stop_();
+			return true;
+		}
 	};
 }
@@ -0,0 +1,414 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	I2C 転送キュー（タイマー割り込み駆動） @n
+			iica_io と同じポートで、ビット操作を割り込み毎に一段ずつ進める。@n
+			レジスタ番号の送信と、リピーテッド・スタートでの受信を、一組の要求 @n
+			としてキューに積むので、メインループは、センサーの読み出しを待たずに、@n
+			表示や通信を続けられる。@n
+			service() 一回で、SCL の片側のエッジを一つ進める。@n
+			（SCL の周波数は、割り込み周波数の１／２になる） @n
+			使い方： @n
+			  1. start() でポートを初期化 @n
+			  2. put() で要求を積む（バッファは、完了まで保持する事）@n
+			  3. タイマー割り込み内で service() を呼ぶ @n
+			  4. 完了時に、割り込み内で task が呼ばれる @n
+			同じバスを、iica_io から直接使う場合は、sync() で、キューが @n
+			空になるのを待ってから使う。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+
+namespace device {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  I2C 転送キュー・クラス
+		@param[in]	SDA		SDA ポート定義クラス
+		@param[in]	SCL		SCL ポート定義クラス
+		@param[in]	QSIZE	キューの大きさ（QSIZE - 1 個まで積める）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class SDA, class SCL, uint8_t QSIZE = 4>
+	class iica_queue {
+	public:
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  I2C のエラー
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class error : uint8_t {
+			none,		///< エラー無し
+			address,	///< アドレス転送（NACK）
+			send_data,	///< 送信データ転送（NACK）
+			stall,		///< スレーブの「待ち」が長過ぎる
+		};
+
+		typedef void (*task_type)(void* ctx, error err);
+
+		//=================================================================//
+		/*!
+			@brief  転送要求 @n
+					送信と受信の両方がある場合、送信の後に、リピーテッド・@n
+					スタートで受信する。
+		*/
+		//=================================================================//
+		struct request_t {
+			uint8_t			address;	///< スレーブアドレス（７ビット）
+			const uint8_t*	src;		///< 送信元（レジスタ番号等）
+			uint8_t			snum;		///< 送信数（0 なら送信しない）
+			uint8_t*		dst;		///< 受信先
+			uint8_t			dnum;		///< 受信数（0 なら受信しない）
+			task_type		task;		///< 完了タスク（nullptr なら呼ばない）
+			void*			ctx;		///< 完了タスクへ渡す値
+		};
+
+	private:
+		enum class step : uint8_t {
+			idle,
+			start,		///< SDA を下げる（SCL は「H」）
+			start_scl,	///< SCL を下げ、最初のビットを出す
+			rise,		///< SCL を上げる
+			fall,		///< ビットを読み、SCL を下げ、次のビットを出す
+			restart,	///< SDA を上げる
+			restart_scl,///< SCL を上げる
+			stop,		///< SDA を下げる
+			stop_scl,	///< SCL を上げる
+			stop_sda,	///< SDA を上げて、完了
+		};
+
+		request_t	req_[QSIZE];
+
+		volatile uint8_t	get_;
+		volatile uint8_t	put_;
+
+		step		step_;
+		uint8_t		data_;
+		uint8_t		bit_;	///< 0 ～ 7：データ、8：ACK
+		uint8_t		pos_;
+		bool		read_;	///< 受信フェーズ
+		bool		addr_;	///< アドレスのバイト
+		error		error_;
+
+		uint16_t	busy_;
+		uint16_t	stall_;
+
+		volatile error	last_error_;
+
+		static uint8_t next_(uint8_t n) {
+			++n;
+			if(n >= QSIZE) n = 0;
+			return n;
+		}
+
+
+		void out_bit_() {
+			SDA::P = (data_ & 0x80) != 0 ? 1 : 0;
+		}
+
+
+		// アドレスのバイトを準備して、最初のビットを出す
+		void address_() {
+			const request_t& r = req_[get_];
+			data_ = (r.address << 1) | (read_ ? 1 : 0);
+			bit_ = 0;
+			addr_ = true;
+			SDA::DIR = 1;
+			out_bit_();
+		}
+
+
+		// ACK の後、SCL が「L」の状態で、次のバイトか、終了を決める
+		void next_byte_() {
+			const request_t& r = req_[get_];
+			bit_ = 0;
+			if(error_ != error::none) {
+				step_ = step::stop;
+				return;
+			}
+			if(!read_) {
+				if(pos_ < r.snum) {
+					data_ = r.src[pos_];
+					++pos_;
+					addr_ = false;
+					out_bit_();
+					return;
+				}
+				if(r.dnum > 0 && !addr_) {
+					read_ = true;
+					pos_ = 0;
+					step_ = step::restart;
+					return;
+				}
+			}
+			if(read_ && pos_ < r.dnum) {
+				addr_ = false;
+				SDA::P = 1;
+				SDA::DIR = 0;
+				return;
+			}
+			step_ = step::stop;
+		}
+
+
+		void finish_() {
+			const request_t& r = req_[get_];
+			last_error_ = error_;
+			step_ = step::idle;
+			if(r.task != nullptr) r.task(r.ctx, error_);
+			get_ = next_(get_);
+		}
+
+
+		// スレーブが SCL を「L」に保持しているか（クロック・ストレッチ）
+		bool stretch_() {
+			SCL::DIR = 0;
+			bool low = SCL::P() == 0;
+			SCL::DIR = 1;
+			if(!low) {
+				stall_ = 0;
+				return false;
+			}
+			++stall_;
+			if(stall_ > busy_) {
+				stall_ = 0;
+				error_ = error::stall;
+				if(step_ == step::stop_sda) return false;
+				SDA::DIR = 1;
+				SCL::P = 0;
+				step_ = step::stop;
+			}
+			return true;
+		}
+
+
+		void fall_() {
+			const request_t& r = req_[get_];
+			if(bit_ < 8) {
+				if(read_ && !addr_) {
+					data_ <<= 1;
+					if(SDA::P()) data_ |= 1;
+				}
+				SCL::P = 0;
+				++bit_;
+				if(bit_ < 8) {
+					if(!read_ || addr_) {
+						data_ <<= 1;
+						out_bit_();
+					}
+				} else if(read_ && !addr_) {  // 受信したバイトに ACK／NACK を返す
+					r.dst[pos_] = data_;
+					++pos_;
+					SDA::DIR = 1;
+					SDA::P = pos_ < r.dnum ? 0 : 1;
+				} else {  // スレーブの ACK を受ける
+					SDA::P = 1;
+					SDA::DIR = 0;
+				}
+				step_ = step::rise;
+			} else {
+				bool nack = false;
+				if(!read_ || addr_) nack = SDA::P();
+				SCL::P = 0;  // SCL が「L」になってから、SDA を戻す
+				SDA::P = 0;
+				SDA::DIR = 1;
+				if(nack) error_ = addr_ ? error::address : error::send_data;
+				step_ = step::rise;
+				next_byte_();
+			}
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		iica_queue() : req_{ }, get_(0), put_(0), step_(step::idle), data_(0), bit_(0),
+			pos_(0), read_(false), addr_(false), error_(error::none),
+			busy_(100), stall_(0), last_error_(error::none) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  初期化（ポートを設定する）
+		*/
+		//-----------------------------------------------------------------//
+		void start()
+		{
+			SCL::OD = 1;
+			SDA::OD = 1;
+			SCL::DIR = 1;
+			SDA::DIR = 1;
+			SCL::P = 1;
+			SDA::P = 1;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  スレーブデバイスの「待ち」時間の最大値を設定
+			@param[in]	busy	待ち時間（service の呼び出し回数）
+		*/
+		//-----------------------------------------------------------------//
+		void set_busy(uint16_t busy) { busy_ = busy; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	転送要求を積む
+			@param[in]	req	転送要求
+			@return キューが一杯なら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool put(const request_t& req)
+		{
+			uint8_t n = next_(put_);
+			if(n == get_) return false;
+			req_[put_] = req;
+			put_ = n;  // 要求を書き終えてから、割り込みに見せる
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	レジスタ読み出しの要求を積む
+			@param[in]	address	スレーブアドレス（７ビット）
+			@param[in]	reg		レジスタ番号（完了まで保持する事、nullptr なら受信のみ）
+			@param[out]	dst		受信先
+			@param[in]	num		受信数
+			@param[in]	task	完了タスク
+			@param[in]	ctx		完了タスクへ渡す値
+			@return キューが一杯なら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool put(uint8_t address, const uint8_t* reg, uint8_t* dst, uint8_t num,
+			task_type task = nullptr, void* ctx = nullptr)
+		{
+			request_t t;
+			t.address = address;
+			t.src = reg;
+			t.snum = reg != nullptr ? 1 : 0;
+			t.dst = dst;
+			t.dnum = num;
+			t.task = task;
+			t.ctx = ctx;
+			return put(t);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	未完了の要求数を取得
+			@return 要求数
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t length() const {
+			uint8_t g = get_;
+			uint8_t p = put_;
+			return p >= g ? (p - g) : (QSIZE + p - g);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	転送中か検査
+			@return 転送中なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool busy() const { return get_ != put_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	全ての要求の完了を待つ
+		*/
+		//-----------------------------------------------------------------//
+		void sync() const { while(get_ != put_) ; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	最後に完了した要求のエラーを取得
+			@return エラー・タイプ
+		 */
+		//-----------------------------------------------------------------//
+		error get_last_error() const { return last_error_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	サービス（タイマー割り込みから呼ぶ）
+		*/
+		//-----------------------------------------------------------------//
+		void service()
+		{
+			switch(step_) {
+			case step::idle:
+				if(get_ == put_) break;
+				error_ = error::none;
+				pos_ = 0;
+				read_ = req_[get_].snum == 0 && req_[get_].dnum > 0;
+				stall_ = 0;
+				step_ = step::start;
+				break;
+
+			case step::start:
+				if(stretch_()) break;
+				SDA::DIR = 1;
+				SDA::P = 0;
+				step_ = step::start_scl;
+				break;
+
+			case step::start_scl:
+				SCL::P = 0;
+				address_();
+				step_ = step::rise;
+				break;
+
+			case step::rise:
+				SCL::P = 1;
+				step_ = step::fall;
+				break;
+
+			case step::fall:
+				if(stretch_()) break;
+				fall_();
+				break;
+
+			case step::restart:
+				SDA::P = 1;
+				step_ = step::restart_scl;
+				break;
+
+			case step::restart_scl:
+				SCL::P = 1;
+				step_ = step::start;
+				break;
+
+			case step::stop:
+				SDA::DIR = 1;
+				SDA::P = 0;
+				step_ = step::stop_scl;
+				break;
+
+			case step::stop_scl:
+				SCL::P = 1;
+				step_ = step::stop_sda;
+				break;
+
+			case step::stop_sda:
+				if(stretch_()) break;
+				SDA::P = 1;
+				finish_();
+				break;
+			}
+		}
+	};
+}
@@ -0,0 +1,200 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	SD カード漢字フォント・クラス @n
+			SD カード上のフォント・ファイルから、必要なグリフだけを @n
+			disk_readp で部分読み出しして、LRU キャッシュに保持する。@n
+			monograph の KFONT として使う。@n
+			フォント・ファイルは、kfont_pack で作成する。 @n
+			フォーマット（リトルエンディアン）： @n
+			  0: "KFNT" @n
+			  4: 横幅、高さ（各１バイト） @n
+			  6: 先頭コード、終端コード（UTF-16、各２バイト） @n
+			 10: グリフ数（２バイト） @n
+			 12: グリフ・データ位置（４バイト） @n
+			 16: インデックス（（終端－先頭＋１）×２バイト、無い場合 0xffff） @n
+			 グリフは draw_image と同じ行単位のビット列（LSB から）。@n
+			※ファイルのクラスターは連続している必要がある（start で検査）。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include "pfatfs/src/diskio.h"
+#include "pfatfs/src/pff.h"
+
+namespace graphics {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	SD カード漢字フォント・クラス
+		@param[in]	W	横幅
+		@param[in]	H	高さ
+		@param[in]	N	キャッシュするグリフ数
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <int8_t W, int8_t H, uint8_t N = 4>
+	class kfont_sd {
+	public:
+		static const int8_t WIDTH = W;
+		static const int8_t HEIGHT = H;
+		static const uint16_t BYTES = (W * H + 7) / 8;	///< グリフのバイト数
+
+		static const uint16_t HEADER_SIZE = 16;			///< ヘッダーのバイト数
+
+	private:
+		static const uint16_t none_ = 0xffff;
+
+		DWORD		sector_;
+		uint16_t	first_;
+		uint16_t	last_;
+		uint32_t	data_;
+		uint16_t	miss_;
+
+		uint16_t	code_[N];
+		bool		exist_[N];
+		uint8_t		order_[N];	///< 先頭が最も新しい
+		uint8_t		cache_[N][BYTES];
+
+		static uint16_t get16_(const uint8_t* p) {
+			return static_cast<uint16_t>(p[0]) | (static_cast<uint16_t>(p[1]) << 8);
+		}
+
+		// セクター境界を跨ぐ場合は、分割して読む
+		bool read_(uint32_t ofs, uint8_t* dst, uint16_t len) {
+			while(len > 0) {
+				UINT o = ofs & 511;
+				UINT n = 512 - o;
+				if(n > len) n = len;
+				if(disk_readp(dst, sector_ + (ofs >> 9), o, n) != RES_OK) return false;
+				ofs += n;
+				dst += n;
+				len -= n;
+			}
+			return true;
+		}
+
+		void touch_(uint8_t pos) {
+			uint8_t idx = order_[pos];
+			while(pos > 0) {
+				order_[pos] = order_[pos - 1];
+				--pos;
+			}
+			order_[0] = idx;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		kfont_sd() : sector_(0), first_(1), last_(0), data_(0), miss_(0) { flush(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	開始 @n
+					ファイルを開いて、先頭セクターを求める。@n
+					以降は disk_readp で直接読むので、他のファイルを開いても良い。
+			@param[in]	fs		マウント済みのファイルシステム
+			@param[in]	path	フォント・ファイルのパス
+			@return 成功なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool start(FATFS& fs, const char* path)
+		{
+			first_ = 1;
+			last_ = 0;
+			flush();
+			if(pf_open(path) != FR_OK) return false;
+
+			// クラスターが連続しているか検査
+			uint32_t bcs = static_cast<uint32_t>(fs.csize) * 512;
+			CLUST top = fs.org_clust;
+			CLUST n = 1;
+			for(uint32_t ofs = bcs; ofs < fs.fsize; ofs += bcs) {
+				if(pf_lseek(ofs + 1) != FR_OK) return false;
+				if(fs.curr_clust != (top + n)) return false;
+				++n;
+			}
+			sector_ = static_cast<DWORD>(top - 2) * fs.csize + fs.database;
+
+			uint8_t tmp[HEADER_SIZE];
+			if(!read_(0, tmp, HEADER_SIZE)) return false;
+			if(tmp[0] != 'K' || tmp[1] != 'F' || tmp[2] != 'N' || tmp[3] != 'T') return false;
+			if(tmp[4] != W || tmp[5] != H) return false;
+			data_ = static_cast<uint32_t>(get16_(&tmp[12])) | (static_cast<uint32_t>(get16_(&tmp[14])) << 16);
+			first_ = get16_(&tmp[6]);
+			last_ = get16_(&tmp[8]);
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	キャッシュを破棄
+		*/
+		//-----------------------------------------------------------------//
+		void flush()
+		{
+			for(uint8_t i = 0; i < N; ++i) {
+				code_[i] = 0;
+				exist_[i] = false;
+				order_[i] = i;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	キャッシュ・ミスの回数を取得
+			@return キャッシュ・ミスの回数
+		*/
+		//-----------------------------------------------------------------//
+		uint16_t get_miss() const { return miss_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	グリフを取得
+			@param[in]	code	文字コード（UTF-16）
+			@return グリフ（無い場合「nullptr」）
+		*/
+		//-----------------------------------------------------------------//
+		const uint8_t* get(uint16_t code)
+		{
+			if(code < first_ || code > last_) return nullptr;
+
+			for(uint8_t pos = 0; pos < N; ++pos) {
+				uint8_t idx = order_[pos];
+				if(code_[idx] == code) {
+					touch_(pos);
+					return exist_[idx] ? cache_[idx] : nullptr;
+				}
+			}
+
+			// 最も古いエントリーに読み込む
+			++miss_;
+			uint8_t idx = order_[N - 1];
+			touch_(N - 1);
+			code_[idx] = 0;
+			exist_[idx] = false;
+			uint8_t tmp[2];
+			if(!read_(HEADER_SIZE + static_cast<uint32_t>(code - first_) * 2, tmp, 2)) {
+				return nullptr;
+			}
+			uint16_t n = get16_(tmp);
+			if(n != none_) {
+				if(!read_(data_ + static_cast<uint32_t>(n) * BYTES, cache_[idx], BYTES)) {
+					return nullptr;
+				}
+				exist_[idx] = true;
+			}
+			code_[idx] = code;  // 無いグリフも記録して、再読み込みしない
+			return exist_[idx] ? cache_[idx] : nullptr;
+		}
+	};
+}
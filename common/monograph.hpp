@@ -9,9 +9,63 @@
 */
 //=====================================================================//
 #include <cstdint>
+#include <type_traits>
+#include "common/packbits.hpp"
 
 namespace graphics {
 
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	PLOT クラスの拡張インターフェース判定 @n
+				hspan(x, y, w, c)、vspan(x, y, h, c)、fill_bytes(x, y, w, h, c) @n
+				を持つ PLOT では、水平、垂直、矩形の描画をまとめて行う。@n
+				blit_bytes(x, y, src, w, h, c) を持つ PLOT では、ページ構成の @n
+				フォント（afont_traits）を、バイト単位で書き込む。
+		@param[in]	PLOT	プロットクラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class PLOT>
+	struct plot_traits {
+		template <class T>
+		static auto span_(T* t) -> decltype(t->hspan(0, 0, 0, true), t->vspan(0, 0, 0, true), std::true_type());
+		template <class T>
+		static std::false_type span_(...);
+
+		template <class T>
+		static auto fill_(T* t) -> decltype(t->fill_bytes(0, 0, 0, 0, true), std::true_type());
+		template <class T>
+		static std::false_type fill_(...);
+
+		template <class T>
+		static auto blit_(T* t) -> decltype(t->blit_bytes(0, 0, nullptr, 0, 0, true), std::true_type());
+		template <class T>
+		static std::false_type blit_(...);
+
+		typedef decltype(span_<PLOT>(nullptr)) span_type;	///< hspan、vspan を持つ
+		typedef decltype(fill_<PLOT>(nullptr)) fill_type;	///< fill_bytes を持つ
+		typedef decltype(blit_<PLOT>(nullptr)) blit_type;	///< blit_bytes を持つ
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	AFONT クラスの拡張インターフェース判定 @n
+				get_page(code) を持つ AFONT は、ページ構成のテーブル @n
+				（afont_page で作成）を持つ。
+		@param[in]	AFONT	ASCII フォント・クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class AFONT>
+	struct afont_traits {
+		template <class T>
+		static auto page_(T* t) -> decltype(T::get_page(0), std::true_type());
+		template <class T>
+		static std::false_type page_(...);
+
+		typedef decltype(page_<AFONT>(nullptr)) page_type;	///< get_page を持つ
+	};
+
+
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 	/*!
 		@brief	ASCII 無効フォント定義
@@ -59,6 +113,165 @@ namespace graphics {
 
 		bool		x2_;
 
+		typedef typename plot_traits<PLOT>::span_type span_type;
+		typedef typename plot_traits<PLOT>::fill_type fill_type;
+		// PLOT が blit_bytes を持ち、AFONT がページ構成のテーブルを持つ
+		typedef std::integral_constant<bool, plot_traits<PLOT>::blit_type::value
+			&& afont_traits<AFONT>::page_type::value> strike_type;
+
+		void hline_(int16_t x, int16_t y, int16_t w, bool c, std::true_type) {
+			plot_.hspan(x, y, w, c);
+		}
+
+		void hline_(int16_t x, int16_t y, int16_t w, bool c, std::false_type) {
+			for(int16_t i = 0; i < w; ++i) {
+				plot_(x + i, y, c);
+			}
+		}
+
+		void vline_(int16_t x, int16_t y, int16_t h, bool c, std::true_type) {
+			plot_.vspan(x, y, h, c);
+		}
+
+		void vline_(int16_t x, int16_t y, int16_t h, bool c, std::false_type) {
+			for(int16_t i = 0; i < h; ++i) {
+				plot_(x, y + i, c);
+			}
+		}
+
+		void fill_(int16_t x, int16_t y, int16_t w, int16_t h, bool c, std::true_type) {
+			plot_.fill_bytes(x, y, w, h, c);
+		}
+
+		void fill_(int16_t x, int16_t y, int16_t w, int16_t h, bool c, std::false_type) {
+			for(int16_t i = 0; i < h; ++i) {
+				hline_(x, y + i, w, c, span_type());
+			}
+		}
+
+		// 非圧縮イメージのソース
+		class raw_in {
+			const uint8_t*	src_;
+		public:
+			raw_in(const void* src) : src_(static_cast<const uint8_t*>(src)) { }
+			uint8_t get() { return *src_++; }
+			uint8_t get_run() const { return 0; }
+			void skip_run(uint8_t n) { }
+		};
+
+		// 行単位（LSB から）のビット列を描画 @n
+		// ０のバイト（圧縮ソースでは０の繰り返し全体）は、まとめて読み飛ばす
+		template <class SRC>
+		void draw_bits_(int16_t x, int16_t y, SRC& src, uint8_t w, uint8_t h) {
+			uint16_t bits = static_cast<uint16_t>(w) * h;
+			uint8_t col = 0;
+			while(bits > 0) {
+				uint8_t c = src.get();
+				uint16_t m = bits < 8 ? bits : 8;
+				if(c == 0) {
+					uint8_t r = src.get_run();
+					uint16_t rest = bits - m;
+					uint16_t n = (rest + 7) >> 3;
+					if(r > n) r = n;
+					if(r > 0) {
+						src.skip_run(r);
+						uint16_t b = static_cast<uint16_t>(r) * 8;
+						m += b < rest ? b : rest;
+					}
+				} else if(m < 8) {
+					c &= (1 << m) - 1;
+				}
+				bits -= m;
+				while(c != 0) {
+					if(c & 1) plot_(x + col, y, 1);
+					c >>= 1;
+					--m;
+					++col;
+					if(col >= w) { col = 0; ++y; }
+				}
+				m += col;
+				if(m >= w) {
+					y += m / w;
+					m %= w;
+				}
+				col = m;
+			}
+		}
+
+		void afont_(int16_t x, int16_t y, uint8_t code, std::true_type) {
+			plot_.blit_bytes(x, y, AFONT::get_page(code), AFONT::WIDTH, AFONT::HEIGHT, true);
+		}
+
+		void afont_(int16_t x, int16_t y, uint8_t code, std::false_type) {
+			draw_image(x, y, AFONT::get(code), AFONT::WIDTH, AFONT::HEIGHT);
+		}
+
+		// 四隅を円弧とした図形（中点アルゴリズム） @n
+		// (x0, y0)、(x1, y1) は、左上と右下の円弧の中心
+		void round_(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t r, bool c, bool fill) {
+			if(fill) {
+				fill_(x0 - r, y0, x1 - x0 + r + r + 1, y1 - y0 + 1, c, fill_type());
+			} else {
+				vline(x0 - r, y0, y1 - y0 + 1, c);
+				vline(x1 + r, y0, y1 - y0 + 1, c);
+			}
+			int16_t xx = r;
+			int16_t yy = 0;
+			int16_t err = 1 - r;
+			int16_t run = 0;  // 同じ xx が始まった yy
+			while(yy <= xx) {
+				bool step = err >= 0;
+				if(fill) {
+					if(yy > 0) {
+						hline(x0 - xx, y0 - yy, x1 - x0 + xx + xx + 1, c);
+						hline(x0 - xx, y1 + yy, x1 - x0 + xx + xx + 1, c);
+					}
+					if(step && xx > yy) {
+						hline(x0 - yy, y0 - xx, x1 - x0 + yy + yy + 1, c);
+						hline(x0 - yy, y1 + xx, x1 - x0 + yy + yy + 1, c);
+					}
+				} else {
+					if(yy > 0) {
+						plot_(x0 - xx, y0 - yy, c);
+						plot_(x1 + xx, y0 - yy, c);
+						plot_(x0 - xx, y1 + yy, c);
+						plot_(x1 + xx, y1 + yy, c);
+					}
+					if(step || yy >= xx) {
+						if(run == 0) {  // 上下の辺と繋げる
+							hline(x0 - yy, y0 - xx, x1 - x0 + yy + yy + 1, c);
+							hline(x0 - yy, y1 + xx, x1 - x0 + yy + yy + 1, c);
+						} else {
+							int16_t n = yy - run + 1;
+							hline(x0 - yy, y0 - xx, n, c);
+							hline(x1 + run, y0 - xx, n, c);
+							hline(x0 - yy, y1 + xx, n, c);
+							hline(x1 + run, y1 + xx, n, c);
+						}
+						run = yy + 1;
+					}
+				}
+				++yy;
+				if(step) {
+					--xx;
+					err += ((yy - xx) << 1) + 1;
+				} else {
+					err += (yy << 1) + 1;
+				}
+			}
+		}
+
+		// 点 (dx, dy) が、角度 org から end（時計回り）の範囲にあるか
+		static bool in_arc_(int16_t dx, int16_t dy, uint8_t org, uint8_t end) {
+			int32_t a = static_cast<int32_t>(get_cos(org)) * dy - static_cast<int32_t>(get_sin(org)) * dx;
+			int32_t b = static_cast<int32_t>(get_cos(end)) * dy - static_cast<int32_t>(get_sin(end)) * dx;
+			if(static_cast<uint8_t>(end - org) & 0x80) {
+				return a >= 0 || b <= 0;
+			} else {
+				return a >= 0 && b <= 0;
+			}
+		}
+
 	public:
 		//-----------------------------------------------------------------//
 		/*!
@@ -156,13 +369,42 @@ namespace graphics {
 			@param[in]	c	カラー
 		*/
 		//-----------------------------------------------------------------//
-		void fill(typename PLOT::value_type x, typename PLOT::value_type y, typename PLOT::value_type w, typename PLOT::value_type h, bool c)
+		void fill(int16_t x, int16_t y, int16_t w, int16_t h, bool c)
 		{
-			for(typename PLOT::value_type yy = y; yy < (y + h); ++yy) {
-				for(typename PLOT::value_type xx = x; xx < (x + w); ++xx) {
-					plot_(xx, yy, c);
-				}
-			}
+			if(w <= 0 || h <= 0) return;
+			fill_(x, y, w, h, c, fill_type());
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	水平線を描画
+			@param[in]	x	開始位置 X
+			@param[in]	y	位置 Y
+			@param[in]	w	横幅
+			@param[in]	c	カラー
+		*/
+		//-----------------------------------------------------------------//
+		void hline(int16_t x, int16_t y, int16_t w, bool c)
+		{
+			if(w <= 0) return;
+			hline_(x, y, w, c, span_type());
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	垂直線を描画
+			@param[in]	x	位置 X
+			@param[in]	y	開始位置 Y
+			@param[in]	h	高さ
+			@param[in]	c	カラー
+		*/
+		//-----------------------------------------------------------------//
+		void vline(int16_t x, int16_t y, int16_t h, bool c)
+		{
+			if(h <= 0) return;
+			vline_(x, y, h, c, span_type());
 		}
 
 
@@ -218,6 +460,14 @@ namespace graphics {
 			int8_t sy;
 			if(y2 >= y1) { dy = y2 - y1; sy = 1; } else { dy = y1 - y2; sy = -1; }
 
+			if(dy == 0) {
+				hline(sx > 0 ? x1 : x2, y1, dx + 1, c);
+				return;
+			} else if(dx == 0) {
+				vline(x1, sy > 0 ? y1 : y2, dy + 1, c);
+				return;
+			}
+
 			if(dx > dy) {
 				auto m = dy >> 1;
 				for(int16_t i = 0; i <= dx; i++) {
@@ -256,17 +506,182 @@ namespace graphics {
 		//-----------------------------------------------------------------//
 		void frame(int16_t x, int16_t y, int16_t w, int16_t h, bool c) noexcept
 		{
-			for(int16_t i = 0; i < w; ++i) {
-				plot_(x + i, y, c);
-				plot_(x + i, y + h - 1, c);
+			if(w <= 0 || h <= 0) return;
+			hline(x, y, w, c);
+			hline(x, y + h - 1, w, c);
+			vline(x, y, h, c);
+			vline(x + w - 1, y, h, c);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	正弦を取得（６４個のテーブルから） @n
+					角度は、２５６で一周、０が右（+X）で時計回り
+			@param[in]	angle	角度
+			@return 正弦（-256 ～ 256）
+		*/
+		//-----------------------------------------------------------------//
+		static int16_t get_sin(uint8_t angle)
+		{
+			static const uint8_t tbl[64] = {
+				  0,   6,  13,  19,  25,  31,  38,  44,  50,  56,  62,  68,  74,  80,  86,  92,
+				 98, 104, 109, 115, 121, 126, 132, 137, 142, 147, 152, 157, 162, 167, 172, 177,
+				181, 185, 190, 194, 198, 202, 206, 209, 213, 216, 220, 223, 226, 229, 231, 234,
+				237, 239, 241, 243, 245, 247, 248, 250, 251, 252, 253, 254, 255, 255, 255, 255,
+			};
+			uint8_t i = angle & 63;
+			if(angle & 64) i = 64 - i;
+			int16_t v = i < 64 ? tbl[i] : 256;
+			return (angle & 128) ? -v : v;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	余弦を取得
+			@param[in]	angle	角度（２５６で一周）
+			@return 余弦（-256 ～ 256）
+		*/
+		//-----------------------------------------------------------------//
+		static int16_t get_cos(uint8_t angle) { return get_sin(angle + 64); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	円を描画する
+			@param[in]	x	中心Ｘ軸を指定
+			@param[in]	y	中心Ｙ軸を指定
+			@param[in]	r	半径
+			@param[in]	c	描画色
+		*/
+		//-----------------------------------------------------------------//
+		void circle(int16_t x, int16_t y, int16_t r, bool c)
+		{
+			if(r < 0) return;
+			round_(x, y, x, y, r, c, false);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	塗りつぶした円を描画する（水平線で描画）
+			@param[in]	x	中心Ｘ軸を指定
+			@param[in]	y	中心Ｙ軸を指定
+			@param[in]	r	半径
+			@param[in]	c	描画色
+		*/
+		//-----------------------------------------------------------------//
+		void fill_circle(int16_t x, int16_t y, int16_t r, bool c)
+		{
+			if(r < 0) return;
+			round_(x, y, x, y, r, c, true);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	円弧を描画する @n
+					角度は、２５６で一周、０が右（+X）で時計回り
+			@param[in]	x	中心Ｘ軸を指定
+			@param[in]	y	中心Ｙ軸を指定
+			@param[in]	r	半径
+			@param[in]	org	開始角度
+			@param[in]	end	終了角度（開始角度と同じ場合、円）
+			@param[in]	c	描画色
+		*/
+		//-----------------------------------------------------------------//
+		void arc(int16_t x, int16_t y, int16_t r, uint8_t org, uint8_t end, bool c)
+		{
+			if(r < 0) return;
+			if(org == end) {
+				circle(x, y, r, c);
+				return;
 			}
-			for(int16_t i = 0; i < h; ++i) {
-				plot_(x, y + i, c);
-				plot_(x + w - 1, y + i, c);
+			int16_t xx = r;
+			int16_t yy = 0;
+			int16_t err = 1 - r;
+			while(yy <= xx) {
+				for(uint8_t i = 0; i < 8; ++i) {  // ８つの対称点
+					int16_t dx = (i & 1) ? yy : xx;
+					int16_t dy = (i & 1) ? xx : yy;
+					if(i & 2) dx = -dx;
+					if(i & 4) dy = -dy;
+					if(in_arc_(dx, dy, org, end)) plot_(x + dx, y + dy, c);
+				}
+				++yy;
+				if(err >= 0) {
+					--xx;
+					err += ((yy - xx) << 1) + 1;
+				} else {
+					err += (yy << 1) + 1;
+				}
 			}
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	針を描画する（メーター等）
+			@param[in]	x	中心Ｘ軸を指定
+			@param[in]	y	中心Ｙ軸を指定
+			@param[in]	r0	内側の半径
+			@param[in]	r1	外側の半径
+			@param[in]	angle	角度（２５６で一周、０が右で時計回り）
+			@param[in]	c	描画色
+		*/
+		//-----------------------------------------------------------------//
+		void needle(int16_t x, int16_t y, int16_t r0, int16_t r1, uint8_t angle, bool c)
+		{
+			int32_t sx = get_cos(angle);
+			int32_t sy = get_sin(angle);
+			line(x + ((sx * r0 + 128) >> 8), y + ((sy * r0 + 128) >> 8),
+				 x + ((sx * r1 + 128) >> 8), y + ((sy * r1 + 128) >> 8), c);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	角を丸めたフレームを描画する
+			@param[in]	x	開始点Ｘ軸を指定
+			@param[in]	y	開始点Ｙ軸を指定
+			@param[in]	w	横幅
+			@param[in]	h	高さ
+			@param[in]	r	角の半径
+			@param[in]	c	描画色
+		*/
+		//-----------------------------------------------------------------//
+		void round_frame(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, bool c)
+		{
+			if(w <= 0 || h <= 0) return;
+			int16_t m = ((w < h ? w : h) - 1) >> 1;
+			if(r > m) r = m;
+			if(r < 0) r = 0;
+			round_(x + r, y + r, x + w - 1 - r, y + h - 1 - r, r, c, false);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	角を丸めた四角を塗りつぶす
+			@param[in]	x	開始点Ｘ軸を指定
+			@param[in]	y	開始点Ｙ軸を指定
+			@param[in]	w	横幅
+			@param[in]	h	高さ
+			@param[in]	r	角の半径
+			@param[in]	c	描画色
+		*/
+		//-----------------------------------------------------------------//
+		void round_fill(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, bool c)
+		{
+			if(w <= 0 || h <= 0) return;
+			int16_t m = ((w < h ? w : h) - 1) >> 1;
+			if(r > m) r = m;
+			if(r < 0) r = 0;
+			round_(x + r, y + r, x + w - 1 - r, y + h - 1 - r, r, c, true);
+		}
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	ビットマップイメージを描画する
@@ -281,24 +696,28 @@ namespace graphics {
 		{
 			if(img == nullptr) return;
 
-			const uint8_t* p = static_cast<const uint8_t*>(img);
-			uint8_t k = 1;
-			uint8_t c = *p++;
-			for(uint8_t i = 0; i < h; ++i) {
-				int16_t xx = x;
-				for(uint8_t j = 0; j < w; ++j) {
-					if(c & k) {
-						plot_(xx, y, 1);
-					}
-					k <<= 1;
-					if(k == 0) {
-						k = 1;
-						c = *p++;
-					}
-					++xx;
-				}
-				++y;
-			}
+			raw_in src(img);
+			draw_bits_(x, y, src, w, h);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	PackBits 圧縮したビットマップイメージを描画する @n
+					展開しながら描画するので、バッファは使わない
+			@param[in]	x	開始点Ｘ軸を指定
+			@param[in]	y	開始点Ｙ軸を指定
+			@param[in]	img	描画ソース（draw_image と同じビット列を圧縮したもの）
+			@param[in]	w	描画ソースの幅
+			@param[in]	h	描画ソースの高さ
+		*/
+		//-----------------------------------------------------------------//
+		void draw_image_pack(int16_t x, int16_t y, const void* img, uint8_t w, uint8_t h)
+		{
+			if(img == nullptr) return;
+
+			utils::packbits_in src(img);
+			draw_bits_(x, y, src, w, h);
 		}
 
 
@@ -382,6 +801,27 @@ namespace graphics {
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	圧縮モーションオブジェクトを描画する @n
+					先頭２バイトが幅と高さ、以降は PackBits 圧縮したビット列 @n
+					（mobj_pack で作成）
+			@param[in]	x	開始点Ｘ軸を指定
+			@param[in]	y	開始点Ｙ軸を指定
+			@param[in]	src	描画オブジェクト
+		*/
+		//-----------------------------------------------------------------//
+		void draw_pmobj(int16_t x, int16_t y, const void* src)
+		{
+			if(src == nullptr) return;
+
+			const uint8_t* p = static_cast<const uint8_t*>(src);
+			uint8_t w = *p++;
+			uint8_t h = *p++;
+			draw_image_pack(x, y, p, w, h);
+		}
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	フォントを描画する（UTF-16）
@@ -402,7 +842,7 @@ namespace graphics {
 ///				if(x2_) {
 ///					draw_image2x(x, y, AFONT::get(code), AFONT::WIDTH, AFONT::HEIGHT);
 ///				} else {
-					draw_image(x, y, AFONT::get(code), AFONT::WIDTH, AFONT::HEIGHT);
+					afont_(x, y, code, strike_type());
 ///				}
 			} else {
 				if(x <= -KFONT::WIDTH || x >= static_cast<int16_t>(PLOT::WIDTH)) {
@@ -412,9 +852,9 @@ namespace graphics {
 				if(p != nullptr) {
 					draw_image(x, y, p, KFONT::WIDTH, KFONT::HEIGHT);
 				} else {
-					draw_image(x, y, AFONT::get(0x12), AFONT::WIDTH, AFONT::HEIGHT);
+					afont_(x, y, 0x12, strike_type());
 					x += AFONT::WIDTH;
-					draw_image(x, y, AFONT::get(0x13), AFONT::WIDTH, AFONT::HEIGHT);
+					afont_(x, y, 0x13, strike_type());
 				}
 			}
 		}
@@ -532,21 +972,17 @@ namespace graphics {
 			h -= 2;
 			++y;
 			w -= 2;
-			for(uint8_t j = 0; j < h; ++j) {
-				for(uint8_t i = 0; i < w; ++i) {
-					if(i < l) {
-						if((i ^ j) & 1) {
-							plot_(x + i, y + j, 1);
-						} else {
-							plot_(x + i, y + j, 0);
-						}
-					} else if(i == l && i != 0) {
-						plot_(x + i, y + j, 1);
-					} else {
-						plot_(x + i, y + j, 0);
-					}
+			fill(x, y, w, h, 0);
+			int16_t n = l < w ? l : w;
+			// レベル部分は市松模様
+			for(int16_t j = 0; j < static_cast<int16_t>(h); ++j) {
+				for(int16_t i = (j & 1) ^ 1; i < n; i += 2) {
+					plot_(x + i, y + j, 1);
 				}
 			}
+			if(l < w && l != 0) {
+				vline(x + l, y, h, 1);
+			}
 		}
 	};
 }
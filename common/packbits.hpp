@@ -0,0 +1,91 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	PackBits 展開クラス @n
+			制御バイト n： @n
+			  0 ～ 127   : 続く n + 1 バイトをそのまま @n
+			  129 ～ 255 : 続く１バイトを 257 - n 回繰り返す @n
+			  128        : 何もしない @n
+			バッファを持たず、１バイトずつ取り出す。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	PackBits 展開クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class packbits_in {
+
+		const uint8_t*	src_;
+		uint8_t			num_;	///< 残りバイト数
+		bool			run_;	///< 繰り返しの場合「true」
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+			@param[in]	src	圧縮データ
+		*/
+		//-----------------------------------------------------------------//
+		packbits_in(const void* src) : src_(static_cast<const uint8_t*>(src)), num_(0), run_(false) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	１バイト取り出す
+			@return 展開したバイト
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t get()
+		{
+			while(num_ == 0) {
+				uint8_t n = *src_++;
+				if(n < 128) {
+					num_ = n + 1;
+					run_ = false;
+				} else if(n > 128) {
+					num_ = 257 - n;
+					run_ = true;
+				}
+			}
+			--num_;
+			if(run_) {
+				uint8_t v = *src_;
+				if(num_ == 0) ++src_;
+				return v;
+			}
+			return *src_++;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	同じ値が続く残りのバイト数を取得 @n
+					（get で取り出した直後の値が、あと何回続くか）
+			@return 繰り返し中なら残りバイト数、それ以外は「０」
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t get_run() const { return run_ ? num_ : 0; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	繰り返しを読み飛ばす
+			@param[in]	n	読み飛ばすバイト数（get_run() 以下）
+		*/
+		//-----------------------------------------------------------------//
+		void skip_run(uint8_t n)
+		{
+			num_ -= n;
+			if(num_ == 0) ++src_;
+		}
+	};
+}
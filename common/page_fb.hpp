@@ -0,0 +1,261 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	ページ構成フレームバッファ・クラス @n
+			ST7565、SH1106、UC1701 と同じ、縦８ピクセルを１バイトとした @n
+			ページ単位のフレームバッファで、monograph の PLOT として使う。@n
+			水平、垂直、矩形の描画は、マスクしたバイト単位で書き込む。@n
+			書き換えた範囲は dirty_page に記録され、LCD ドライバーの @n
+			copy(fb(), at_dirty()) で、その範囲だけを転送出来る。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2017, 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include "common/dirty_page.hpp"
+
+namespace graphics {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	ページ構成フレームバッファ・クラス
+		@param[in]	W	横幅
+		@param[in]	H	高さ（８の倍数）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <int16_t W, int16_t H>
+	class page_fb {
+
+		static_assert((H & 7) == 0, "H must be a multiple of 8");
+
+	public:
+		typedef int16_t value_type;
+
+		static const int16_t WIDTH  = W;
+		static const int16_t HEIGHT = H;
+		static const int8_t PAGE_NUM = H / 8;
+
+		typedef dirty_page<W, PAGE_NUM> dirty_type;
+
+	private:
+		uint8_t		fb_[W * PAGE_NUM];
+		dirty_type	dirty_;
+
+		// 値が変化した場合だけ、更新範囲に加える
+		void put_(int16_t x, int16_t page, uint8_t mask, bool c) {
+			uint8_t* p = &fb_[page * WIDTH + x];
+			uint8_t v = c ? (*p | mask) : (*p & ~mask);
+			if(v != *p) {
+				*p = v;
+				dirty_.mark(page, x, x + 1);
+			}
+		}
+
+		// 縦方向のマスク
+		static uint8_t mask_(int16_t y, int16_t n) {
+			return static_cast<uint8_t>(((1 << n) - 1) << (y & 7));
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	全体をクリア
+			@param[in]	v	クリア値（バイト単位）
+		*/
+		//-----------------------------------------------------------------//
+		void clear(uint8_t v = 0)
+		{
+			uint8_t* p = fb_;
+			for(int16_t page = 0; page < PAGE_NUM; ++page) {
+				int16_t org = WIDTH;
+				int16_t end = 0;
+				for(int16_t x = 0; x < WIDTH; ++x) {
+					if(*p != v) {
+						*p = v;
+						if(x < org) org = x;
+						end = x + 1;
+					}
+					++p;
+				}
+				if(org < end) dirty_.mark(page, org, end);
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	フレームバッファを取得
+			@return フレームバッファ
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t* fb() { return fb_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	更新範囲の参照
+			@return 更新範囲
+		*/
+		//-----------------------------------------------------------------//
+		dirty_type& at_dirty() { return dirty_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	点を描画
+			@param[in]	x	位置 X
+			@param[in]	y	位置 Y
+			@param[in]	c	カラー
+		*/
+		//-----------------------------------------------------------------//
+		void operator() (value_type x, value_type y, bool c)
+		{
+			if(x < 0 || x >= WIDTH) return;
+			if(y < 0 || y >= HEIGHT) return;
+			put_(x, y >> 3, 1 << (y & 7), c);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	水平線を描画
+			@param[in]	x	開始位置 X
+			@param[in]	y	位置 Y
+			@param[in]	w	横幅
+			@param[in]	c	カラー
+		*/
+		//-----------------------------------------------------------------//
+		void hspan(value_type x, value_type y, value_type w, bool c)
+		{
+			if(y < 0 || y >= HEIGHT) return;
+			if(x < 0) { w += x; x = 0; }
+			if((x + w) > WIDTH) w = WIDTH - x;
+			if(w <= 0) return;
+			dirty_.mark(y >> 3, x, x + w);
+			uint8_t* p = &fb_[(y >> 3) * WIDTH + x];
+			uint8_t mask = 1 << (y & 7);
+			if(c) {
+				do { *p++ |= mask; } while(--w > 0);
+			} else {
+				mask = ~mask;
+				do { *p++ &= mask; } while(--w > 0);
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	垂直線を描画
+			@param[in]	x	位置 X
+			@param[in]	y	開始位置 Y
+			@param[in]	h	高さ
+			@param[in]	c	カラー
+		*/
+		//-----------------------------------------------------------------//
+		void vspan(value_type x, value_type y, value_type h, bool c)
+		{
+			if(x < 0 || x >= WIDTH) return;
+			if(y < 0) { h += y; y = 0; }
+			if((y + h) > HEIGHT) h = HEIGHT - y;
+			while(h > 0) {
+				int16_t n = 8 - (y & 7);
+				if(n > h) n = h;
+				put_(x, y >> 3, mask_(y, n), c);
+				y += n;
+				h -= n;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	矩形を塗りつぶす（ページ毎にマスクしたバイトで書き込む）
+			@param[in]	x	開始位置 X
+			@param[in]	y	開始位置 Y
+			@param[in]	w	横幅
+			@param[in]	h	高さ
+			@param[in]	c	カラー
+		*/
+		//-----------------------------------------------------------------//
+		void fill_bytes(value_type x, value_type y, value_type w, value_type h, bool c)
+		{
+			if(x < 0) { w += x; x = 0; }
+			if((x + w) > WIDTH) w = WIDTH - x;
+			if(y < 0) { h += y; y = 0; }
+			if((y + h) > HEIGHT) h = HEIGHT - y;
+			if(w <= 0) return;
+			while(h > 0) {
+				int16_t n = 8 - (y & 7);
+				if(n > h) n = h;
+				dirty_.mark(y >> 3, x, x + w);
+				uint8_t* p = &fb_[(y >> 3) * WIDTH + x];
+				if(n == 8) {
+					uint8_t v = c ? 0xff : 0x00;
+					for(int16_t i = 0; i < w; ++i) p[i] = v;
+				} else {
+					uint8_t mask = mask_(y, n);
+					if(c) {
+						for(int16_t i = 0; i < w; ++i) p[i] |= mask;
+					} else {
+						mask = ~mask;
+						for(int16_t i = 0; i < w; ++i) p[i] &= mask;
+					}
+				}
+				y += n;
+				h -= n;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ページ構成のイメージを転送 @n
+					ソースは、カラム毎に (h + 7) / 8 バイト（下位ビットが上）@n
+					Y が８の倍数ならバイトをそのまま、それ以外は２バイトに @n
+					シフトして書き込む。
+			@param[in]	x	開始位置 X
+			@param[in]	y	開始位置 Y
+			@param[in]	src	ソース
+			@param[in]	w	横幅
+			@param[in]	h	高さ
+			@param[in]	c	カラー（「true」で OR、「false」でセットされたビットを消去）
+		*/
+		//-----------------------------------------------------------------//
+		void blit_bytes(value_type x, value_type y, const uint8_t* src, value_type w, value_type h, bool c)
+		{
+			if(h <= 0) return;
+			uint8_t n = (h + 7) >> 3;
+			if(x < 0) { src += -x * n; w += x; x = 0; }
+			if((x + w) > WIDTH) w = WIDTH - x;
+			if(w <= 0) return;
+
+			int16_t top = y >> 3;
+			uint8_t sft = y & 7;
+			int16_t end = (y + h - 1) >> 3;
+			for(int16_t pg = top; pg <= end; ++pg) {
+				if(pg >= 0 && pg < PAGE_NUM) dirty_.mark(pg, x, x + w);
+			}
+
+			uint8_t* col = &fb_[x];
+			for(int16_t i = 0; i < w; ++i) {
+				for(uint8_t j = 0; j < n; ++j) {
+					uint16_t v = static_cast<uint16_t>(*src++) << sft;
+					int16_t pg = top + j;
+					if(pg >= 0 && pg < PAGE_NUM) {
+						if(c) col[pg * WIDTH] |= v;
+						else col[pg * WIDTH] &= ~v;
+					}
+					if(sft == 0) continue;
+					++pg;
+					if(pg >= 0 && pg < PAGE_NUM) {
+						if(c) col[pg * WIDTH] |= v >> 8;
+						else col[pg * WIDTH] &= ~(v >> 8);
+					}
+				}
+				++col;
+			}
+		}
+	};
+}
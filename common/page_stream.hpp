@@ -0,0 +1,189 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	LCD バックグラウンド転送クラス @n
+			page_fb の更新範囲を、転送用のリング・バッファに写し取り、@n
+			タイマー割り込みから少しずつ LCD へ送る。@n
+			写し取った後は、転送中でも、次のフレームを描画出来る。@n
+			（RAM が少ないので、フレームバッファを２枚持たず、更新範囲だけを @n
+			写す、更新範囲がリングに入り切らない場合、flip は空きを待つ）@n
+			LCD には、flip した時点の内容だけが送られ、描画途中の画像は @n
+			送られない。@n
+			使い方： @n
+			  1. page_fb に描画する @n
+			  2. flip() で更新範囲をリングに写す（戻った後は描画して良い）@n
+			  割り込み内で service() を呼ぶ。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include "common/dirty_page.hpp"
+
+namespace graphics {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	LCD バックグラウンド転送クラス
+		@param[in]	LCD		LCD ドライバー（set_area、write、end_area が必要）
+		@param[in]	PLOT	フレームバッファ（page_fb）
+		@param[in]	SLICE	１回の service で送る最大バイト数
+		@param[in]	BUFF	リング・バッファのバイト数（２の累乗、２５６以下）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class LCD, class PLOT, uint8_t SLICE = 16, uint16_t BUFF = 128>
+	class page_stream {
+
+		static_assert(BUFF >= 8 && BUFF <= 256 && (BUFF & (BUFF - 1)) == 0,
+			"BUFF must be a power of 2, 8 to 256");
+
+		static const uint8_t MASK = BUFF - 1;
+		static const uint8_t FRAME_END = 0xff;	///< フレームの終わり（ページの位置）
+
+		LCD&		lcd_;
+		PLOT&		plot_;
+
+		// リングの一区間は、ページ、カラム、バイト数、データ
+		uint8_t		buff_[BUFF];
+		volatile uint8_t	put_;
+		volatile uint8_t	get_;
+
+		// 割り込み側で送信中の区間
+		uint8_t		page_;
+		uint8_t		col_;
+		volatile uint8_t	len_;
+
+		volatile uint16_t	frame_;
+
+		void sleep_() const { asm("nop"); }
+
+		uint8_t space_() const { return (get_ - put_ - 1) & MASK; }
+
+		uint8_t pop_() {
+			uint8_t v = buff_[get_];
+			get_ = (get_ + 1) & MASK;
+			return v;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+			@param[in]	lcd		LCD ドライバー
+			@param[in]	plot	フレームバッファ
+		*/
+		//-----------------------------------------------------------------//
+		page_stream(LCD& lcd, PLOT& plot) : lcd_(lcd), plot_(plot),
+			put_(0), get_(0), page_(0), col_(0), len_(0), frame_(0) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	転送中か検査
+			@return 転送中なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool busy() const { return put_ != get_ || len_ != 0; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	転送完了を待つ
+		*/
+		//-----------------------------------------------------------------//
+		void sync() const { while(busy()) sleep_(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	送り終えたフレーム数を取得
+			@return フレーム数
+		*/
+		//-----------------------------------------------------------------//
+		uint16_t get_frame() const { return frame_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	フレームバッファの更新範囲を、転送に回す @n
+					更新範囲をリングに写し、フレームバッファの更新範囲を @n
+					クリアする、戻った後は、フレームバッファに描画して良い。@n
+					リングに空きが無い場合は、割り込みで送られるまで待つ。
+			@param[in]	ofs	転送先のページ・オフセット（ドライバーの copy と同じ）
+		*/
+		//-----------------------------------------------------------------//
+		void flip(uint8_t ofs = 0)
+		{
+			auto& dirty = plot_.at_dirty();
+			for(uint8_t page = 0; page < PLOT::PAGE_NUM; ++page) {
+				uint8_t org;
+				uint8_t end;
+				if(!dirty.get(page, org, end)) continue;
+				const uint8_t* src = &plot_.fb()[page * PLOT::WIDTH];
+				while(org < end) {
+					uint8_t n;
+					while((n = space_()) < 4) sleep_();
+					n -= 3;
+					if(n > (end - org)) n = end - org;
+					uint8_t p = put_;
+					buff_[p] = page + ofs;
+					p = (p + 1) & MASK;
+					buff_[p] = org;
+					p = (p + 1) & MASK;
+					buff_[p] = n;
+					p = (p + 1) & MASK;
+					for(uint8_t i = 0; i < n; ++i) {
+						buff_[p] = src[org + i];
+						p = (p + 1) & MASK;
+					}
+					put_ = p;  // 区間を書き終えてから、割り込み側に渡す
+					org += n;
+				}
+			}
+			dirty.clear();
+
+			while(space_() < 1) sleep_();
+			buff_[put_] = FRAME_END;
+			put_ = (put_ + 1) & MASK;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	サービス（割り込みから呼ぶ）
+		*/
+		//-----------------------------------------------------------------//
+		void service()
+		{
+			uint8_t n = SLICE;
+			while(n > 0) {
+				if(len_ == 0) {
+					if(get_ == put_) break;
+					uint8_t page = pop_();
+					if(page == FRAME_END) {
+						++frame_;
+						continue;
+					}
+					page_ = page;
+					col_ = pop_();
+					len_ = pop_();
+				}
+				uint8_t len = len_;
+				if(len > n) len = n;
+				// リングの終わりで折り返す場合は、二回に分けて送る
+				uint16_t k = BUFF - get_;
+				if(k > len) k = len;
+				lcd_.set_area(page_, col_);
+				lcd_.write(&buff_[get_], k);
+				if(k < len) lcd_.write(&buff_[0], len - k);
+				lcd_.end_area();
+				get_ = (get_ + len) & MASK;
+				col_ += len;
+				len_ -= len;
+				n -= len;
+			}
+		}
+	};
+}
@@ -1,7 +1,17 @@
 #pragma once
 //=====================================================================//
 /*!	@file
-	@brief	ソフトウェア SPI I/O 制御
+	@brief	ソフトウェア SPI I/O 制御 @n
+			指定速度が、ソフトで出せる速度を超える場合（start(0) 等）、@n
+			ウェイトを持たない、展開済みの転送（送信のみ、受信のみ）を使う。@n
+			R8C（20MHz）での１バイトのクロック数（命令列から数えた見積り、@n
+			ビットの値による分岐は平均、SFR アクセスのウェイト無し）：@n
+			  send_byte_   ：19 x 8 + 9（send のループ）          = 161（約 0.99 Mbps）@n
+			  recv_byte_   ：17.5 x 8 - 1 + 9（recv のループ）    = 148（約 1.08 Mbps）@n
+			  xchg_<false> ：28.5 x 8 - 1 + 24（xchg の呼び出し） = 251（約 0.64 Mbps）@n
+			  xchg_<true>  ：１ビット 36.5 + 14 x (delay_ - 3)（delay_ > 3 の場合）@n
+			どの soft_spi_mode も同じ命令列なので、速度は変わらない。@n
+			（lcd_sim、spi_sim の転送時間は、この値を使う）
     @author 平松邦仁 (hira@rvf-rc45.net)
 	@copyright	Copyright (C) 2017 Kunihito Hiramatsu @n
 				Released under the MIT license @n
@@ -43,16 +53,23 @@ namespace device {
 	class spi_io {
 
 		uint8_t	delay_;
+		bool	fast_;		///< ウェイト無しで転送
 
+		template <bool WAIT>
 		inline void clockv_(bool v) {
-			uint8_t n = delay_;
-			while(n > 3) { --n; asm("nop"); }
+			if(WAIT) {
+				uint8_t n = delay_;
+				while(n > 3) { --n; asm("nop"); }
+			}
 			SPCK::P = v;
 		}
 
+		template <bool WAIT>
 		inline bool clockr_(bool v) {
-			uint8_t n = delay_;
-			while(n > 3) { --n; asm("nop"); }
+			if(WAIT) {
+				uint8_t n = delay_;
+				while(n > 3) { --n; asm("nop"); }
+			}
 			bool ret = MISO::P();
 			SPCK::P = v;
 			return ret;
@@ -77,124 +94,60 @@ namespace device {
 			}
 		}
 
-	public:
-		//-----------------------------------------------------------------//
-		/*!
-			@brief  コンストラクター
-		*/
-		//-----------------------------------------------------------------//
-		spi_io() : delay_(255) { }
-
 
-		//-----------------------------------------------------------------//
-		/*!
-			@brief  設定可能な最大速度を返す
-			@return 速度
-		*/
-		//-----------------------------------------------------------------//
-		uint32_t get_max_speed() const { return 120000000; }
-
-
-		//-----------------------------------------------------------------//
-		/*!
-			@brief  ＳＤカード用設定を有効にする
-			@param[in]	speed	通信速度
-			@return エラー（速度設定範囲外）なら「false」
-		*/
-		//-----------------------------------------------------------------//
-		bool start_sdc(uint32_t speed)
+		void set_speed_(uint32_t speed)
 		{
-			MISO::DIR = 0;
-			MISO::PU  = 1;
-			MOSI::DIR = 1;
-			SPCK::DIR = 1;
-
-			uint32_t n = F_CLK / speed;
+			uint32_t n = 0;
+			if(speed > 0) n = F_CLK / speed;  // 0 の場合、最大速度
 			if(n > 511) n = 511;
 			delay_ = n / 2;
-
-			return true;
+			fast_ = delay_ <= 3;  // F_CLK / 8 を超える速度（ウェイト・ループが空）
 		}
 
 
-		//-----------------------------------------------------------------//
-		/*!
-			@brief  開始
-			@param[in]	speed	通信速度
-			@return エラー（速度設定範囲外）なら「false」
-		*/
-		//-----------------------------------------------------------------//
-		bool start(uint32_t speed)
-		{
-			MISO::PU  = 1;
-			MISO::DIR = 0;
-			MOSI::DIR = 1;
-			SPCK::DIR = 1;
-
-			if(MODE == soft_spi_mode::CK10 || MODE == soft_spi_mode::CK10_) {
-//				SPCK::P = 0;
-			} else {
-//				SPCK::P = 1;
-			}
-			SPCK::P = 0;
-
-			uint32_t n = F_CLK / speed;
-			if(n > 511) n = 511;
-			delay_ = n / 2;
-
-			return true;
-		}
-
-
-		//----------------------------------------------------------------//
-		/*!
-			@brief	リード・ライト
-			@param[in]	data	書き込みデータ
-			@return 読み出しデータ
-		*/
-		//----------------------------------------------------------------//
-		uint8_t xchg(uint8_t data = 0xff)
+		template <bool WAIT>
+		uint8_t xchg_(uint8_t data = 0xff)
 		{
 #if 1
 			uint8_t r = 0;
 			if(data & 0x80) MOSI::P = 1; else MOSI::P = 0;	// bit7
-			clockv_(0);
-			if(clockr_(1)) ++r; // bit7
+			clockv_<WAIT>(0);
+			if(clockr_<WAIT>(1)) ++r; // bit7
 
 			r <<= 1;
 			if(data & 0x40) MOSI::P = 1; else MOSI::P = 0;	// bit6
-			clockv_(0);
-			if(clockr_(1)) ++r; // bit6
+			clockv_<WAIT>(0);
+			if(clockr_<WAIT>(1)) ++r; // bit6
 
 			r <<= 1;
 			if(data & 0x20) MOSI::P = 1; else MOSI::P = 0;	// bit5
-			clockv_(0);
-			if(clockr_(1)) ++r; // bit5
+			clockv_<WAIT>(0);
+			if(clockr_<WAIT>(1)) ++r; // bit5
 
 			r <<= 1;
 			if(data & 0x10) MOSI::P = 1; else MOSI::P = 0;	// bit4
-			clockv_(0);
-			if(clockr_(1)) ++r; // bit4
+			clockv_<WAIT>(0);
+			if(clockr_<WAIT>(1)) ++r; // bit4
 
 			r <<= 1;
 			if(data & 0x08) MOSI::P = 1; else MOSI::P = 0;	// bit3
-			clockv_(0);
-			if(clockr_(1)) ++r; // bit3
+			clockv_<WAIT>(0);
+			if(clockr_<WAIT>(1)) ++r; // bit3
 
 			r <<= 1;
 			if(data & 0x04) MOSI::P = 1; else MOSI::P = 0;	// bit2
-			clockv_(0);
-			if(clockr_(1)) ++r; // bit2
+			clockv_<WAIT>(0);
+			if(clockr_<WAIT>(1)) ++r; // bit2
 
 			r <<= 1;
 			if(data & 0x02) MOSI::P = 1; else MOSI::P = 0;	// bit1
-			clockv_(0);
-			if(clockr_(1)) ++r; // bit1
+			clockv_<WAIT>(0);
+			if(clockr_<WAIT>(1)) ++r; // bit1
 
 			r <<= 1;
 			if(data & 0x01) MOSI::P = 1; else MOSI::P = 0;	// bit0
-			clockv_(0);
-			if(clockr_(1)) ++r; // bit0
+			clockv_<WAIT>(0);
+			if(clockr_<WAIT>(1)) ++r; // bit0
 
 			return r;
 #else
@@ -288,6 +241,161 @@ namespace device {
 		}
 
 
+		// 送信のみ（MISO を読まない、ウェイト無し）
+		void send_byte_(uint8_t data)
+		{
+			if(data & 0x80) MOSI::P = 1; else MOSI::P = 0;	// bit7
+			SPCK::P = 0;
+			SPCK::P = 1;
+			if(data & 0x40) MOSI::P = 1; else MOSI::P = 0;	// bit6
+			SPCK::P = 0;
+			SPCK::P = 1;
+			if(data & 0x20) MOSI::P = 1; else MOSI::P = 0;	// bit5
+			SPCK::P = 0;
+			SPCK::P = 1;
+			if(data & 0x10) MOSI::P = 1; else MOSI::P = 0;	// bit4
+			SPCK::P = 0;
+			SPCK::P = 1;
+			if(data & 0x08) MOSI::P = 1; else MOSI::P = 0;	// bit3
+			SPCK::P = 0;
+			SPCK::P = 1;
+			if(data & 0x04) MOSI::P = 1; else MOSI::P = 0;	// bit2
+			SPCK::P = 0;
+			SPCK::P = 1;
+			if(data & 0x02) MOSI::P = 1; else MOSI::P = 0;	// bit1
+			SPCK::P = 0;
+			SPCK::P = 1;
+			if(data & 0x01) MOSI::P = 1; else MOSI::P = 0;	// bit0
+			SPCK::P = 0;
+			SPCK::P = 1;
+		}
+
+
+		// 受信のみ（MOSI を変えない、ウェイト無し）
+		uint8_t recv_byte_()
+		{
+			uint8_t r = 0;
+			SPCK::P = 0;
+			if(MISO::P()) ++r; // bit7
+			SPCK::P = 1;
+
+			r <<= 1;
+			SPCK::P = 0;
+			if(MISO::P()) ++r; // bit6
+			SPCK::P = 1;
+
+			r <<= 1;
+			SPCK::P = 0;
+			if(MISO::P()) ++r; // bit5
+			SPCK::P = 1;
+
+			r <<= 1;
+			SPCK::P = 0;
+			if(MISO::P()) ++r; // bit4
+			SPCK::P = 1;
+
+			r <<= 1;
+			SPCK::P = 0;
+			if(MISO::P()) ++r; // bit3
+			SPCK::P = 1;
+
+			r <<= 1;
+			SPCK::P = 0;
+			if(MISO::P()) ++r; // bit2
+			SPCK::P = 1;
+
+			r <<= 1;
+			SPCK::P = 0;
+			if(MISO::P()) ++r; // bit1
+			SPCK::P = 1;
+
+			r <<= 1;
+			SPCK::P = 0;
+			if(MISO::P()) ++r; // bit0
+			SPCK::P = 1;
+
+			return r;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		spi_io() : delay_(255), fast_(false) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  設定可能な最大速度を返す
+			@return 速度
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_max_speed() const { return 120000000; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ＳＤカード用設定を有効にする
+			@param[in]	speed	通信速度（0 の場合、最大速度）
+			@return エラー（速度設定範囲外）なら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool start_sdc(uint32_t speed)
+		{
+			MISO::DIR = 0;
+			MISO::PU  = 1;
+			MOSI::DIR = 1;
+			SPCK::DIR = 1;
+
+			set_speed_(speed);
+
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  開始
+			@param[in]	speed	通信速度（0 の場合、最大速度）
+			@return エラー（速度設定範囲外）なら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool start(uint32_t speed)
+		{
+			MISO::PU  = 1;
+			MISO::DIR = 0;
+			MOSI::DIR = 1;
+			SPCK::DIR = 1;
+
+			if(MODE == soft_spi_mode::CK10 || MODE == soft_spi_mode::CK10_) {
+//				SPCK::P = 0;
+			} else {
+//				SPCK::P = 1;
+			}
+			SPCK::P = 0;
+
+			set_speed_(speed);
+
+			return true;
+		}
+
+
+		//----------------------------------------------------------------//
+		/*!
+			@brief	リード・ライト
+			@param[in]	data	書き込みデータ
+			@return 読み出しデータ
+		*/
+		//----------------------------------------------------------------//
+		uint8_t xchg(uint8_t data = 0xff)
+		{
+			if(fast_) return xchg_<false>(data);
+			else return xchg_<true>(data);
+		}
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief  シリアル送信
@@ -299,9 +407,16 @@ namespace device {
 		{
 			auto ptr = static_cast<const uint8_t*>(src);
 			auto end = ptr + size;
-			while(ptr < end) {
-				xchg(*ptr);
-				++ptr;
+			if(fast_) {
+				while(ptr < end) {
+					send_byte_(*ptr);
+					++ptr;
+				}
+			} else {
+				while(ptr < end) {
+					xchg_<true>(*ptr);
+					++ptr;
+				}
 			}
 		}
 
@@ -316,11 +431,18 @@ namespace device {
 		void recv(void* dst, uint32_t size)
 		{
 			uint8_t* ptr = static_cast<uint8_t*>(dst);
-			uint32_t pos = 0;
-			while(pos < size) {
-				*ptr = xchg();
-				++ptr;
-				++pos;
+			uint8_t* end = ptr + size;
+			if(fast_) {
+				MOSI::P = 1;  // 0xff を送る
+				while(ptr < end) {
+					*ptr = recv_byte_();
+					++ptr;
+				}
+			} else {
+				while(ptr < end) {
+					*ptr = xchg_<true>();
+					++ptr;
+				}
 			}
 		}
 
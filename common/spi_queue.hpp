@@ -0,0 +1,209 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	SPI 転送キュー（割り込み駆動） @n
+			チップ・セレクト、送信、受信、完了タスクを一組の要求としてキューに積み、@n
+			タイマー割り込み等から、少しずつ転送する。@n
+			メインループは、転送の完了を待たずに、描画や演算を続けられる。@n
+			使い方： @n
+			  1. put() で要求を積む（バッファは、完了まで保持する事）@n
+			  2. 割り込み内で service() を呼ぶ @n
+			  3. 完了時に、割り込み内で task が呼ばれる @n
+			put() は、一つの側（割り込み内か、メインのどちらか）だけから @n
+			呼ぶ事（完了タスクから、次の要求を積むのは良い）。@n
+			同じバスを、ドライバー（chip/）から直接使う場合は、@n
+			sync() で、キューが空になるのを待ってから使う。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+
+namespace device {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  SPI 転送キュー・クラス
+		@param[in]	SPI		SPI 制御クラス（xchg、send、recv が必要）
+		@param[in]	QSIZE	キューの大きさ（QSIZE - 1 個まで積める）
+		@param[in]	SLICE	１回の service で転送する最大バイト数
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class SPI, uint8_t QSIZE = 4, uint8_t SLICE = 8>
+	class spi_queue {
+	public:
+
+		typedef void (*select_type)(bool ena);
+		typedef void (*task_type)(void* ctx);
+
+		//=================================================================//
+		/*!
+			@brief  転送要求
+		*/
+		//=================================================================//
+		struct request_t {
+			select_type		select;	///< チップ・セレクト（nullptr なら何もしない）
+			const uint8_t*	src;	///< 送信バッファ（nullptr なら 0xff を送る）
+			uint8_t*		dst;	///< 受信バッファ（nullptr なら捨てる）
+			uint16_t		len;	///< 転送バイト数
+			task_type		task;	///< 完了タスク（nullptr なら呼ばない）
+			void*			ctx;	///< 完了タスクへ渡す値
+		};
+
+	private:
+		SPI&		spi_;
+
+		request_t	req_[QSIZE];
+
+		volatile uint8_t	get_;
+		volatile uint8_t	put_;
+
+		uint16_t	pos_;
+		bool		select_;
+
+		void sleep_() const { asm("nop"); }
+
+		static uint8_t next_(uint8_t n) {
+			++n;
+			if(n >= QSIZE) n = 0;
+			return n;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+			@param[in]	spi	SPI 制御クラス
+		*/
+		//-----------------------------------------------------------------//
+		spi_queue(SPI& spi) : spi_(spi), req_{ }, get_(0), put_(0), pos_(0), select_(false) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	転送要求を積む
+			@param[in]	req	転送要求
+			@return キューが一杯なら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool put(const request_t& req)
+		{
+			uint8_t n = next_(put_);
+			if(n == get_) return false;
+			req_[put_] = req;
+			put_ = n;  // 要求を書き終えてから、割り込みに見せる
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	転送要求を積む
+			@param[in]	select	チップ・セレクト
+			@param[in]	src		送信バッファ
+			@param[in]	dst		受信バッファ
+			@param[in]	len		転送バイト数
+			@param[in]	task	完了タスク
+			@param[in]	ctx		完了タスクへ渡す値
+			@return キューが一杯なら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool put(select_type select, const uint8_t* src, uint8_t* dst, uint16_t len,
+			task_type task = nullptr, void* ctx = nullptr)
+		{
+			request_t t;
+			t.select = select;
+			t.src = src;
+			t.dst = dst;
+			t.len = len;
+			t.task = task;
+			t.ctx = ctx;
+			return put(t);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	未完了の要求数を取得
+			@return 要求数
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t length() const {
+			uint8_t g = get_;
+			uint8_t p = put_;
+			return p >= g ? (p - g) : (QSIZE + p - g);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	積める要求数を取得
+			@return 要求数
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t space() const { return QSIZE - 1 - length(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	転送中か検査
+			@return 転送中なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool busy() const { return get_ != put_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	全ての要求の完了を待つ
+		*/
+		//-----------------------------------------------------------------//
+		void sync() const { while(get_ != put_) sleep_(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	サービス（割り込みから呼ぶ）
+		*/
+		//-----------------------------------------------------------------//
+		void service()
+		{
+			uint8_t n = SLICE;
+			while(get_ != put_) {
+				request_t& r = req_[get_];
+				if(!select_) {
+					if(r.select != nullptr) r.select(true);
+					select_ = true;
+				}
+
+				uint16_t len = r.len - pos_;
+				if(len > n) len = n;
+				if(r.dst != nullptr) {
+					if(r.src != nullptr) {
+						for(uint16_t i = 0; i < len; ++i) {
+							r.dst[pos_ + i] = spi_.xchg(r.src[pos_ + i]);
+						}
+					} else {
+						spi_.recv(&r.dst[pos_], len);
+					}
+				} else if(r.src != nullptr) {
+					spi_.send(&r.src[pos_], len);
+				} else {
+					for(uint16_t i = 0; i < len; ++i) spi_.xchg();
+				}
+				pos_ += len;
+				n -= len;
+				if(pos_ < r.len) break;
+
+				if(r.select != nullptr) r.select(false);
+				select_ = false;
+				pos_ = 0;
+				if(r.task != nullptr) r.task(r.ctx);
+				get_ = next_(get_);
+				if(n == 0) break;
+			}
+		}
+	};
+}
@@ -0,0 +1,418 @@
+#pragma once
+//=====================================================================//
+/*! @file
+    @brief  stream_input クラス @n
+			１文字ずつ供給される入力を、書式に従って逐次解析する。@n
+			行全体をバッファリングしないので、UART の受信 fifo から @n
+			取り出した文字を、そのまま投入出来る。@n
+			%b ---> ２進の数値 @n
+			%o ---> ８進の数値 @n
+			%d ---> １０進の数値 @n
+			%x ---> １６進の数値 @n
+			%f ---> 固定小数点数（FRAC ビットの小数部） @n
+			%c ---> １文字のキャラクター @n
+			%% ---> '%' のキャラクター @n
+			[abc] ---> 文字セットのいずれか１文字 @n
+			TASK クラスには、以下の関数が必要 @n
+			void field(uint8_t idx, int32_t val);  // フィールドの変換完了 @n
+			void end(uint8_t num, stream_input_base::error err);  // 行の終端
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2017 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  stream_input 基本定義
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class stream_input_base {
+	public:
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  エラー種別
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class error : uint8_t {
+			none,			///< エラー無し
+			cha_sets,		///< 文字セットの不一致
+			partition,		///< 仕切りキャラクターの不一致
+			input_type,		///< 無効な入力タイプ
+			not_integer,	///< 整数の不一致
+			terminate,		///< 終端文字の不一致
+		};
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  ストリーム入力クラス
+		@param[in]	TASK	フィールド通知クラス
+		@param[in]	FRAC	固定小数点の小数部ビット数（最大１６）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class TASK, uint8_t FRAC = 8>
+	class stream_input : public stream_input_base {
+
+		static_assert(FRAC <= 16, "FRAC must be 16 or less");
+
+		enum class mode : uint8_t {
+			NONE,
+			BIN,
+			OCT,
+			DEC,
+			HEX,
+			REAL,
+			CHA,
+		};
+
+		enum class state : uint8_t {
+			FORM,		///< 書式の照合
+			LEAD,		///< 数値の先頭（空白、符号）
+			DIGIT,		///< 数値の整数部
+			POINT,		///< 数値の小数部
+			SKIP,		///< エラー後、行末まで読み捨て
+		};
+
+		TASK		task_;
+
+		const char*	form_org_;
+		const char*	form_;
+
+		mode		mode_;
+		state		state_;
+		error		error_;
+		uint8_t		num_;
+		bool		line_;
+		bool		neg_;
+		bool		digit_;
+
+		uint32_t	a_;
+		uint32_t	fp_;
+		uint32_t	fs_;
+
+		static const uint32_t fs_limit_ = 0xffffffff >> FRAC;
+
+		void reset_() {
+			form_ = form_org_;
+			mode_ = mode::NONE;
+			state_ = state::FORM;
+			error_ = error::none;
+			num_ = 0;
+			line_ = false;
+		}
+
+
+		void set_error_(error err) {
+			error_ = err;
+			state_ = state::SKIP;
+		}
+
+
+		void begin_number_(char type) {
+			switch(type) {
+			case 'b':
+				mode_ = mode::BIN;
+				break;
+			case 'o':
+				mode_ = mode::OCT;
+				break;
+			case 'd':
+				mode_ = mode::DEC;
+				break;
+			case 'x':
+				mode_ = mode::HEX;
+				break;
+			case 'f':
+				mode_ = mode::REAL;
+				break;
+			case 'c':
+				mode_ = mode::CHA;
+				break;
+			default:
+				set_error_(error::input_type);
+				return;
+			}
+			state_ = state::LEAD;
+			neg_ = false;
+			digit_ = false;
+			a_ = 0;
+			fp_ = 0;
+			fs_ = 1;
+		}
+
+
+		bool digit_in_(char ch) {
+			switch(mode_) {
+			case mode::BIN:
+				if(ch >= '0' && ch <= '1') {
+					a_ <<= 1;
+					a_ += ch - '0';
+					return true;
+				}
+				break;
+			case mode::OCT:
+				if(ch >= '0' && ch <= '7') {
+					a_ <<= 3;
+					a_ += ch - '0';
+					return true;
+				}
+				break;
+			case mode::DEC:
+				if(ch >= '0' && ch <= '9') {
+					a_ *= 10;
+					a_ += ch - '0';
+					return true;
+				}
+				break;
+			case mode::HEX:
+				if(ch >= '0' && ch <= '9') {
+					a_ <<= 4;
+					a_ += ch - '0';
+					return true;
+				} else if(ch >= 'A' && ch <= 'F') {
+					a_ <<= 4;
+					a_ += ch - 'A' + 10;
+					return true;
+				} else if(ch >= 'a' && ch <= 'f') {
+					a_ <<= 4;
+					a_ += ch - 'a' + 10;
+					return true;
+				}
+				break;
+			case mode::REAL:
+				if(ch >= '0' && ch <= '9') {
+					if(state_ == state::POINT) {
+						// 精度を超える桁は捨てる
+						if(fs_ <= (fs_limit_ / 10)) {
+							fp_ *= 10;
+							fp_ += ch - '0';
+							fs_ *= 10;
+						}
+					} else {
+						a_ *= 10;
+						a_ += ch - '0';
+					}
+					return true;
+				} else if(ch == '.' && state_ != state::POINT) {
+					state_ = state::POINT;
+					return true;
+				}
+				break;
+			default:
+				break;
+			}
+			return false;
+		}
+
+
+		bool end_number_() {
+			if(!digit_) {
+				set_error_(error::not_integer);
+				return false;
+			}
+			int32_t v;
+			if(mode_ == mode::REAL) {
+				uint32_t f = (fp_ << FRAC) / fs_;
+				v = static_cast<int32_t>((a_ << FRAC) | f);
+			} else {
+				v = static_cast<int32_t>(a_);
+			}
+			if(neg_) v = -v;
+			task_.field(num_, v);
+			++num_;
+			mode_ = mode::NONE;
+			state_ = state::FORM;
+			return true;
+		}
+
+
+		void form_in_(char ch) {
+			char fc = *form_;
+			if(fc == 0) {
+				set_error_(error::terminate);
+			} else if(fc == '[') {
+				const char* p = form_ + 1;
+				bool ok = false;
+				while((fc = *p) != 0) {
+					++p;
+					if(fc == ']') break;
+					if(fc == ch) ok = true;
+				}
+				form_ = p;
+				if(!ok) set_error_(error::cha_sets);
+			} else if(fc == '%' && form_[1] == '%') {
+				form_ += 2;
+				if(ch != '%') set_error_(error::partition);
+			} else if(fc == '%') {
+				++form_;
+				begin_number_(*form_);
+				if(*form_ != 0) ++form_;
+				if(state_ == state::SKIP) return;
+				if(mode_ == mode::CHA) {
+					task_.field(num_, static_cast<int32_t>(ch));
+					++num_;
+					mode_ = mode::NONE;
+					state_ = state::FORM;
+				} else {
+					number_in_(ch);
+				}
+			} else {
+				++form_;
+				if(ch != fc) set_error_(error::partition);
+			}
+		}
+
+
+		void number_in_(char ch) {
+			if(state_ == state::LEAD) {
+				if(ch == ' ') return;
+				state_ = state::DIGIT;
+				if(ch == '-') {
+					neg_ = true;
+					return;
+				} else if(ch == '+') {
+					return;
+				}
+			}
+			if(digit_in_(ch)) {
+				if(ch != '.') digit_ = true;  // 小数点だけでは数値にしない
+				return;
+			}
+			if(end_number_()) {
+				form_in_(ch);
+			}
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  コンストラクター
+			@param[in]	form	入力形式（１行分）
+		*/
+		//-----------------------------------------------------------------//
+		stream_input(const char* form = "") : task_(), form_org_(form), form_(form),
+			mode_(mode::NONE), state_(state::FORM), error_(error::none), num_(0),
+			line_(false), neg_(false), digit_(false), a_(0), fp_(0), fs_(1) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  入力形式を設定（解析状態はリセットされる）
+			@param[in]	form	入力形式（１行分）
+		*/
+		//-----------------------------------------------------------------//
+		void set_form(const char* form) {
+			form_org_ = form;
+			reset_();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  解析途中の行を破棄する
+		*/
+		//-----------------------------------------------------------------//
+		void reset() { reset_(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  １文字投入 @n
+					「CR」、「LF」で行を閉じ、TASK::end を呼ぶ
+			@param[in]	ch	文字
+		*/
+		//-----------------------------------------------------------------//
+		void put(char ch) {
+			if(ch == '\r' || ch == '\n' || ch == 0) {
+				// 空行（CR-LF の LF など）は無視
+				if(!line_) return;
+				if(state_ == state::LEAD || state_ == state::DIGIT || state_ == state::POINT) {
+					end_number_();
+				}
+				if(state_ != state::SKIP && *form_ != 0) {
+					error_ = error::terminate;
+				}
+				task_.end(num_, error_);
+				reset_();
+				return;
+			}
+
+			line_ = true;
+			switch(state_) {
+			case state::FORM:
+				form_in_(ch);
+				break;
+			case state::LEAD:
+			case state::DIGIT:
+			case state::POINT:
+				number_in_(ch);
+				break;
+			case state::SKIP:
+				break;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  文字列を投入
+			@param[in]	str	文字列
+		*/
+		//-----------------------------------------------------------------//
+		void puts(const char* str) {
+			char ch;
+			while((ch = *str++) != 0) {
+				put(ch);
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  入力デバイスから、有効な文字を全て投入 @n
+					※uart_io 等の「length」、「getch」を持つクラス
+			@param[in]	inp	入力デバイス
+		*/
+		//-----------------------------------------------------------------//
+		template <class INP>
+		void service(INP& inp) {
+			while(inp.length() > 0) {
+				put(inp.getch());
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  現在行のエラー種別を返す
+			@return エラー
+		*/
+		//-----------------------------------------------------------------//
+		error get_error() const { return error_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  現在行の正常変換数を取得
+			@return 正常変換数
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t num() const { return num_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  TASK クラスの参照
+			@return TASK クラス
+		*/
+		//-----------------------------------------------------------------//
+		TASK& at_task() { return task_; }
+	};
+}
@@ -76,10 +76,58 @@ short get_yday(short year)
 }
 
 
+// 1968 年 3 月 1 日を起点とした日数で計算する。@n
+// ※3 月始まりの年なら、うるう日は年の最後になり、4 年周期（1461 日）で表せる。@n
+// ※2100 年はうるう年ではないので、2100 年 3 月 1 日以降は、仮想的な @n
+// 2100 年 2 月 29 日を挿入して、4 年周期として扱う。（1970 〜 2106 年）
+#define DAYS_1968_MAR_TO_1970	671		///< 1968/3/1 〜 1970/1/1 の日数
+#define DAYS_1968_MAR_TO_2100	48212	///< 1968/3/1 〜 2100/3/1 の日数
+
+// 3 月 1 日からの日数（3 月始まり、月は 0:Mar 〜 11:Feb）
+static unsigned short march_yday_(unsigned char mp)
+{
+	return (153 * mp + 2) / 5;
+}
+
+
+//-----------------------------------------------------------------//
+/*!
+	@brief	1970 年 1 月 1 日からの日数から、年、月、日を得る（定数時間）
+	@param[in]	days	1970 年 1 月 1 日からの日数
+	@param[out]	t		tm 構造体（年、月、日、年内日数、曜日）
+*/
+//-----------------------------------------------------------------//
+static void civil_from_days_(unsigned short days, struct tm *t)
+{
+	unsigned short d = days + DAYS_1968_MAR_TO_1970;
+	if(d >= DAYS_1968_MAR_TO_2100) ++d;
+
+	unsigned short cyc = d / 1461;
+	unsigned short rem = d % 1461;
+	unsigned short yoe = rem / 365;
+	if(yoe > 3) yoe = 3;  // 周期の最後（2 月 29 日）
+	unsigned short doy = rem - yoe * 365;
+	unsigned char mp = (5 * doy + 2) / 153;
+
+	short year = 1968 + cyc * 4 + yoe;
+	t->tm_mday = doy - march_yday_(mp) + 1;
+	if(mp >= 10) {  // 1 月、2 月は翌年
+		++year;
+		t->tm_mon = mp - 10;
+		t->tm_yday = doy - 306;
+	} else {
+		t->tm_mon = mp + 2;
+		t->tm_yday = doy + 59 + check_leap_year(year);
+	}
+	t->tm_year = year - 1900;
+	t->tm_wday = (days + 4) % 7;
+}
+
+
 //-----------------------------------------------------------------//
 /*!
 	@brief	西暦、月から、1970 年からの総日数を得る。
-	@param[in]	year	西暦 1970 〜
+	@param[in]	year	西暦 1970 〜 2106
 	@param[in]	mon		月	[0..11]
 	@param[in]	day		日	[1..31]
 	@return		1970 年1月1日からの総日数
@@ -89,22 +137,18 @@ long get_total_day(short year, char mon, char day)
 {
 	if(year < 1970) return -1L;
 
-	long d = 0;
-	short i = 1970;
-	while(i < year) {
-		d += (long)get_yday(i);
-		i++;
+	unsigned char mp;
+	if(mon < 2) {  // 1 月、2 月は前年の 3 月始まりの年に属する
+		--year;
+		mp = mon + 10;
+	} else {
+		mp = mon - 2;
 	}
+	unsigned short y = year - 1968;
+	unsigned short d = y * 365 + y / 4 + march_yday_(mp) + day - 1;
+	if(year >= 2100) --d;
 
-	i = 0;
-	while(i < mon) {
-		d += get_mday(year, i);
-		i++;
-	}
-
-	d += day - 1;
-
-	return d;
+	return (long)(d - DAYS_1968_MAR_TO_1970);
 }
 
 
@@ -129,38 +173,17 @@ time_t get_timezone_offset(void)
 //-----------------------------------------------------------------//
 struct tm *gmtime(const time_t *tp)
 {
-	time_t	t;
-	short	i, j, k;
-
-	t = *tp;
-
-	time_st_.tm_sec  = t % (time_t)60;
-	t /= (time_t)60;
+	unsigned long t = (unsigned long)*tp;
 
-	time_st_.tm_min  = t % (time_t)60;
-	t /= (time_t)60;
+	unsigned short days = t / 86400UL;
+	unsigned long sec = t - (unsigned long)days * 86400UL;
 
-	time_st_.tm_hour = t % (time_t)24;
-	t /= (time_t)24;
+	unsigned short hm = sec / 60;
+	time_st_.tm_sec  = sec - (unsigned long)hm * 60;
+	time_st_.tm_min  = hm % 60;
+	time_st_.tm_hour = hm / 60;
 
-	time_st_.tm_wday = (t + 4) % 7;
-
-	j = 1970;
-	while(t >= (i = get_yday(j))) {
-		t -= (time_t)i;
-		j++;
-	}
-	time_st_.tm_year = j - 1900;
-
-	time_st_.tm_yday = t;
-
-	k = 0;
-	while(t >= (i = get_mday(j, k))) {
-		t -= (time_t)i;
-		k++;
-	}
-	time_st_.tm_mon = k;
-	time_st_.tm_mday = t + 1;
+	civil_from_days_(days, &time_st_);
 
 	return &time_st_;
 }
@@ -203,18 +226,16 @@ struct tm *localtime(const time_t *timer)
 //-----------------------------------------------------------------//
 time_t mktime_gmt(const struct tm *tmp)
 {
-	time_t	t;
-	long	td;
+	unsigned long t;
 
 	if(tmp == NULL) tmp = &time_st_;
 
-	t  = (time_t)tmp->tm_sec;
-	t += (time_t)(tmp->tm_min * 60);
-	t += (time_t)tmp->tm_hour * 3600L;
-	td = get_total_day(tmp->tm_year + 1900, tmp->tm_mon, tmp->tm_mday);
-	t += (time_t)td * 86400L;
+	t  = (unsigned long)get_total_day(tmp->tm_year + 1900, tmp->tm_mon, tmp->tm_mday) * 86400UL;
+	t += (unsigned long)tmp->tm_hour * 3600UL;
+	t += (unsigned short)tmp->tm_min * 60;
+	t += tmp->tm_sec;
 
-	return t;
+	return (time_t)t;
 }
 
 
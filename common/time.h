@@ -66,7 +66,7 @@ short get_yday(short year);
 //-----------------------------------------------------------------//
 /*!
 	@brief	西暦、月から、1970 年からの総日数を得る。
-	@param[in]	year	西暦 1970 〜
+	@param[in]	year	西暦 1970 〜 2106
 	@param[in]	mon		月	[0..11]
 	@param[in]	day		日	[1..31]
 	@return		1970 年1月1日からの総日数
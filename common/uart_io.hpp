@@ -1,7 +1,10 @@
 #pragma once
 //=====================================================================//
 /*!	@file
-	@brief	R8C グループ・UART I/O 制御
+	@brief	R8C グループ・UART I/O 制御 @n
+			write() は、送信バッファの空きに、まとめて書き込む。@n
+			write_ref() は、呼び出し側のバッファから、割り込みで直接送信する。@n
+			（バッファは、ref_busy() が「false」になるまで保持する事）
     @author 平松邦仁 (hira@rvf-rc45.net)
 	@copyright	Copyright (C) 2015, 2021 Kunihito Hiramatsu @n
 				Released under the MIT license @n
@@ -57,6 +60,8 @@ namespace device {
 		static SEND	send_;
 		static RECV	recv_;
 		static volatile bool	send_stall_;
+		static const char* volatile	ref_ptr_;
+		static volatile uint16_t	ref_len_;
 		bool	crlf_;
 		uint8_t	ubrg_;
 
@@ -93,6 +98,11 @@ namespace device {
 		{
 			if(send_.length()) {
 				UART::UTBL = send_.get();
+			} else if(ref_len_ != 0) {
+				const char* p = ref_ptr_;
+				UART::UTBL = *p;
+				ref_ptr_ = p + 1;
+				--ref_len_;
 			} else {
 				send_stall_ = true;
 			}
@@ -108,16 +118,31 @@ private:
 		}
 
 		void send_restart_() {
-			if(send_stall_ && send_.length() > 0) {
+			if(!send_stall_) return;
+			char ch;
+			if(send_.length() > 0) {
 				while(UART::UC1.TI() == 0) sleep_();
-				char ch = send_.get();
-				send_stall_ = false;
-				UART::UTBL = ch;
+				ch = send_.get();
+			} else if(ref_len_ != 0) {
+				while(UART::UC1.TI() == 0) sleep_();
+				ch = *ref_ptr_;
+				++ref_ptr_;
+				--ref_len_;
+			} else {
+				return;
 			}
+			send_stall_ = false;
+			UART::UTBL = ch;
+		}
+
+		// write_ref の転送中は、順番を守る為、完了を待つ
+		void sync_ref_() const {
+			while(ref_len_ != 0) sleep_();
 		}
 
 		void putch_(char ch) {
 			if(UART::UIR.UTIE()) {
+				sync_ref_();
 				/// ７／８ を超えてた場合は、バッファが空になるまで待つ。
 				/// ※ヒステリシス動作
 				if(send_.length() >= (send_.size() * 7 / 8)) {
@@ -135,6 +160,31 @@ private:
 		}
 
 
+		void write_(const char* src, uint16_t num) {
+			if(UART::UIR.UTIE()) {
+				sync_ref_();
+				while(num > 0) {
+					uint16_t n = send_.size() - 1 - send_.length();  // 空き
+					if(n == 0) {
+						send_restart_();
+						sleep_();
+						continue;
+					}
+					if(n > num) n = num;
+					send_.put(src, n);
+					src += n;
+					num -= n;
+					send_restart_();
+				}
+			} else {
+				for(uint16_t i = 0; i < num; ++i) {
+					while(UART::UC1.TI() == 0) sleep_();
+					UART::UTBL = src[i];
+				}
+			}
+		}
+
+
 	public:
 		//-----------------------------------------------------------------//
 		/*!
@@ -267,13 +317,61 @@ private:
 		 */
 		//-----------------------------------------------------------------//
 		void puts(const char* ptr) {
-			char ch;
-			while((ch = *ptr++) != 0) {
-				putch(ch);
+			for(;;) {  // 改行までを、まとめて書き込む
+				const char* top = ptr;
+				while(*ptr != 0 && *ptr != '\n') ++ptr;
+				write_(top, ptr - top);
+				if(*ptr == 0) break;
+				putch(*ptr);
+				++ptr;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	UART ブロック出力（CRLF の変換はしない）
+			@param[in]	src	送信元
+			@param[in]	num	バイト数
+		 */
+		//-----------------------------------------------------------------//
+		void write(const void* src, uint16_t num) {
+			write_(static_cast<const char*>(src), num);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	UART ブロック出力（バッファから直接送信） @n
+					送信バッファを経由しないので、コピーが無い。@n
+					前の write_ref が完了していない場合は、完了を待つ。@n
+					割り込みを使わない場合は、write と同じ。
+			@param[in]	src	送信元（ref_busy() が「false」になるまで保持する事）
+			@param[in]	num	バイト数
+		 */
+		//-----------------------------------------------------------------//
+		void write_ref(const void* src, uint16_t num) {
+			if(num == 0) return;
+			if(UART::UIR.UTIE()) {
+				sync_ref_();
+				ref_ptr_ = static_cast<const char*>(src);
+				ref_len_ = num;  // ポインターを設定してから、割り込みに見せる
+				send_restart_();
+			} else {
+				write_(static_cast<const char*>(src), num);
 			}
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	write_ref のバッファを使っているか
+			@return	使っている場合「true」
+		 */
+		//-----------------------------------------------------------------//
+		bool ref_busy() const { return ref_len_ != 0; }
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	UART 入力文字数を取得
@@ -327,4 +425,8 @@ private:
 		RECV uart_io<UART, SEND, RECV>::recv_;
 	template<class UART, class SEND, class RECV>
 		volatile bool uart_io<UART, SEND, RECV>::send_stall_ = true;
+	template<class UART, class SEND, class RECV>
+		const char* volatile uart_io<UART, SEND, RECV>::ref_ptr_ = nullptr;
+	template<class UART, class SEND, class RECV>
+		volatile uint16_t uart_io<UART, SEND, RECV>::ref_len_ = 0;
 }
@@ -0,0 +1,288 @@
+//=====================================================================//
+/*!	@file
+	@brief	common/command_dispatch.hpp の検査 @n
+			sci_putch、sci_getch などをホストの文字列で置き換え、command @n
+			クラスに行を入力して、ディスパッチ結果を検査する。@n
+			・ハッシュの衝突と探索（HSIZE 8 に７コマンド、HSIZE 16 と比較、@n
+			　全て同じ位置に入る４コマンド） @n
+			・登録されていないコマンド（前方一致、長い名前） @n
+			・引数の数の最小、最大と、max_words を超えるワード数 @n
+			・TAB による候補の巡回（injection_tab） @n
+			使い方： dispatch_test [-v]
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <string>
+#include <cstdint>
+
+namespace {
+	std::string	in_;		///< command が読む文字
+	std::string	called_;	///< 呼ばれた処理関数
+}
+
+extern "C" {
+	void sci_putch(char ch) { }
+	void sci_puts(const char* str) { }
+	char sci_getch(void) {
+		char ch = in_[0];
+		in_.erase(0, 1);
+		return ch;
+	}
+	uint16_t sci_length(void) { return in_.size(); }
+};
+
+#include "common/command.hpp"
+#include "common/command_dispatch.hpp"
+
+namespace {
+
+	bool help_(const utils::command_args& args) { called_ = "help"; return true; }
+	bool read_(const utils::command_args& args) { called_ = "read"; return true; }
+	bool reset_(const utils::command_args& args) { called_ = "reset"; return true; }
+	bool rd_(const utils::command_args& args) { called_ = "rd"; return true; }
+	bool rdx_(const utils::command_args& args) { called_ = "rdx"; return true; }
+	bool echo_(const utils::command_args& args) {
+		called_ = "echo";
+		char tmp[16];
+		for(uint8_t i = 1; i < args.get_words(); ++i) {
+			args.get_word(i, sizeof(tmp), tmp);
+			called_ += " ";
+			called_ += tmp;
+		}
+		return true;
+	}
+	bool fail_(const utils::command_args& args) { called_ = "fail"; return false; }
+	bool name_(const utils::command_args& args) {
+		char tmp[16];
+		args.get_word(0, sizeof(tmp), tmp);
+		called_ = tmp;
+		return true;
+	}
+
+	// HSIZE 8 に７コマンド（空きは一つ）
+	constexpr utils::command_entry cmd_tbl_[] = {
+		utils::make_command("help",  0, 0, help_),
+		utils::make_command("read",  1, 2, read_),
+		utils::make_command("reset", 0, 0, reset_),
+		utils::make_command("rd",    0, 1, rd_),
+		utils::make_command("rdx",   0, 1, rdx_),
+		utils::make_command("echo",  0, 7, echo_),
+		utils::make_command("fail",  0, 0, fail_),
+	};
+
+	// HSIZE 8 で、全て同じ位置（７）に入る名前（探索は 7、0、1、2 と一周する）
+	constexpr utils::command_entry col_tbl_[] = {
+		utils::make_command("c0",  0, 0, name_),
+		utils::make_command("c8",  0, 0, name_),
+		utils::make_command("c15", 0, 0, name_),
+		utils::make_command("c24", 0, 0, name_),
+	};
+
+	typedef utils::command<64, 0> command;
+	typedef utils::command_dispatch<command, 8> dispatch8;
+	typedef utils::command_dispatch<command, 16> dispatch16;
+
+	const char* result_str_(dispatch8::result r)
+	{
+		switch(r) {
+		case dispatch8::result::none:      return "none";
+		case dispatch8::result::ok:        return "ok";
+		case dispatch8::result::empty:     return "empty";
+		case dispatch8::result::unknown:   return "unknown";
+		case dispatch8::result::arg_count: return "arg_count";
+		case dispatch8::result::fail:      return "fail";
+		}
+		return "?";
+	}
+
+	struct line_t {
+		const char*			line;
+		dispatch8::result	res;
+		const char*			called;
+	};
+
+	const line_t lines_[] = {
+		{ "help",                   dispatch8::result::ok,        "help" },
+		{ "  help  ",               dispatch8::result::ok,        "help" },
+		{ "help 1",                 dispatch8::result::arg_count, "" },
+		{ "read",                   dispatch8::result::arg_count, "" },
+		{ "read 0",                 dispatch8::result::ok,        "read" },
+		{ "read 0 8",               dispatch8::result::ok,        "read" },
+		{ "read 0 8 x",             dispatch8::result::arg_count, "" },
+		{ "reset",                  dispatch8::result::ok,        "reset" },
+		{ "rd",                     dispatch8::result::ok,        "rd" },
+		{ "rdx 1",                  dispatch8::result::ok,        "rdx" },
+		{ "fail",                   dispatch8::result::fail,      "fail" },
+		{ "echo 1 2 3 4 5 6 7",     dispatch8::result::ok,        "echo 1 2 3 4 5 6 7" },
+		{ "echo 1 2 3 4 5 6 7 8",   dispatch8::result::arg_count, "" },
+		{ "r",                      dispatch8::result::unknown,   "" },
+		{ "rea",                    dispatch8::result::unknown,   "" },
+		{ "readx",                  dispatch8::result::unknown,   "" },
+		{ "rdxx",                   dispatch8::result::unknown,   "" },
+		{ "HELP",                   dispatch8::result::unknown,   "" },
+		{ "",                       dispatch8::result::empty,     "" },
+		{ "   ",                    dispatch8::result::empty,     "" },
+	};
+
+	template <class DISP>
+	uint32_t check_lines_(const char* title, bool verbose)
+	{
+		command cmd;
+		DISP disp(cmd, cmd_tbl_);
+		uint32_t err = 0;
+		for(const auto& t : lines_) {
+			in_ = t.line;
+			in_ += '\r';
+			called_.clear();
+			auto r = disp.service();
+			bool ok = static_cast<uint8_t>(r) == static_cast<uint8_t>(t.res)
+				&& called_ == t.called;
+			if(!ok) ++err;
+			if(!ok || verbose) {
+				std::cout << "  " << (ok ? "OK  " : "NG  ") << title << " \"" << t.line << "\": "
+					<< result_str_(static_cast<dispatch8::result>(r)) << " (" << called_ << ")"
+					<< std::endl;
+			}
+		}
+		return err;
+	}
+
+
+	// 入力してディスパッチ（行は閉じない）
+	std::string type_(command& cmd, dispatch8& disp, const char* text)
+	{
+		in_ = text;
+		disp.service();
+		return cmd.get_command();
+	}
+
+
+	uint32_t check_collision_(bool verbose)
+	{
+		static const char* names[] = { "c0", "c8", "c15", "c24", "c30", "c38" };
+		command cmd;
+		dispatch8 disp(cmd, col_tbl_);
+		uint32_t err = 0;
+		for(uint32_t i = 0; i < 6; ++i) {
+			bool known = i < 4;  // c30、c38 も同じ位置だが、登録されていない
+			in_ = names[i];
+			in_ += '\r';
+			called_.clear();
+			auto r = disp.service();
+			bool ok = known ? (r == dispatch8::result::ok && called_ == names[i])
+				: (r == dispatch8::result::unknown && called_.empty());
+			if(!ok) ++err;
+			if(!ok || verbose) {
+				std::cout << "  " << (ok ? "OK  " : "NG  ") << "collision \"" << names[i] << "\": "
+					<< result_str_(r) << " (" << called_ << ")" << std::endl;
+			}
+		}
+		return err;
+	}
+
+
+	uint32_t check_tab_(bool verbose)
+	{
+		struct tab_t {
+			const char*	input;
+			const char*	line;	///< 入力後の行
+		};
+		// "re" の候補は、テーブル順に read、reset
+		static const tab_t steps[] = {
+			{ "re\t",  "read" },
+			{ "\t",    "reset" },
+			{ "\t",    "read" },
+			{ "\t",    "reset" },
+			{ " 1",    "reset 1" },
+			{ "\t",    "reset 1" },		// 引数の位置では補完しない
+		};
+		command cmd;
+		dispatch8 disp(cmd, cmd_tbl_);
+		uint32_t err = 0;
+		for(const auto& s : steps) {
+			std::string line = type_(cmd, disp, s.input);
+			bool ok = line == s.line;
+			if(!ok) ++err;
+			if(!ok || verbose) {
+				std::cout << "  " << (ok ? "OK  " : "NG  ") << "TAB \""
+					<< (s.input[0] == '\t' ? "\\t" : s.input) << "\": \"" << line << "\""
+					<< std::endl;
+			}
+		}
+		// 行を閉じて、補完したコマンドを実行
+		in_ = "\x08\x08\r";
+		called_.clear();
+		auto r = disp.service();
+		if(r != dispatch8::result::ok || called_ != "reset") {
+			std::cout << "  NG  TAB enter: " << result_str_(r) << " (" << called_ << ")" << std::endl;
+			++err;
+		}
+
+		// "rd" は、rd 自身を除き rdx だけ
+		command cmd2;
+		dispatch8 disp2(cmd2, cmd_tbl_);
+		std::string a = type_(cmd2, disp2, "rd\t");
+		std::string b = type_(cmd2, disp2, "\t");
+		if(a != "rdx" || b != "rdx") {
+			std::cout << "  NG  TAB \"rd\": \"" << a << "\", \"" << b << "\"" << std::endl;
+			++err;
+		}
+		return err;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	bool verbose = false;
+	for(int i = 1; i < argc; ++i) {
+		std::string s = argv[i];
+		if(s == "-v") {
+			verbose = true;
+		} else {
+			std::cout << "command_dispatch test" << std::endl;
+			std::cout << "usage: " << argv[0] << " [-v]" << std::endl;
+			return 0;
+		}
+	}
+
+	uint32_t err = 0;
+
+	// ホーム位置に入らなかった（探索した）コマンド数
+	uint32_t probe = 0;
+	{
+		bool used[8] = { false };
+		for(const auto& e : cmd_tbl_) {
+			uint8_t i = e.hash & 7;
+			if(used[i]) ++probe;
+			while(used[i]) i = (i + 1) & 7;
+			used[i] = true;
+		}
+	}
+	std::cout << "Commands: " << (sizeof(cmd_tbl_) / sizeof(cmd_tbl_[0]))
+		<< ", HSIZE 8 probed: " << probe << std::endl;
+	if(probe == 0) {
+		std::cout << "  NG  no hash collision in HSIZE 8" << std::endl;
+		++err;
+	}
+
+	uint32_t e = check_lines_<dispatch8>("HSIZE 8", verbose);
+	e += check_lines_<dispatch16>("HSIZE 16", verbose);
+	std::cout << "dispatch:  " << (e == 0 ? "OK" : "NG") << std::endl;
+	err += e;
+
+	e = check_collision_(verbose);
+	std::cout << "collision: " << (e == 0 ? "OK" : "NG") << std::endl;
+	err += e;
+
+	e = check_tab_(verbose);
+	std::cout << "TAB:       " << (e == 0 ? "OK" : "NG") << std::endl;
+	err += e;
+
+	std::cout << (err == 0 ? "Pass" : "Fail") << std::endl;
+	return err != 0 ? 1 : 0;
+}
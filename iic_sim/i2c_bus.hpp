@@ -0,0 +1,365 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	I2C バス・シミュレーター（ホスト用） @n
+			オープン・ドレインの SDA、SCL を、マスターとスレーブの出力の @n
+			ワイヤード AND として再現し、エッジ毎にスレーブを動かす。@n
+			スレーブは、レジスタ・アドレス（１、２バイト）付きのメモリで、@n
+			クロック・ストレッチと、書き込み後のビジー（アドレス NACK）を持つ。@n
+			スタート、リピーテッド・スタート、ストップ、SCL のクロック数と、@n
+			バイトの途中でのスタート／ストップ（プロトコル違反）を数える。@n
+			sda_port<>、scl_port<> は、device::iica_io、device::iica_queue の @n
+			ポート定義クラスとして使う。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <vector>
+
+namespace sim {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	I2C バス・シミュレーター・クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class i2c_bus {
+	public:
+		//=================================================================//
+		/*!
+			@brief	スレーブ・デバイス
+		*/
+		//=================================================================//
+		struct device_t {
+			uint8_t		address;		///< スレーブアドレス（７ビット）
+			uint8_t		addr_bytes;		///< レジスタ・アドレスのバイト数
+			uint16_t	stretch;		///< ACK の後、SCL を「L」に保持する tick 数
+			uint16_t	write_busy;		///< 書き込み後、NACK を返す tick 数
+			uint8_t		write_limit;	///< 受け付けるデータのバイト数（超えると NACK、０なら制限無し）
+			std::vector<uint8_t>	mem;
+
+			uint16_t	ptr;
+			uint16_t	busy;
+		};
+
+	private:
+		enum class state : uint8_t {
+			idle,
+			addr,
+			write,
+			read,
+			ignore,
+		};
+
+		std::vector<device_t>	devs_;
+
+		bool	m_sda_;
+		bool	m_sda_dir_;
+		bool	m_scl_;
+		bool	m_scl_dir_;
+
+		bool	s_sda_;
+		uint16_t	hold_;
+		bool	read_tick_;
+
+		bool	sda_;
+		bool	scl_;
+
+		state	state_;
+		device_t*	dev_;
+		uint8_t	bit_;
+		uint8_t	sh_;
+		uint8_t	out_;
+		bool	ack_;
+		bool	clk_;		///< SCL の立上りの後（スタート直後の立下りは数えない）
+		uint8_t	count_;		///< 書き込みバイト数（アドレスを含む）
+
+		uint32_t	starts_;
+		uint32_t	restarts_;
+		uint32_t	stops_;
+		uint32_t	clocks_;
+		uint32_t	bytes_;
+		uint32_t	violations_;
+		uint64_t	ticks_;
+
+		bool line_sda_() const { return (m_sda_dir_ ? m_sda_ : true) && s_sda_; }
+		bool line_scl_() const { return (m_scl_dir_ ? m_scl_ : true) && hold_ == 0; }
+
+		device_t* find_(uint8_t adr) {
+			for(auto& d : devs_) {
+				if(d.address == adr) return &d;
+			}
+			return nullptr;
+		}
+
+		void start_() {
+			if(state_ != state::idle && state_ != state::ignore && bit_ != 0) ++violations_;
+			if(state_ != state::idle) ++restarts_;
+			else ++starts_;
+			state_ = state::addr;
+			bit_ = 0;
+			sh_ = 0;
+			clk_ = false;
+			s_sda_ = true;
+		}
+
+		void stop_() {
+			if(state_ != state::idle && state_ != state::ignore && bit_ != 0) ++violations_;
+			if(state_ == state::write && dev_ != nullptr && count_ > (1 + dev_->addr_bytes)) {
+				dev_->busy = dev_->write_busy;
+			}
+			if(state_ != state::idle) ++stops_;
+			state_ = state::idle;
+			s_sda_ = true;
+		}
+
+		// バイトの８ビット目の立下りで、ACK を決める
+		void byte_() {
+			ack_ = false;
+			if(state_ == state::addr) {
+				dev_ = find_(sh_ >> 1);
+				if(dev_ == nullptr || dev_->busy > 0) {
+					state_ = state::ignore;
+					return;
+				}
+				state_ = (sh_ & 1) ? state::read : state::write;
+				count_ = 1;
+				ack_ = true;
+			} else if(state_ == state::write) {
+				if(dev_->write_limit > 0 && count_ > (dev_->addr_bytes + dev_->write_limit)) {
+					return;  // NACK
+				}
+				if(count_ <= dev_->addr_bytes) {
+					if(count_ == 1) dev_->ptr = 0;
+					dev_->ptr = (dev_->ptr << 8) | sh_;
+				} else {
+					dev_->mem[dev_->ptr % dev_->mem.size()] = sh_;
+					++dev_->ptr;
+				}
+				++count_;
+				++bytes_;
+				ack_ = true;
+			}
+		}
+
+		void rise_() {
+			++clocks_;
+			clk_ = true;
+			if(state_ == state::addr || state_ == state::write) {
+				if(bit_ < 8) sh_ = (sh_ << 1) | (sda_ ? 1 : 0);
+			} else if(state_ == state::read && bit_ == 8) {
+				if(sda_) state_ = state::ignore;  // NACK で送信終了
+			}
+		}
+
+		void fall_() {
+			if(state_ == state::idle || state_ == state::ignore || !clk_) return;
+			clk_ = false;
+			if(bit_ < 8) {
+				++bit_;
+				if(bit_ == 8) {
+					if(state_ == state::read) {
+						s_sda_ = true;  // マスターの ACK
+						++bytes_;
+					} else {
+						byte_();
+						s_sda_ = !ack_;
+					}
+				} else if(state_ == state::read) {
+					s_sda_ = ((out_ >> (7 - bit_)) & 1) != 0;
+				}
+			} else {
+				bit_ = 0;
+				sh_ = 0;
+				s_sda_ = true;
+				if(dev_ != nullptr) hold_ = dev_->stretch;
+				if(state_ == state::read) {
+					out_ = dev_->mem[dev_->ptr % dev_->mem.size()];
+					++dev_->ptr;
+					s_sda_ = (out_ & 0x80) != 0;
+				}
+			}
+		}
+
+		void update_() {
+			for(;;) {
+				bool sda = line_sda_();
+				bool scl = line_scl_();
+				if(sda == sda_ && scl == scl_) return;
+				bool psda = sda_;
+				bool pscl = scl_;
+				sda_ = sda;
+				scl_ = scl;
+				if(pscl && scl) {
+					if(psda && !sda) start_();
+					else if(!psda && sda) stop_();
+				} else if(!pscl && scl) {
+					rise_();
+				} else if(pscl && !scl) {
+					fall_();
+				}
+			}
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		i2c_bus() : m_sda_(true), m_sda_dir_(true), m_scl_(true), m_scl_dir_(true),
+			s_sda_(true), hold_(0), read_tick_(true), sda_(true), scl_(true),
+			state_(state::idle), dev_(nullptr), bit_(0), sh_(0), out_(0), ack_(false), clk_(false), count_(0),
+			starts_(0), restarts_(0), stops_(0), clocks_(0), bytes_(0), violations_(0), ticks_(0) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	スレーブを追加
+			@param[in]	address		スレーブアドレス（７ビット）
+			@param[in]	size		メモリの大きさ
+			@param[in]	addr_bytes	レジスタ・アドレスのバイト数
+			@param[in]	stretch		クロック・ストレッチの tick 数
+			@param[in]	write_busy	書き込み後のビジーの tick 数
+			@param[in]	write_limit	受け付けるデータのバイト数（０なら制限無し）
+			@return スレーブ
+		*/
+		//-----------------------------------------------------------------//
+		device_t& add(uint8_t address, uint16_t size, uint8_t addr_bytes = 1,
+			uint16_t stretch = 0, uint16_t write_busy = 0, uint8_t write_limit = 0)
+		{
+			device_t d;
+			d.address = address;
+			d.addr_bytes = addr_bytes;
+			d.stretch = stretch;
+			d.write_busy = write_busy;
+			d.write_limit = write_limit;
+			d.mem.resize(size);
+			for(uint16_t i = 0; i < size; ++i) d.mem[i] = i * 7 + 3;
+			d.ptr = 0;
+			d.busy = 0;
+			devs_.push_back(d);
+			dev_ = nullptr;
+			return devs_.back();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	時間を進める（ストレッチ、ビジーの計時）
+		*/
+		//-----------------------------------------------------------------//
+		void tick()
+		{
+			++ticks_;
+			for(auto& d : devs_) {
+				if(d.busy > 0) --d.busy;
+			}
+			if(hold_ > 0) {
+				--hold_;
+				update_();
+			}
+		}
+
+
+		void set_sda(bool v) { m_sda_ = v; update_(); }
+		void set_sda_dir(bool v) { m_sda_dir_ = v; update_(); }
+		void set_scl(bool v) { m_scl_ = v; update_(); }
+		void set_scl_dir(bool v) { m_scl_dir_ = v; update_(); }
+		bool get_sda() const { return line_sda_(); }
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	SCL を読む @n
+					ストレッチ中は、読む度に時間を進める（iica_io の wait_ 用）
+			@return SCL の状態
+		*/
+		//-----------------------------------------------------------------//
+		bool get_scl() {
+			bool f = line_scl_();
+			if(hold_ > 0 && read_tick_) tick();
+			return f;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	SCL の読み出しで、時間を進めるか設定 @n
+					（割り込み駆動の場合は、tick() だけで時間を進める）
+			@param[in]	ena	進めない場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		void set_read_tick(bool ena) { read_tick_ = ena; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	カウンターをリセット
+		*/
+		//-----------------------------------------------------------------//
+		void reset_count() {
+			starts_ = 0;
+			restarts_ = 0;
+			stops_ = 0;
+			clocks_ = 0;
+			bytes_ = 0;
+			violations_ = 0;
+			ticks_ = 0;
+		}
+
+
+		uint32_t get_starts() const { return starts_; }
+		uint32_t get_restarts() const { return restarts_; }
+		uint32_t get_stops() const { return stops_; }
+		uint32_t get_clocks() const { return clocks_; }
+		uint32_t get_bytes() const { return bytes_; }
+		uint32_t get_violations() const { return violations_; }
+		uint64_t get_ticks() const { return ticks_; }
+		bool is_idle() const { return state_ == state::idle && sda_ && scl_; }
+	};
+
+
+	// ポート定義クラス（iica_io、iica_queue から使う）
+	template <i2c_bus& BUS>
+	struct sda_port {
+		struct p_t {
+			void operator = (bool v) { BUS.set_sda(v); }
+			bool operator () () const { return BUS.get_sda(); }
+		};
+		struct dir_t {
+			void operator = (bool v) { BUS.set_sda_dir(v); }
+		};
+		struct od_t {
+			void operator = (bool v) { }
+		};
+		static p_t		P;
+		static dir_t	DIR;
+		static od_t		OD;
+	};
+	template <i2c_bus& BUS> typename sda_port<BUS>::p_t sda_port<BUS>::P;
+	template <i2c_bus& BUS> typename sda_port<BUS>::dir_t sda_port<BUS>::DIR;
+	template <i2c_bus& BUS> typename sda_port<BUS>::od_t sda_port<BUS>::OD;
+
+
+	template <i2c_bus& BUS>
+	struct scl_port {
+		struct p_t {
+			void operator = (bool v) { BUS.set_scl(v); }
+			bool operator () () const { return BUS.get_scl(); }
+		};
+		struct dir_t {
+			void operator = (bool v) { BUS.set_scl_dir(v); }
+		};
+		struct od_t {
+			void operator = (bool v) { }
+		};
+		static p_t		P;
+		static dir_t	DIR;
+		static od_t		OD;
+	};
+	template <i2c_bus& BUS> typename scl_port<BUS>::p_t scl_port<BUS>::P;
+	template <i2c_bus& BUS> typename scl_port<BUS>::dir_t scl_port<BUS>::DIR;
+	template <i2c_bus& BUS> typename scl_port<BUS>::od_t scl_port<BUS>::OD;
+}
@@ -0,0 +1,230 @@
+//=====================================================================//
+/*!	@file
+	@brief	I2C バス・シミュレーターで、iica_io と iica_queue を評価する @n
+			センサー（MPU6050 相当）のレジスタ読み出しと、EEPROM の書き込み、@n
+			書き込み完了のポーリング、読み出しを行い、データの一致、@n
+			スタート／ストップの数、プロトコル違反の有無、SCL のクロック数、@n
+			割り込み（service）の回数を表示する。@n
+			使い方： iic_sim [-rate Hz] [-stretch ticks] [-busy ticks]
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include "i2c_bus.hpp"
+#include "common/iica_io.hpp"
+#include "common/iica_queue.hpp"
+
+namespace {
+
+	sim::i2c_bus	bus_;
+
+	typedef sim::sda_port<bus_> SDA;
+	typedef sim::scl_port<bus_> SCL;
+
+	typedef device::iica_io<SDA, SCL> IICA;
+	IICA	iica_;
+
+	typedef device::iica_queue<SDA, SCL, 8> QUEUE;
+	QUEUE	queue_;
+
+	static const uint8_t SENSOR_ADR = 0x68;
+	static const uint8_t EEPROM_ADR = 0x50;
+	static const uint8_t NONE_ADR = 0x30;
+	static const uint8_t LIMIT_ADR = 0x40;
+
+	uint32_t	done_;
+	QUEUE::error	err_;
+
+	void task_(void* ctx, QUEUE::error err)
+	{
+		++done_;
+		err_ = err;
+		if(ctx != nullptr) *static_cast<QUEUE::error*>(ctx) = err;
+	}
+
+
+	bool check_(const char* title, bool ok)
+	{
+		std::cout << std::left << std::setw(24) << title << std::right
+			<< (ok ? "OK  " : "NG  ")
+			<< " START:" << bus_.get_starts() << " RESTART:" << bus_.get_restarts()
+			<< " STOP:" << bus_.get_stops() << " SCL:" << bus_.get_clocks()
+			<< " bytes:" << bus_.get_bytes() << " violation:" << bus_.get_violations();
+		if(bus_.get_ticks() > 0) std::cout << " ticks:" << bus_.get_ticks();
+		std::cout << std::endl;
+		return ok && bus_.get_violations() == 0;
+	}
+
+
+	// キューが空になるまで、割り込みを回す
+	uint32_t run_()
+	{
+		uint32_t n = 0;
+		while(queue_.busy()) {
+			queue_.service();
+			bus_.tick();
+			++n;
+			if(n > 1000000) break;
+		}
+		return n;
+	}
+
+
+	bool expect_(const uint8_t* dst, uint16_t reg, uint8_t num)
+	{
+		for(uint8_t i = 0; i < num; ++i) {
+			if(dst[i] != static_cast<uint8_t>((reg + i) * 7 + 3)) return false;
+		}
+		return true;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	uint32_t rate = 20000;
+	uint16_t stretch = 0;
+	uint16_t busy = 100;
+	for(int i = 1; i < argc; ++i) {
+		std::string s = argv[i];
+		if(s == "-rate" && (i + 1) < argc) {
+			rate = std::atoi(argv[++i]);
+			if(rate == 0) rate = 1;
+		} else if(s == "-stretch" && (i + 1) < argc) {
+			stretch = std::atoi(argv[++i]);
+		} else if(s == "-busy" && (i + 1) < argc) {
+			busy = std::atoi(argv[++i]);
+		} else {
+			std::cout << "I2C bus simulator for iica_io / iica_queue" << std::endl;
+			std::cout << "usage: " << argv[0] << " [-rate Hz] [-stretch ticks] [-busy ticks]" << std::endl;
+			return 0;
+		}
+	}
+
+	bus_.add(SENSOR_ADR, 128, 1, stretch, 0);
+	bus_.add(EEPROM_ADR, 4096, 2, stretch, 200);
+	bus_.add(LIMIT_ADR, 16, 1, stretch, 0, 1);  // ２バイト目のデータから NACK
+
+	int err = 0;
+	uint8_t reg = 0x3B;
+	uint8_t dst[16];
+
+	// ブロッキング（iica_io）
+	iica_.start(IICA::speed::fast);
+	iica_.set_busy(stretch + 10);
+	bus_.reset_count();
+	bool ok = iica_.write_then_read(SENSOR_ADR, reg, dst, 14);
+	if(!check_("iica_io write_then_read", ok && expect_(dst, reg, 14))) ++err;
+	uint32_t clocks = bus_.get_clocks();
+	std::cout << "  CPU busy (fast, 4us/bit): " << clocks * 4 << " us" << std::endl;
+
+	bus_.reset_count();
+	ok = iica_.send(SENSOR_ADR, &reg, 1) && iica_.recv(SENSOR_ADR, dst, 14);
+	if(!check_("iica_io send + recv", ok && expect_(dst, reg, 14))) ++err;
+
+	// 割り込み駆動（iica_queue）
+	bus_.set_read_tick(false);
+	queue_.start();
+	queue_.set_busy(busy);
+	bus_.reset_count();
+	done_ = 0;
+	queue_.put(SENSOR_ADR, &reg, dst, 14, task_);
+	uint32_t n = run_();
+	if(!check_("iica_queue read", done_ == 1 && err_ == QUEUE::error::none
+		&& expect_(dst, reg, 14))) ++err;
+	std::cout << "  service: " << n << " calls, " << std::fixed << std::setprecision(4)
+		<< static_cast<double>(14) / static_cast<double>(n) << " bytes/call, "
+		<< std::setprecision(0) << static_cast<double>(n) * 1e6 / rate << " us at "
+		<< rate << " Hz (SCL " << rate / 2 << " Hz)" << std::endl;
+
+	// EEPROM：書き込み、完了のポーリング、読み出しを、まとめて積む
+	static const uint8_t wr[2 + 16] = {
+		0x01, 0x20,
+		0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7,
+		0xA8, 0xA9, 0xAA, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF
+	};
+	bus_.reset_count();
+	done_ = 0;
+	QUEUE::error werr = QUEUE::error::stall;
+	QUEUE::request_t t = { EEPROM_ADR, wr, sizeof(wr), nullptr, 0, task_, &werr };
+	queue_.put(t);
+	n = run_();
+	uint32_t poll = 0;
+	for(;;) {  // アドレスだけ送り、ACK が返るまで待つ
+		QUEUE::error perr = QUEUE::error::none;
+		QUEUE::request_t p = { EEPROM_ADR, nullptr, 0, nullptr, 0, task_, &perr };
+		queue_.put(p);
+		n += run_();
+		++poll;
+		if(perr == QUEUE::error::none || poll > 1000) break;
+	}
+	uint8_t rd[16];
+	QUEUE::request_t r = { EEPROM_ADR, wr, 2, rd, 16, task_, nullptr };
+	queue_.put(r);
+	n += run_();
+	bool eq = werr == QUEUE::error::none && err_ == QUEUE::error::none;
+	for(uint8_t i = 0; i < 16; ++i) {
+		if(rd[i] != wr[2 + i]) eq = false;
+	}
+	if(!check_("iica_queue EEPROM", eq)) ++err;
+	std::cout << "  service: " << n << " calls, polls: " << poll << std::endl;
+
+	// 居ないアドレス
+	bus_.reset_count();
+	done_ = 0;
+	queue_.put(NONE_ADR, &reg, dst, 2, task_);
+	run_();
+	if(!check_("iica_queue NACK", done_ == 1 && err_ == QUEUE::error::address
+		&& bus_.is_idle())) ++err;
+
+	bus_.reset_count();
+	bus_.set_read_tick(true);
+	ok = iica_.write_then_read(NONE_ADR, reg, dst, 2);
+	if(!check_("iica_io NACK", !ok && iica_.get_last_error() == IICA::error::address
+		&& bus_.is_idle())) ++err;
+
+	// データの NACK でも、ストップ・コンディションは一回だけ
+	bus_.reset_count();
+	{
+		const uint8_t src[4] = { 0x11, 0x22, 0x33, 0x44 };
+		ok = iica_.send(LIMIT_ADR, reg, src, 4);
+	}
+	if(!check_("iica_io data NACK", !ok && iica_.get_last_error() == IICA::error::send_data
+		&& bus_.get_starts() == 1 && bus_.get_restarts() == 0 && bus_.get_stops() == 1
+		&& bus_.is_idle())) ++err;
+
+	// 複数の要求を積んで、順に完了する事
+	bus_.set_read_tick(false);
+	bus_.reset_count();
+	done_ = 0;
+	uint8_t a[6], b[6], c[2];
+	uint8_t ra = 0x10, rb = 0x20, rc = 0x30;
+	queue_.put(SENSOR_ADR, &ra, a, 6, task_);
+	queue_.put(SENSOR_ADR, &rb, b, 6, task_);
+	queue_.put(SENSOR_ADR, &rc, c, 2, task_);
+	uint8_t len = queue_.length();
+	n = run_();
+	if(!check_("iica_queue 3 requests", len == 3 && done_ == 3 && expect_(a, ra, 6)
+		&& expect_(b, rb, 6) && expect_(c, rc, 2))) ++err;
+	std::cout << "  service: " << n << " calls" << std::endl;
+
+	// ストレッチを待たない場合（rise から fall までに２tick 進むので、3 以上）
+	if(stretch > 2) {
+		bus_.reset_count();
+		done_ = 0;
+		queue_.set_busy(0);
+		queue_.put(SENSOR_ADR, &reg, dst, 2, task_);
+		run_();
+		if(!check_("iica_queue stall", done_ == 1 && err_ == QUEUE::error::stall)) ++err;
+		queue_.set_busy(busy);
+	}
+
+	std::cout << (err == 0 ? "Pass" : "Fail") << std::endl;
+	return err != 0 ? 1 : 0;
+}
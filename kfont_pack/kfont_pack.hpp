@@ -0,0 +1,194 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	BDF フォントの読み込みと、kfont_sd 形式への変換（ホスト用） @n
+			kfont_pack と、sd_sim（-kfont）で使う。@n
+			CHARSET_REGISTRY が ISO10646 の場合はそのまま、@n
+			JISX0208 の場合は SJIS を経由して UTF-16 に変換する。@n
+			ASCII（0x80 未満）は AFONT で描画するので含めない。@n
+			※r8cprog/sjis_utf16.cpp をリンクする事
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include "sjis_utf16.hpp"
+
+namespace tools {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	BDF フォント
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	struct bdf_t {
+		int		fw = 0;
+		int		fh = 0;
+		int		fx = 0;
+		int		fy = 0;
+		bool	jis = false;
+		std::map<uint16_t, std::vector<uint8_t> > glyphs;	///< UTF-16 とグリフ
+	};
+
+
+	inline uint16_t jis_to_sjis(uint16_t jis)
+	{
+		uint16_t j1 = jis >> 8;
+		uint16_t j2 = jis & 0xff;
+		uint16_t s1 = ((j1 - 0x21) >> 1) + 0x81;
+		if(s1 > 0x9f) s1 += 0x40;
+		uint16_t s2;
+		if(j1 & 1) {
+			s2 = j2 + 0x1f;
+			if(s2 >= 0x7f) ++s2;
+		} else {
+			s2 = j2 + 0x7e;
+		}
+		return (s1 << 8) | s2;
+	}
+
+
+	//-----------------------------------------------------------------//
+	/*!
+		@brief	BDF の BITMAP を、セル（fw x fh）内に配置して、@n
+				行単位のビット列（LSB から）にする
+		@param[in]	bdf		フォント（セルの大きさ）
+		@param[in]	w		BBX 横幅
+		@param[in]	h		BBX 高さ
+		@param[in]	xo		BBX X オフセット
+		@param[in]	yo		BBX Y オフセット
+		@param[in]	lines	BITMAP の行（１６進）
+		@return グリフ
+	*/
+	//-----------------------------------------------------------------//
+	inline std::vector<uint8_t> pack_glyph(const bdf_t& bdf, int w, int h, int xo, int yo,
+		const std::vector<std::string>& lines)
+	{
+		int bits = bdf.fw * bdf.fh;
+		std::vector<uint8_t> out((bits + 7) / 8, 0);
+		int top = (bdf.fh + bdf.fy) - (yo + h);
+		int left = xo - bdf.fx;
+		for(int r = 0; r < h && r < static_cast<int>(lines.size()); ++r) {
+			const std::string& s = lines[r];
+			for(int c = 0; c < w; ++c) {
+				int n = c / 4;
+				if(n >= static_cast<int>(s.size())) break;
+				int v = std::stoi(s.substr(n, 1), nullptr, 16);
+				if((v & (8 >> (c & 3))) == 0) continue;
+				int y = top + r;
+				int x = left + c;
+				if(x < 0 || x >= bdf.fw || y < 0 || y >= bdf.fh) continue;
+				int pos = y * bdf.fw + x;
+				out[pos >> 3] |= 1 << (pos & 7);
+			}
+		}
+		return out;
+	}
+
+
+	//-----------------------------------------------------------------//
+	/*!
+		@brief	BDF を読み込む
+		@param[in]	ifs		入力
+		@param[out]	bdf		フォント
+		@return FONTBOUNDINGBOX が正しければ「true」
+	*/
+	//-----------------------------------------------------------------//
+	inline bool load_bdf(std::istream& ifs, bdf_t& bdf)
+	{
+		std::string line;
+		int code = -1;
+		int w = 0, h = 0, xo = 0, yo = 0;
+		bool bitmap = false;
+		std::vector<std::string> lines;
+		while(std::getline(ifs, line)) {
+			if(!line.empty() && line.back() == '\r') line.pop_back();
+			std::istringstream iss(line);
+			std::string key;
+			iss >> key;
+			if(bitmap) {
+				if(key == "ENDCHAR") {
+					bitmap = false;
+					if(code < 0) continue;
+					uint16_t u = code;
+					if(bdf.jis) u = utils::sjis_to_utf16(jis_to_sjis(code));
+					if(u < 0x80 || u == 0xffff) continue;
+					bdf.glyphs[u] = pack_glyph(bdf, w, h, xo, yo, lines);
+				} else {
+					lines.push_back(key);
+				}
+			} else if(key == "FONTBOUNDINGBOX") {
+				iss >> bdf.fw >> bdf.fh >> bdf.fx >> bdf.fy;
+			} else if(key == "CHARSET_REGISTRY") {
+				std::string reg;
+				iss >> reg;
+				bdf.jis = reg.find("JISX0208") != std::string::npos;
+			} else if(key == "ENCODING") {
+				iss >> code;
+			} else if(key == "BBX") {
+				iss >> w >> h >> xo >> yo;
+			} else if(key == "BITMAP") {
+				bitmap = true;
+				lines.clear();
+			}
+		}
+		return bdf.fw > 0 && bdf.fh > 0 && bdf.fw <= 127 && bdf.fh <= 127;
+	}
+
+
+	inline void put16(std::vector<uint8_t>& out, uint16_t v)
+	{
+		out.push_back(v & 0xff);
+		out.push_back(v >> 8);
+	}
+
+
+	//-----------------------------------------------------------------//
+	/*!
+		@brief	kfont_sd 形式のファイル・イメージを作成
+		@param[in]	bdf		フォント（グリフが一つ以上ある事）
+		@return ファイル・イメージ
+	*/
+	//-----------------------------------------------------------------//
+	inline std::vector<uint8_t> make_kfont(const bdf_t& bdf)
+	{
+		uint16_t first = bdf.glyphs.begin()->first;
+		uint16_t last = bdf.glyphs.rbegin()->first;
+		uint32_t num = last - first + 1;
+		uint32_t data = 16 + num * 2;
+
+		std::vector<uint8_t> out;
+		out.push_back('K');
+		out.push_back('F');
+		out.push_back('N');
+		out.push_back('T');
+		out.push_back(bdf.fw);
+		out.push_back(bdf.fh);
+		put16(out, first);
+		put16(out, last);
+		put16(out, bdf.glyphs.size());
+		put16(out, data & 0xffff);
+		put16(out, data >> 16);
+
+		uint16_t idx = 0;
+		for(uint32_t i = 0; i < num; ++i) {
+			if(bdf.glyphs.find(first + i) != bdf.glyphs.end()) {
+				put16(out, idx);
+				++idx;
+			} else {
+				put16(out, 0xffff);
+			}
+		}
+		for(const auto& g : bdf.glyphs) {
+			out.insert(out.end(), g.second.begin(), g.second.end());
+		}
+		return out;
+	}
+}
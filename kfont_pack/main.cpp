@@ -0,0 +1,62 @@
+//=====================================================================//
+/*!	@file
+	@brief	BDF フォントを kfont_sd 形式に変換するツール @n
+			CHARSET_REGISTRY が ISO10646 の場合はそのまま、@n
+			JISX0208 の場合は SJIS を経由して UTF-16 に変換する。@n
+			ASCII（0x80 未満）は AFONT で描画するので含めない。@n
+			変換は kfont_pack.hpp（sd_sim と共通）で行う。@n
+			使い方： kfont_pack input.bdf output.fnt
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "kfont_pack.hpp"
+
+int main(int argc, char* argv[])
+{
+	if(argc < 3) {
+		std::cout << "BDF font to kfont_sd converter" << std::endl;
+		std::cout << "usage: " << argv[0] << " input.bdf output.fnt" << std::endl;
+		return 0;
+	}
+
+	tools::bdf_t bdf;
+	{
+		std::ifstream ifs(argv[1]);
+		if(!ifs) {
+			std::cerr << "Can't open: '" << argv[1] << "'" << std::endl;
+			return 1;
+		}
+		if(!tools::load_bdf(ifs, bdf)) {
+			std::cerr << "Illegal FONTBOUNDINGBOX: '" << argv[1] << "'" << std::endl;
+			return 1;
+		}
+	}
+	if(bdf.glyphs.empty()) {
+		std::cerr << "No glyph: '" << argv[1] << "'" << std::endl;
+		return 1;
+	}
+
+	auto out = tools::make_kfont(bdf);
+	uint16_t first = bdf.glyphs.begin()->first;
+	uint16_t last = bdf.glyphs.rbegin()->first;
+
+	std::ofstream ofs(argv[2], std::ios::binary);
+	if(!ofs) {
+		std::cerr << "Can't open: '" << argv[2] << "'" << std::endl;
+		return 1;
+	}
+	ofs.write(reinterpret_cast<const char*>(out.data()), out.size());
+
+	std::cout << "Font: " << bdf.fw << " x " << bdf.fh << ", " << bdf.glyphs.size()
+		<< " glyphs (U+" << std::hex << first << " to U+" << last << std::dec << "), "
+		<< out.size() << " bytes" << std::endl;
+	return 0;
+}
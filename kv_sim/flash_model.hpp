@@ -0,0 +1,133 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	R8C データ・フラッシュ・モデル（flash_io と同じインターフェース） @n
+			・書き込みは、ビットを「1」から「0」にするだけ（AND） @n
+			・消去は、バンク（1024 バイト）単位で 0xFF にする @n
+			・消去済みで無いビットを「1」に戻す書き込みを、違反として数える @n
+			・書き込み（１バイト）、消去を数え、指定した回数で電源断を起こす @n
+			電源断では、書き込み中のバイトは一部のビットだけ、消去中のバンクは @n
+			一部のバイトだけ変化させて、power_cut を投げる。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <cstdlib>
+
+namespace sim {
+
+	/// 電源断（例外）
+	struct power_cut { };
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	データ・フラッシュ・モデル・クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class flash_model {
+	public:
+		enum class DATA_AREA {
+			BANK0,	///< 0x000 to 0x3FF (1024)
+			BANK1,	///< 0x400 to 0x7FF (1024)
+		};
+
+		static const uint16_t BANK_SIZE = 0x0400;
+
+	private:
+		uint8_t		mem_[BANK_SIZE * 2];
+
+		uint32_t	erase_count_[2];
+		uint32_t	write_count_;
+		uint32_t	violation_;
+
+		uint32_t	cut_;		///< 電源断までの操作数（0 なら無効）
+
+		bool cut_now_() {
+			if(cut_ == 0) return false;
+			--cut_;
+			return cut_ == 0;
+		}
+
+		void program_(uint16_t ofs, uint8_t data) {
+			if(ofs >= sizeof(mem_)) return;
+			if((mem_[ofs] & data) != data) ++violation_;
+			if(cut_now_()) {
+				mem_[ofs] &= data | static_cast<uint8_t>(rand());  // 一部のビットだけ書かれる
+				throw power_cut();
+			}
+			mem_[ofs] &= data;
+			++write_count_;
+		}
+
+	public:
+		flash_model() : erase_count_{ 0 }, write_count_(0), violation_(0), cut_(0) {
+			for(uint16_t i = 0; i < sizeof(mem_); ++i) mem_[i] = 0xff;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	電源断を設定
+			@param[in]	n	電源断までの操作数（書き込みバイト数＋消去回数）、@n
+							0 なら電源断を起こさない
+		*/
+		//-----------------------------------------------------------------//
+		void set_cut(uint32_t n) { cut_ = n; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	消去
+			@param[in]	bank	バンク
+			@return 成功なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool erase(DATA_AREA bank) {
+			uint8_t b = bank == DATA_AREA::BANK0 ? 0 : 1;
+			uint8_t* p = &mem_[b * BANK_SIZE];
+			if(cut_now_()) {
+				for(uint16_t i = 0; i < BANK_SIZE; ++i) {
+					if(rand() & 1) p[i] = 0xff;
+				}
+				throw power_cut();
+			}
+			for(uint16_t i = 0; i < BANK_SIZE; ++i) p[i] = 0xff;
+			++erase_count_[b];
+			return true;
+		}
+
+
+		void read(uint16_t ofs, uint16_t len, uint8_t* dst) const {
+			for(uint16_t i = 0; i < len; ++i) {
+				dst[i] = (ofs + i) < sizeof(mem_) ? mem_[ofs + i] : 0xff;
+			}
+		}
+
+
+		uint8_t read(uint16_t ofs) const {
+			return ofs < sizeof(mem_) ? mem_[ofs] : 0xff;
+		}
+
+
+		bool write(uint16_t ofs, uint8_t data) {
+			program_(ofs, data);
+			return true;
+		}
+
+
+		bool write(const uint8_t* src, uint16_t ofs, uint16_t len) {
+			for(uint16_t i = 0; i < len; ++i) {
+				program_(ofs + i, src[i]);
+			}
+			return true;
+		}
+
+
+		uint32_t get_erase_count(uint8_t bank) const { return erase_count_[bank & 1]; }
+		uint32_t get_write_count() const { return write_count_; }
+		uint32_t get_violation() const { return violation_; }
+	};
+}
@@ -0,0 +1,244 @@
+//=====================================================================//
+/*!	@file
+	@brief	データ・フラッシュ・モデルで、flash_kv を評価する @n
+			・連続書き込み：ランダムなキーと値を書き、std::map と比較する。@n
+			  書き込み回数と消去回数から、一回の書き込み毎に消去する場合 @n
+			  に対する、消去の削減率を表示する。@n
+			・電源断：ランダムな位置で電源を切り、start() の後で、全てのキー @n
+			  が、直前の値か、書き込み中の値になっている事を確認する。@n
+			使い方： kv_sim [-writes n] [-cuts n] [-keys n] [-len bytes] [-seed n]
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdlib>
+#include "flash_model.hpp"
+#include "common/flash_kv.hpp"
+
+namespace {
+
+	typedef sim::flash_model FLASH;
+	typedef utils::flash_kv<FLASH, 16> KV;
+	typedef std::vector<uint8_t> VALUE;
+	typedef std::map<uint8_t, VALUE> MIRROR;
+
+	uint8_t		keys_ = 12;
+	uint8_t		len_ = 8;
+
+
+	VALUE get_(const KV& kv, uint8_t key)
+	{
+		VALUE v(kv.length(key));
+		if(!v.empty()) kv.read(key, v.data(), v.size());
+		return v;
+	}
+
+
+	bool verify_(const KV& kv, const MIRROR& m)
+	{
+		for(uint8_t key = 0; key < keys_; ++key) {
+			auto it = m.find(key);
+			VALUE e;
+			if(it != m.end()) e = it->second;
+			if(get_(kv, key) != e) return false;
+		}
+		return true;
+	}
+
+
+	struct op_t {
+		uint8_t	key;
+		VALUE	value;		///< 空なら削除
+	};
+
+
+	op_t make_op_()
+	{
+		op_t op;
+		op.key = rand() % keys_;
+		if((rand() % 10) != 0) {
+			op.value.resize(1 + rand() % len_);
+			for(auto& v : op.value) v = rand();
+		}
+		return op;
+	}
+
+
+	bool apply_(KV& kv, MIRROR& m, const op_t& op)
+	{
+		if(op.value.empty()) {
+			if(!kv.erase(op.key)) return false;
+			m.erase(op.key);
+		} else {
+			if(!kv.write(op.key, op.value.data(), op.value.size())) return false;
+			m[op.key] = op.value;
+		}
+		return true;
+	}
+
+
+	bool endurance_(uint32_t writes)
+	{
+		FLASH flash;
+		KV kv(flash);
+		if(!kv.start()) return false;
+		uint32_t erase0 = flash.get_erase_count(0) + flash.get_erase_count(1);
+
+		MIRROR m;
+		uint32_t bytes = 0;
+		bool ok = true;
+		for(uint32_t i = 0; i < writes; ++i) {
+			auto op = make_op_();
+			if(!apply_(kv, m, op)) {
+				ok = false;
+				break;
+			}
+			bytes += op.value.size();
+			if((i % 97) == 0 && !verify_(kv, m)) {
+				ok = false;
+				break;
+			}
+		}
+		if(ok) ok = verify_(kv, m);
+
+		// 再起動して、索引を作り直す
+		KV kv2(flash);
+		if(ok) ok = kv2.start() && verify_(kv2, m);
+		ok = ok && flash.get_violation() == 0;
+
+		uint32_t e0 = flash.get_erase_count(0);
+		uint32_t e1 = flash.get_erase_count(1);
+		uint32_t erase = e0 + e1 - erase0;
+		std::cout << "endurance " << (ok ? "OK  " : "NG  ") << writes << " writes ("
+			<< bytes << " bytes), " << erase << " erases (BANK0: " << e0 << ", BANK1: " << e1
+			<< "), gen: " << kv2.get_gen() << std::endl;
+		if(erase > 0) {
+			std::cout << "          " << std::fixed << std::setprecision(1)
+				<< static_cast<double>(writes) / static_cast<double>(erase)
+				<< " writes / erase (erase per write: 1.0)" << std::endl;
+		}
+		return ok;
+	}
+
+
+	bool power_cut_(uint32_t cuts)
+	{
+		FLASH flash;
+		MIRROR m;
+		{
+			KV kv(flash);
+			if(!kv.start()) return false;
+		}
+
+		uint32_t done = 0;
+		uint32_t torn = 0;
+		uint32_t gc = 0;
+		bool ok = true;
+		for(uint32_t n = 0; n < cuts && ok; ++n) {
+			KV kv(flash);
+			if(!kv.start()) {
+				ok = false;
+				break;
+			}
+			flash.set_cut(1 + rand() % 400);
+			op_t op;
+			bool cut = false;
+			uint16_t gen = kv.get_gen();
+			try {
+				while(1) {
+					op = make_op_();
+					if(!apply_(kv, m, op)) {
+						ok = false;
+						break;
+					}
+					++done;
+				}
+			} catch(sim::power_cut&) {
+				cut = true;
+			}
+			flash.set_cut(0);
+			if(!cut) break;
+
+			// 再起動
+			KV kv2(flash);
+			if(!kv2.start()) {
+				ok = false;
+				break;
+			}
+			if(kv2.get_free() == 0) ++torn;
+			if(kv2.get_gen() != gen) ++gc;
+			VALUE v = get_(kv2, op.key);
+			auto it = m.find(op.key);
+			VALUE old;
+			if(it != m.end()) old = it->second;
+			if(v == op.value) {
+				if(v.empty()) m.erase(op.key);
+				else m[op.key] = v;
+			} else if(v != old) {
+				std::cout << "key " << static_cast<int>(op.key) << ": neither old nor new value"
+					<< std::endl;
+				ok = false;
+			}
+			if(ok && !verify_(kv2, m)) {
+				std::cout << "other keys changed" << std::endl;
+				ok = false;
+			}
+		}
+		ok = ok && flash.get_violation() == 0;
+		std::cout << "power cut " << (ok ? "OK  " : "NG  ") << cuts << " cuts, " << done
+			<< " writes, torn: " << torn << ", gc: " << gc
+			<< ", violation: " << flash.get_violation() << std::endl;
+		return ok;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	uint32_t writes = 20000;
+	uint32_t cuts = 20000;
+	uint32_t seed = 1;
+	for(int i = 1; i < argc; ++i) {
+		std::string s = argv[i];
+		if(s == "-writes" && (i + 1) < argc) {
+			writes = std::atoi(argv[++i]);
+		} else if(s == "-cuts" && (i + 1) < argc) {
+			cuts = std::atoi(argv[++i]);
+		} else if(s == "-keys" && (i + 1) < argc) {
+			int n = std::atoi(argv[++i]);
+			if(n < 1) n = 1;
+			else if(n > 16) n = 16;
+			keys_ = n;
+		} else if(s == "-len" && (i + 1) < argc) {
+			int n = std::atoi(argv[++i]);
+			if(n < 1) n = 1;
+			else if(n > 32) n = 32;
+			len_ = n;
+		} else if(s == "-seed" && (i + 1) < argc) {
+			seed = std::atoi(argv[++i]);
+		} else {
+			std::cout << "Data flash key/value store model for flash_kv" << std::endl;
+			std::cout << "usage: " << argv[0]
+				<< " [-writes n] [-cuts n] [-keys n] [-len bytes] [-seed n]" << std::endl;
+			return 0;
+		}
+	}
+	srand(seed);
+
+	std::cout << "Keys: " << static_cast<int>(keys_) << ", value: 1 to "
+		<< static_cast<int>(len_) << " bytes" << std::endl;
+
+	int err = 0;
+	if(!endurance_(writes)) ++err;
+	if(!power_cut_(cuts)) ++err;
+
+	std::cout << (err == 0 ? "Pass" : "Fail") << std::endl;
+	return err != 0 ? 1 : 0;
+}
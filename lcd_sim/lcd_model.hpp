@@ -0,0 +1,211 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	ST7565 LCD と CPU 時間のモデル（ホスト用） @n
+			ST7565 の set_area、write、end_area、copy を持ち、LCD 内蔵 RAM @n
+			（８ページ×１３２カラム）に書き込む。@n
+			ソフトウェア SPI の転送時間をクロック数で数え、タイマー割り込み @n
+			を、周期毎に呼び出す。@n
+			クロック数は、R8C（20MHz）での見積り。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <cstring>
+#include "common/dirty_page.hpp"
+
+namespace sim {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	CPU 時間のモデル
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class cpu_model {
+
+		uint64_t	clock_;
+		uint64_t	next_;
+		uint32_t	period_;
+		uint32_t	isr_cycles_;
+		uint64_t	isr_clock_;
+		uint32_t	isr_count_;
+		bool		in_isr_;
+		void		(*task_)();
+
+		cpu_model() : clock_(0), next_(0), period_(0), isr_cycles_(60), isr_clock_(0),
+			isr_count_(0), in_isr_(false), task_(nullptr) { }
+
+	public:
+		static const uint32_t F_CLK = 20000000;	///< CPU クロック
+
+		static cpu_model& get() {
+			static cpu_model m;
+			return m;
+		}
+
+		//-------------------------------------------------------------//
+		/*!
+			@brief	タイマー割り込みを設定
+			@param[in]	freq	周波数（０なら割り込み無し）
+			@param[in]	task	割り込みタスク
+		*/
+		//-------------------------------------------------------------//
+		void set_timer(uint32_t freq, void (*task)()) {
+			period_ = freq > 0 ? F_CLK / freq : 0;
+			next_ = clock_ + period_;
+			task_ = task;
+		}
+
+		void reset_count() {
+			isr_clock_ = 0;
+			isr_count_ = 0;
+		}
+
+		//-------------------------------------------------------------//
+		/*!
+			@brief	時間を進める（割り込み内では、割り込みの時間として数える）
+			@param[in]	n	クロック数
+		*/
+		//-------------------------------------------------------------//
+		void step(uint32_t n) {
+			if(in_isr_) {
+				clock_ += n;
+				isr_clock_ += n;
+				return;
+			}
+			while(n > 0) {
+				if(period_ > 0 && (clock_ + n) >= next_) {
+					n -= next_ - clock_;
+					clock_ = next_;
+					next_ += period_;
+					in_isr_ = true;
+					step(isr_cycles_);
+					if(task_ != nullptr) (*task_)();
+					in_isr_ = false;
+					++isr_count_;
+				} else {
+					clock_ += n;
+					n = 0;
+				}
+			}
+		}
+
+		uint64_t get_clock() const { return clock_; }
+		uint64_t get_isr_clock() const { return isr_clock_; }
+		uint32_t get_isr_count() const { return isr_count_; }
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	ソフトウェア SPI（device::spi_io のウェイト無しの転送）の @n
+				１バイトのクロック数 @n
+				R8C の命令列から数えた値（common/spi_io.hpp を参照）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	struct spi_cycles {
+		static const uint32_t SEND = 161;	///< send（send_byte_）
+		static const uint32_t RECV = 148;	///< recv（recv_byte_）
+		static const uint32_t XCHG = 251;	///< xchg（xchg_<false>）
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	ST7565 LCD モデル
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class lcd_model {
+	public:
+		static const uint8_t PAGES = 8;
+		static const uint8_t COLUMNS = 132;
+
+	private:
+		uint8_t		ram_[PAGES][COLUMNS];
+		uint8_t		page_;
+		uint8_t		col_;
+		bool		select_;
+		uint32_t	send_cycles_;
+		uint32_t	xchg_cycles_;
+		uint32_t	errors_;
+		void		(*area_task_)();
+
+		// コマンド３バイト（xchg）と、/CS、A0 の切り替え
+		void area_(uint8_t page, uint8_t col) {
+			if(page >= PAGES || col >= COLUMNS) ++errors_;
+			page_ = page;
+			col_ = col;
+			cpu_model::get().step(xchg_cycles_ * 3 + 40);
+		}
+
+		void data_(const uint8_t* src, uint16_t len) {
+			for(uint16_t i = 0; i < len; ++i) {
+				if(page_ < PAGES && col_ < COLUMNS) ram_[page_][col_] = src[i];
+				else ++errors_;
+				++col_;
+			}
+			cpu_model::get().step(send_cycles_ * len);
+		}
+
+	public:
+		lcd_model() : page_(0), col_(0), select_(false),
+			send_cycles_(spi_cycles::SEND), xchg_cycles_(spi_cycles::XCHG), errors_(0),
+			area_task_(nullptr) {
+			clear();
+		}
+
+		void clear() { std::memset(ram_, 0, sizeof(ram_)); }
+
+		/// send、xchg の１バイトのクロック数を同じ値にする
+		void set_byte_cycles(uint32_t n) {
+			send_cycles_ = n;
+			xchg_cycles_ = n;
+		}
+
+		const uint8_t* get_page(uint8_t page) const { return ram_[page]; }
+
+		uint32_t get_errors() const { return errors_; }
+
+		/// set_area の前に呼ぶ関数（LCD の内容の検査に使う）
+		void set_area_task(void (*task)()) { area_task_ = task; }
+
+		//-------------------------------------------------------------//
+		/*!
+			@brief	更新範囲だけコピー（ST7565::copy と同じ）
+		*/
+		//-------------------------------------------------------------//
+		template <int16_t W, uint8_t N>
+		void copy(const uint8_t* src, graphics::dirty_page<W, N>& dirty, uint8_t ofs = 0) {
+			for(uint8_t page = 0; page < N; ++page) {
+				uint8_t org;
+				uint8_t end;
+				if(dirty.get(page, org, end)) {
+					area_(page + ofs, org);
+					data_(&src[org], end - org);
+				}
+				src += W;
+			}
+			dirty.clear();
+		}
+
+		void set_area(uint8_t page, uint8_t col) {
+			if(area_task_ != nullptr) (*area_task_)();
+			if(select_) ++errors_;
+			select_ = true;
+			area_(page, col);
+		}
+
+		void write(const uint8_t* src, uint16_t len) {
+			if(!select_) ++errors_;
+			data_(src, len);
+		}
+
+		void end_area() {
+			if(!select_) ++errors_;
+			select_ = false;
+		}
+	};
+}
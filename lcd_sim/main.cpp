@@ -0,0 +1,342 @@
+//=====================================================================//
+/*!	@file
+	@brief	LCD 転送モデルで、ST7565::copy と page_stream を比べる @n
+			LCD_DOT_sample と同じ描画（枠と、ランダムな線、２０フレーム毎に @n
+			消去）を、128 x 32 の page_fb に行い、@n
+			copy: 描画の後、LCD へ転送（転送中は、メインが止まる）@n
+			stream: 描画の後、flip し、タイマー割り込みで転送 @n
+			で、フレーム毎秒（fps）、メインが待った時間、一回の最大の待ち、@n
+			割り込みの CPU 使用率を表示する。@n
+			LCD に届いた内容が、フレーム毎に、flip した時点のフレーム @n
+			バッファと一致するか（描画途中の画像が送られないか）、@n
+			flip と copy のオフセット（ページ）が一致するかを検査する。@n
+			-rate で、フレームの開始を一定の周期（fps）にする（０なら待たない）。@n
+			SPI の転送時間は、spi_io の命令列から数えた値（sim::spi_cycles）@n
+			で、-byte は全ての転送を一律のクロック数にする。@n
+			使い方： lcd_sim [-frames n] [-rate fps] [-draw clocks] [-byte clocks]
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstdlib>
+#include "lcd_model.hpp"
+#include "common/monograph.hpp"
+#include "common/page_fb.hpp"
+
+namespace {
+
+	// 待ちループ（sleep_）一回のクロック数
+	static const uint32_t NOP_CYCLES = 8;
+	// flip でリングに写す、１バイト当たりのクロック数
+	static const uint32_t RING_CYCLES = 12;
+
+	uint64_t	blocked_;
+
+	void nop_()
+	{
+		blocked_ += NOP_CYCLES;
+		sim::cpu_model::get().step(NOP_CYCLES);
+	}
+}
+
+// page_stream の待ち（asm("nop")）で、モデルの時間を進める
+#define asm(x) nop_()
+#include "common/page_stream.hpp"
+#undef asm
+
+namespace {
+
+	typedef graphics::page_fb<128, 32> PLOT;
+
+	sim::lcd_model	lcd_;
+
+	graphics::kfont_null kfont_;
+	graphics::monograph<PLOT> bitmap_(kfont_);
+
+	// 転送の設定（SLICE、BUFF）毎の page_stream
+	template <uint8_t SLICE, uint16_t BUFF>
+	graphics::page_stream<sim::lcd_model, PLOT, SLICE, BUFF>& stream_()
+	{
+		static graphics::page_stream<sim::lcd_model, PLOT, SLICE, BUFF> s(lcd_, bitmap_.at_plot());
+		return s;
+	}
+
+	// LCD_DOT_sample と同じ乱数
+	class rand_t {
+		uint8_t	v_;
+		uint8_t	m_;
+	public:
+		rand_t() : v_(91), m_(123) { }
+		uint8_t operator() () {
+			v_ += v_ << 2;
+			++v_;
+			uint8_t n = 0;
+			if(m_ & 0x02) n = 1;
+			if(m_ & 0x40) n ^= 1;
+			m_ += m_;
+			if(n == 0) ++m_;
+			return v_ ^ m_;
+		}
+	};
+
+	class scene_t {
+		rand_t		rand_;
+		uint16_t	x_;
+		uint16_t	y_;
+		uint8_t		loop_;
+	public:
+		scene_t() : rand_(), loop_(20) {
+			x_ = rand_() & 127;
+			y_ = rand_() & 31;
+		}
+
+		void draw() {
+			if(loop_ >= 20) {
+				loop_ = 0;
+				bitmap_.clear(0);
+				bitmap_.frame(0, 0, 128, 32, 1);
+			}
+			uint16_t xx = rand_() & 127;
+			uint16_t yy = rand_() & 31;
+			bitmap_.line(x_, y_, xx, yy, 1);
+			x_ = xx;
+			y_ = yy;
+			++loop_;
+		}
+	};
+
+	typedef std::vector<uint8_t> image_t;
+
+	image_t snap_()
+	{
+		const uint8_t* p = bitmap_.at_plot().fb();
+		return image_t(p, p + PLOT::WIDTH * PLOT::PAGE_NUM);
+	}
+
+	bool same_(const image_t& img, uint8_t ofs)
+	{
+		for(uint8_t page = 0; page < PLOT::PAGE_NUM; ++page) {
+			if(std::memcmp(lcd_.get_page(page + ofs), &img[page * PLOT::WIDTH], PLOT::WIDTH) != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// 送り終えたフレームを、flip した時点の内容と比べる
+	std::deque<image_t>	queue_;
+	uint16_t	frame_;
+	uint8_t		ofs_;
+	uint32_t	tear_;
+
+	template <uint8_t SLICE, uint16_t BUFF>
+	void frame_check_()
+	{
+		while(frame_ != stream_<SLICE, BUFF>().get_frame()) {
+			++frame_;
+			if(queue_.empty() || !same_(queue_.front(), ofs_)) ++tear_;
+			if(!queue_.empty()) queue_.pop_front();
+		}
+	}
+
+	// 次の区間を送る前と、割り込みの終わりで検査する
+	template <uint8_t SLICE, uint16_t BUFF>
+	void stream_task_()
+	{
+		stream_<SLICE, BUFF>().service();
+		frame_check_<SLICE, BUFF>();
+	}
+
+	// フレームの開始を、rate（fps）の周期まで待つ（０なら待たない）
+	void pace_(uint64_t& next, uint32_t rate)
+	{
+		if(rate == 0) return;
+		auto& cpu = sim::cpu_model::get();
+		while(cpu.get_clock() < next) cpu.step(NOP_CYCLES);
+		next += sim::cpu_model::F_CLK / rate;
+	}
+
+
+	struct result_t {
+		uint64_t	clock;
+		uint64_t	blocked;
+		uint64_t	stall;
+		uint64_t	isr;
+		uint32_t	frames;
+		bool		ok;
+	};
+
+	// 更新範囲のバイト数
+	uint32_t dirty_bytes_()
+	{
+		uint32_t n = 0;
+		for(uint8_t page = 0; page < PLOT::PAGE_NUM; ++page) {
+			uint8_t org;
+			uint8_t end;
+			if(bitmap_.at_plot().at_dirty().get(page, org, end)) n += end - org;
+		}
+		return n;
+	}
+
+	void reset_()
+	{
+		auto& cpu = sim::cpu_model::get();
+		cpu.set_timer(0, nullptr);
+		lcd_.clear();
+		bitmap_.at_plot().clear(0);
+		bitmap_.at_plot().at_dirty().all();
+		queue_.clear();
+		tear_ = 0;
+		blocked_ = 0;
+		cpu.reset_count();
+	}
+
+
+	result_t run_copy_(uint32_t frames, uint32_t draw, uint8_t ofs, uint32_t rate)
+	{
+		auto& cpu = sim::cpu_model::get();
+		reset_();
+		uint64_t org = cpu.get_clock();
+		result_t t;
+		t.stall = 0;
+		t.blocked = 0;
+		t.ok = true;
+		scene_t scene;
+		uint64_t next = org;
+		for(uint32_t i = 0; i < frames; ++i) {
+			pace_(next, rate);
+			scene.draw();
+			cpu.step(draw);
+			auto img = snap_();
+			uint64_t st = cpu.get_clock();
+			lcd_.copy(bitmap_.at_plot().fb(), bitmap_.at_plot().at_dirty(), ofs);
+			uint64_t n = cpu.get_clock() - st;
+			t.blocked += n;
+			if(n > t.stall) t.stall = n;
+			if(!same_(img, ofs)) t.ok = false;
+		}
+		t.clock = cpu.get_clock() - org;
+		t.isr = 0;
+		t.frames = frames;
+		return t;
+	}
+
+
+	template <uint8_t SLICE, uint16_t BUFF>
+	result_t run_stream_(uint32_t frames, uint32_t draw, uint8_t ofs, uint32_t rate, uint32_t freq)
+	{
+		auto& stream = stream_<SLICE, BUFF>();
+		auto& cpu = sim::cpu_model::get();
+		reset_();
+		ofs_ = ofs;
+		frame_ = stream.get_frame();
+		cpu.set_timer(freq, stream_task_<SLICE, BUFF>);
+		lcd_.set_area_task(frame_check_<SLICE, BUFF>);
+		uint64_t org = cpu.get_clock();
+		result_t t;
+		t.stall = 0;
+		scene_t scene;
+		uint16_t top = stream.get_frame();
+		uint64_t next = org;
+		for(uint32_t i = 0; i < frames; ++i) {
+			pace_(next, rate);
+			scene.draw();
+			cpu.step(draw);
+			queue_.push_back(snap_());
+			cpu.step(dirty_bytes_() * RING_CYCLES);
+			uint64_t b = blocked_;
+			stream.flip(ofs);
+			if((blocked_ - b) > t.stall) t.stall = blocked_ - b;
+		}
+		t.blocked = blocked_;
+		stream.sync();  // 最後のフレームが届くまで
+		t.clock = cpu.get_clock() - org;
+		t.isr = cpu.get_isr_clock();
+		t.frames = static_cast<uint16_t>(stream.get_frame() - top);
+		t.ok = tear_ == 0 && queue_.empty() && t.frames == frames;
+		cpu.set_timer(0, nullptr);
+		lcd_.set_area_task(nullptr);
+		return t;
+	}
+
+
+	void report_(const std::string& title, const result_t& t)
+	{
+		double sec = static_cast<double>(t.clock) / sim::cpu_model::F_CLK;
+		std::cout << std::left << std::setw(21) << title << std::right << std::fixed
+			<< std::setprecision(1) << std::setw(8) << t.frames / sec
+			<< std::setw(10) << static_cast<double>(t.blocked) * 100.0 / t.clock << " %"
+			<< std::setw(10) << static_cast<double>(t.stall) * 1e6 / sim::cpu_model::F_CLK << " us"
+			<< std::setw(8) << static_cast<double>(t.isr) * 100.0 / t.clock << " %"
+			<< "   " << (t.ok ? "OK" : "NG") << std::endl;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	uint32_t frames = 600;
+	uint32_t draw = 6000;
+	uint32_t byte = 0;  // ０なら、send、recv、xchg 毎の値（sim::spi_cycles）
+	uint32_t rate = 0;
+	for(int i = 1; i < argc; ++i) {
+		std::string s = argv[i];
+		if(s == "-frames" && (i + 1) < argc) {
+			frames = std::atoi(argv[++i]);
+			if(frames == 0) frames = 1;
+		} else if(s == "-rate" && (i + 1) < argc) {
+			rate = std::atoi(argv[++i]);
+		} else if(s == "-draw" && (i + 1) < argc) {
+			draw = std::atoi(argv[++i]);
+		} else if(s == "-byte" && (i + 1) < argc) {
+			byte = std::atoi(argv[++i]);
+			if(byte == 0) byte = 1;
+		} else {
+			std::cout << "LCD transfer model for ST7565::copy and page_stream" << std::endl;
+			std::cout << "usage: " << argv[0] << " [-frames n] [-rate fps] [-draw clocks] [-byte clocks]"
+				<< std::endl;
+			return 0;
+		}
+	}
+	if(byte > 0) lcd_.set_byte_cycles(byte);
+
+	std::cout << "Frames: " << frames << ", rate: " << rate << " fps, draw: " << draw << " clocks/frame, SPI: ";
+	if(byte > 0) std::cout << byte << " clocks/byte" << std::endl;
+	else std::cout << "send " << sim::spi_cycles::SEND << ", xchg " << sim::spi_cycles::XCHG << " clocks/byte"
+		<< std::endl;
+	std::cout << "method (Hz SLICE/BUFF)   fps   main wait  max wait     ISR   LCD" << std::endl;
+
+	int err = 0;
+	auto c = run_copy_(frames, draw, 0, rate);
+	report_("copy", c);
+	if(!c.ok) ++err;
+	// 割り込み周波数、SLICE、BUFF
+	auto s0 = run_stream_<16, 128>(frames, draw, 0, rate, 960);
+	report_("960Hz 16/128", s0);
+	auto s1 = run_stream_<32, 128>(frames, draw, 0, rate, 1920);
+	report_("1920Hz 32/128", s1);
+	auto s2 = run_stream_<32, 256>(frames, draw, 0, rate, 1920);
+	report_("1920Hz 32/256", s2);
+	auto s3 = run_stream_<16, 256>(frames, draw, 0, rate, 3840);
+	report_("3840Hz 16/256", s3);
+	if(!s0.ok || !s1.ok || !s2.ok || !s3.ok) ++err;
+
+	// flip と copy のオフセットは、どちらもページ
+	{
+		auto a = run_copy_(40, draw, 4, 0);
+		auto b = run_stream_<16, 128>(40, draw, 4, 0, 1920);
+		bool ok = a.ok && b.ok && lcd_.get_errors() == 0;
+		std::cout << "page offset   " << (ok ? "OK" : "NG") << std::endl;
+		if(!ok) ++err;
+	}
+
+	std::cout << (err == 0 ? "Pass" : "Fail") << std::endl;
+	return err != 0 ? 1 : 0;
+}
@@ -0,0 +1,466 @@
+//=====================================================================//
+/*!	@file
+	@brief	chip/MAX7219.hpp の検査 @n
+			SPI と LOAD（SELECT）をホストのモデルで置き換え、デージーチェーン @n
+			の各デバイスが受け取るフレーム（LOAD の立ち上がりで確定する @n
+			１６ビット×CHAIN）を解読して、デバイスのレジスターを再現する。@n
+			・start 後のレジスター（テスト、シャットダウン、デコード、@n
+			　スキャン・リミット、輝度）と、全桁の転送 @n
+			・service が、変化した桁だけを送り、他のデバイスは NO-OP に @n
+			　なる事（フレーム数、NO-OP 数を、変化から求めた値と比較）@n
+			・refresh の後は全桁を送る事 @n
+			・set、get、[]、shift_top、shift_end（あふれた値）を、リング @n
+			　バッファを使わないモデルと比較 @n
+			・MAX7219_marquee の７セグメント（小数点の合成）と、8x8 @n
+			　マトリックスのスクロール、繰り返し @n
+			CHAIN は、１、２、４で試す。@n
+			使い方： max7219_test [-v]
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "chip/MAX7219.hpp"
+
+namespace {
+
+	static const uint8_t MAX_CHAIN = 4;
+
+	// デージーチェーンのモデル（デバイス０が、マイコンに近い側）
+	class chain_t {
+	public:
+		struct dev_t {
+			uint8_t	digit[8];
+			uint8_t	decode;
+			uint8_t	inten;
+			uint8_t	scan;
+			uint8_t	shutdown;
+			uint8_t	test;
+		};
+
+	private:
+		uint8_t					chain_;
+		dev_t					dev_[MAX_CHAIN];
+		std::vector<uint8_t>	shift_;
+		bool					load_;
+
+	public:
+		uint32_t	frames;		///< LOAD の立ち上がりの回数
+		uint32_t	words;		///< NO-OP 以外の１６ビット
+		uint32_t	nops;		///< NO-OP
+		uint32_t	errors;		///< 長さ、コマンドの誤り、LOAD が「H」での転送
+
+		void reset(uint8_t chain)
+		{
+			chain_ = chain;
+			for(auto& d : dev_) {
+				for(auto& v : d.digit) v = 0x55;  // 電源投入時は不定
+				d.decode = 0x55;
+				d.inten = 0x55;
+				d.scan = 0x55;
+				d.shutdown = 0x55;
+				d.test = 0x55;
+			}
+			shift_.clear();
+			load_ = true;
+			clear();
+			errors = 0;
+		}
+
+		void clear()
+		{
+			frames = 0;
+			words = 0;
+			nops = 0;
+		}
+
+		const dev_t& get(uint8_t i) const { return dev_[i]; }
+
+		void send(const uint8_t* p, uint16_t size)
+		{
+			if(load_) ++errors;
+			shift_.insert(shift_.end(), p, p + size);
+		}
+
+		void load(bool v)
+		{
+			if(!v) {
+				shift_.clear();
+			} else if(!load_) {
+				++frames;
+				if(shift_.size() != (2u * chain_)) {
+					++errors;
+				} else {
+					// 最初に送った１６ビットは、一番遠いデバイスに届く
+					for(uint8_t i = 0; i < chain_; ++i) {
+						apply_(dev_[chain_ - 1 - i], shift_[i * 2], shift_[i * 2 + 1]);
+					}
+				}
+			}
+			load_ = v;
+		}
+
+	private:
+		void apply_(dev_t& d, uint8_t cmd, uint8_t dat)
+		{
+			if(cmd == 0x00) {
+				++nops;
+				return;
+			}
+			++words;
+			if(cmd >= 0x01 && cmd <= 0x08) d.digit[cmd - 1] = dat;
+			else if(cmd == 0x09) d.decode = dat;
+			else if(cmd == 0x0A) d.inten = dat;
+			else if(cmd == 0x0B) d.scan = dat;
+			else if(cmd == 0x0C) d.shutdown = dat;
+			else if(cmd == 0x0F) d.test = dat;
+			else ++errors;
+		}
+	};
+
+	chain_t	chain_;
+
+	struct spi_t {
+		void send(const void* src, uint16_t size) {
+			chain_.send(static_cast<const uint8_t*>(src), size);
+		}
+	};
+
+	// LOAD（device::PORT の代わり）
+	struct load_t {
+		struct port_t {
+			port_t& operator = (bool v) {
+				chain_.load(v);
+				return *this;
+			}
+		};
+		struct reg_t {
+			reg_t& operator = (uint8_t v) { return *this; }
+		};
+		static port_t	P;
+		static reg_t	DIR;
+		static reg_t	PU;
+	};
+	load_t::port_t load_t::P;
+	load_t::reg_t load_t::DIR;
+	load_t::reg_t load_t::PU;
+
+	spi_t	spi_;
+
+	// 再現性のある乱数
+	class rand_t {
+		uint32_t	v_;
+	public:
+		rand_t() : v_(1) { }
+		uint16_t operator() (uint16_t n) {
+			v_ = v_ * 1103515245 + 12345;
+			return (v_ >> 16) % n;
+		}
+	};
+
+
+	template <uint8_t CHAIN>
+	struct test_t {
+		typedef chip::MAX7219<spi_t, load_t, CHAIN> DEV;
+		static const uint8_t NUM = 8 * CHAIN;
+
+		bool		verbose_;
+		uint32_t	err_;
+
+		test_t(bool verbose) : verbose_(verbose), err_(0) { }
+
+		void ng_(const std::string& msg)
+		{
+			std::cout << "  NG  CHAIN " << static_cast<int>(CHAIN) << ": " << msg << std::endl;
+			++err_;
+		}
+
+		// デバイスの表示と、バッファの内容を比べる
+		bool same_(const DEV& dev) const
+		{
+			for(uint8_t i = 0; i < NUM; ++i) {
+				if(chain_.get(i / 8).digit[i % 8] != dev.get(i)) return false;
+			}
+			return true;
+		}
+
+		// service を呼び、変化した桁だけが送られた事を確かめる
+		void service_(DEV& dev, const std::string& title)
+		{
+			uint32_t frames = 0;
+			uint32_t words = 0;
+			for(uint8_t p = 0; p < 8; ++p) {
+				uint8_t n = 0;
+				for(uint8_t d = 0; d < CHAIN; ++d) {
+					if(chain_.get(d).digit[p] != dev.get(d * 8 + p)) ++n;
+				}
+				if(n > 0) ++frames;
+				words += n;
+			}
+			chain_.clear();
+			dev.service();
+			if(chain_.frames != frames || chain_.words != words
+				|| chain_.nops != (frames * CHAIN - words) || !same_(dev)) {
+				ng_(title + ": frames " + std::to_string(chain_.frames) + "/" + std::to_string(frames)
+					+ ", words " + std::to_string(chain_.words) + "/" + std::to_string(words)
+					+ ", NO-OP " + std::to_string(chain_.nops));
+			}
+		}
+
+		void check_start_()
+		{
+			chain_.reset(CHAIN);
+			DEV dev(spi_);
+			dev.start();
+			// NO-OP、TEST、SHUTDOWN、DECODE、SCAN、INTENSITY と、全桁
+			if(chain_.frames != 14 || chain_.words != (13u * CHAIN) || chain_.nops != CHAIN) {
+				ng_("start frames " + std::to_string(chain_.frames));
+			}
+			for(uint8_t d = 0; d < CHAIN; ++d) {
+				const auto& t = chain_.get(d);
+				if(t.test != 0 || t.shutdown != 1 || t.decode != 0 || t.scan != 7 || t.inten != 0) {
+					ng_("start registers, device " + std::to_string(d));
+				}
+			}
+			if(!same_(dev)) ng_("start digits");
+			service_(dev, "no change");
+
+			// 同じ値を書いても送らない
+			dev.set(3, 0);
+			service_(dev, "same value");
+			if(chain_.frames != 0) ng_("same value sent");
+
+			// 最後のデバイスの１桁だけ
+			dev.set(NUM - 1, 0x81);
+			service_(dev, "last device");
+			if(chain_.frames != 1 || chain_.words != 1) ng_("last device");
+
+			// 全デバイスの同じ桁は、１フレーム
+			for(uint8_t d = 0; d < CHAIN; ++d) dev.set(d * 8 + 2, 0x10 + d);
+			service_(dev, "same digit");
+			if(chain_.frames != 1 || chain_.nops != 0) ng_("same digit");
+
+			// refresh の後は、変化が無くても全桁（NO-OP 無し）
+			dev.refresh();
+			chain_.clear();
+			dev.service();
+			if(chain_.frames != 8 || chain_.words != (8u * CHAIN) || chain_.nops != 0 || !same_(dev)) {
+				ng_("refresh");
+			}
+			service_(dev, "after refresh");
+			if(chain_.errors != 0) ng_("bus errors " + std::to_string(chain_.errors));
+		}
+
+		void check_shift_()
+		{
+			chain_.reset(CHAIN);
+			DEV dev(spi_);
+			dev.start();
+			std::vector<uint8_t> ref(NUM, 0);
+			rand_t r;
+			for(uint32_t loop = 0; loop < 2000; ++loop) {
+				uint8_t v = r(256);
+				switch(r(6)) {
+				case 0:
+					{
+						uint8_t idx = r(NUM + 4);  // 範囲外は無視
+						dev.set(idx, v);
+						if(idx < NUM) ref[idx] = v;
+					}
+					break;
+				case 1:
+					{
+						uint8_t idx = r(NUM * 2);  // 範囲外は NUM で割った余り
+						dev[idx] = v;
+						ref[idx % NUM] = v;
+					}
+					break;
+				case 2:
+					{
+						uint8_t out = dev.shift_top(v);
+						if(out != ref.back()) ng_("shift_top returns " + std::to_string(out));
+						ref.pop_back();
+						ref.insert(ref.begin(), v);
+					}
+					break;
+				case 3:
+					{
+						uint8_t out = dev.shift_end(v);
+						if(out != ref.front()) ng_("shift_end returns " + std::to_string(out));
+						ref.erase(ref.begin());
+						ref.push_back(v);
+					}
+					break;
+				case 4:
+					if(r(8) == 0) {
+						dev.refresh();
+						chain_.clear();
+						dev.service();
+						if(chain_.frames != 8 || chain_.nops != 0 || !same_(dev)) ng_("refresh");
+					}
+					break;
+				default:
+					service_(dev, "random " + std::to_string(loop));
+					break;
+				}
+				for(uint8_t i = 0; i < NUM; ++i) {
+					if(dev.get(i) != ref[i]) {
+						ng_("buffer " + std::to_string(loop) + ", index " + std::to_string(i));
+						return;
+					}
+				}
+				if(dev.get(NUM) != 0) ng_("get out of range");
+			}
+			if(chain_.errors != 0) ng_("bus errors " + std::to_string(chain_.errors));
+		}
+
+		// ７セグメントのスクロール
+		void check_seg_(const char* text, const std::vector<uint8_t>& expect)
+		{
+			chain_.reset(CHAIN);
+			DEV dev(spi_);
+			dev.start();
+			chip::MAX7219_marquee<DEV> mq(dev);
+			mq.start(text);
+			uint32_t n = 0;
+			while(mq.step()) {
+				service_(dev, std::string("marquee \"") + text + "\"");
+				++n;
+				if(n == expect.size()) {  // テキストを送り終えた時
+					bool ok = true;
+					for(uint8_t i = 0; i < NUM; ++i) {
+						uint8_t e = i < expect.size() ? expect[expect.size() - 1 - i] : 0;
+						if(dev.get(i) != e) ok = false;
+					}
+					if(!ok || verbose_) {
+						std::cout << "  " << (ok ? "OK  " : "NG  ") << "CHAIN " << static_cast<int>(CHAIN)
+							<< " \"" << text << "\":" << std::hex;
+						for(uint8_t i = 0; i < expect.size() && i < NUM; ++i) {
+							std::cout << " " << std::setw(2) << std::setfill('0')
+								<< static_cast<int>(dev.get(expect.size() - 1 - i));
+						}
+						std::cout << std::dec << std::setfill(' ') << std::endl;
+					}
+					if(!ok) ++err_;
+				}
+			}
+			// 全て抜けるまで空白を送り、その後は進まない
+			if(n != (expect.size() + NUM)) ng_(std::string("marquee steps \"") + text + "\": " + std::to_string(n));
+			for(uint8_t i = 0; i < NUM; ++i) {
+				if(dev.get(i) != 0) ng_(std::string("marquee tail \"") + text + "\"");
+			}
+			if(mq.step()) ng_("marquee step after end");
+		}
+
+		void check_marquee_()
+		{
+			uint8_t dp = 0x80;
+			uint8_t c1 = DEV::get_cha('1');
+			uint8_t c2 = DEV::get_cha('2');
+			uint8_t c3 = DEV::get_cha('3');
+			uint8_t c5 = DEV::get_cha('5');
+			uint8_t cm = DEV::get_cha('-');
+			check_seg_("12.5",   { c1, static_cast<uint8_t>(c2 | dp), c5 });
+			check_seg_("1.2.3.", { static_cast<uint8_t>(c1 | dp), static_cast<uint8_t>(c2 | dp),
+				static_cast<uint8_t>(c3 | dp) });
+			check_seg_(".5",     { dp, c5 });
+			check_seg_("1..2",   { static_cast<uint8_t>(c1 | dp), dp, c2 });
+			check_seg_("..",     { dp, dp });
+			check_seg_("-.-",    { static_cast<uint8_t>(cm | dp), cm });
+			check_seg_("",       { });
+
+			// 繰り返し
+			{
+				chain_.reset(CHAIN);
+				DEV dev(spi_);
+				dev.start();
+				chip::MAX7219_marquee<DEV> mq(dev);
+				mq.start("1.2", true);
+				uint32_t n = 0;
+				for(uint32_t i = 0; i < (2 + NUM + 2); ++i) {
+					if(mq.step()) ++n;
+					service_(dev, "marquee loop");
+				}
+				if(n != (2u + NUM + 2) || dev.get(0) != c2 || dev.get(1) != (c1 | dp) || dev.get(2) != 0) {
+					ng_("marquee loop");
+				}
+			}
+
+			// 8x8 マトリックス（１文字８カラム）
+			{
+				std::vector<uint8_t> font(0x5f * 8);
+				for(uint16_t i = 0; i < font.size(); ++i) font[i] = (i & 0x7f) | 0x80;
+				chain_.reset(CHAIN);
+				DEV dev(spi_);
+				dev.start();
+				chip::MAX7219_marquee<DEV> mq(dev, &font[0]);
+				static const char* text = "A\x01~";  // 0x01 は範囲外（空白）
+				mq.start(text);
+				uint32_t n = 0;
+				while(mq.step()) {
+					service_(dev, "matrix");
+					++n;
+				}
+				if(n != (24u + NUM)) ng_("matrix steps " + std::to_string(n));
+
+				mq.start(text);
+				for(uint32_t i = 0; i < 24; ++i) mq.step();
+				bool ok = true;
+				for(uint8_t i = 0; i < 24 && i < NUM; ++i) {
+					uint8_t col = 23 - i;
+					char ch = text[col / 8];
+					uint8_t e = 0;
+					if(ch >= 0x20 && ch < 0x7f) e = font[(ch - 0x20) * 8 + (col % 8)];
+					if(dev.get(i) != e) ok = false;
+				}
+				if(!ok) ng_("matrix columns");
+			}
+			if(chain_.errors != 0) ng_("bus errors " + std::to_string(chain_.errors));
+		}
+
+		uint32_t run()
+		{
+			check_start_();
+			uint32_t e = err_;
+			check_shift_();
+			uint32_t s = err_ - e;
+			e = err_;
+			check_marquee_();
+			uint32_t m = err_ - e;
+			std::cout << "CHAIN " << static_cast<int>(CHAIN) << ": service/refresh "
+				<< (err_ - s - m == 0 ? "OK" : "NG") << ", shift " << (s == 0 ? "OK" : "NG")
+				<< ", marquee " << (m == 0 ? "OK" : "NG") << std::endl;
+			return err_;
+		}
+	};
+}
+
+
+int main(int argc, char* argv[])
+{
+	bool verbose = false;
+	for(int i = 1; i < argc; ++i) {
+		std::string s = argv[i];
+		if(s == "-v") {
+			verbose = true;
+		} else {
+			std::cout << "MAX7219 daisy chain test" << std::endl;
+			std::cout << "usage: " << argv[0] << " [-v]" << std::endl;
+			return 0;
+		}
+	}
+
+	uint32_t err = 0;
+	err += test_t<1>(verbose).run();
+	err += test_t<2>(verbose).run();
+	err += test_t<4>(verbose).run();
+
+	std::cout << (err == 0 ? "Pass" : "Fail") << std::endl;
+	return err != 0 ? 1 : 0;
+}
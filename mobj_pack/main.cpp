@@ -0,0 +1,140 @@
+//=====================================================================//
+/*!	@file
+	@brief	PNG 画像を PackBits 圧縮モーションオブジェクトに変換するツール @n
+			出力は C の配列（先頭２バイトが幅と高さ、以降が圧縮ビット列）で、@n
+			monograph::draw_pmobj で描画する。@n
+			明るさが 128 以上のピクセルを「１」とする（-inv で反転）。@n
+			-raw は圧縮しない（draw_mobj 用、比較や検査に使う）。@n
+			使い方： mobj_pack [-offset x,y] [-size w,h] [-inv] [-append] [-raw] @n
+			         name input.png output.h @n
+			※座標には「2*20+9」の様な、加算と乗算の式が使える。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <png.h>
+#include "mobj_pack.hpp"
+
+namespace {
+
+	// 「a*b+c」形式の式
+	int eval_(const std::string& s)
+	{
+		int sum = 0;
+		size_t pos = 0;
+		while(pos <= s.size()) {
+			size_t e = s.find('+', pos);
+			if(e == std::string::npos) e = s.size();
+			std::string term = s.substr(pos, e - pos);
+			int mul = 1;
+			size_t p = 0;
+			while(p <= term.size()) {
+				size_t q = term.find('*', p);
+				if(q == std::string::npos) q = term.size();
+				mul *= std::atoi(term.substr(p, q - p).c_str());
+				p = q + 1;
+			}
+			sum += mul;
+			pos = e + 1;
+		}
+		return sum;
+	}
+
+
+	bool pair_(const std::string& s, int& a, int& b)
+	{
+		auto n = s.find(',');
+		if(n == std::string::npos) return false;
+		a = eval_(s.substr(0, n));
+		b = eval_(s.substr(n + 1));
+		return true;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	int ox = 0;
+	int oy = 0;
+	int w = -1;
+	int h = -1;
+	bool inv = false;
+	bool append = false;
+	bool raw = false;
+	std::vector<std::string> args;
+	for(int i = 1; i < argc; ++i) {
+		std::string s = argv[i];
+		if(s == "-offset" && (i + 1) < argc) {
+			pair_(argv[++i], ox, oy);
+		} else if(s == "-size" && (i + 1) < argc) {
+			pair_(argv[++i], w, h);
+		} else if(s == "-inv") {
+			inv = true;
+		} else if(s == "-append") {
+			append = true;
+		} else if(s == "-raw") {
+			raw = true;
+		} else {
+			args.push_back(s);
+		}
+	}
+	if(args.size() != 3) {
+		std::cout << "PNG to packed mobj converter" << std::endl;
+		std::cout << "usage: " << argv[0]
+			<< " [-offset x,y] [-size w,h] [-inv] [-append] [-raw] name input.png output.h" << std::endl;
+		return 0;
+	}
+
+	png_image img;
+	std::memset(&img, 0, sizeof(img));
+	img.version = PNG_IMAGE_VERSION;
+	if(!png_image_begin_read_from_file(&img, args[1].c_str())) {
+		std::cerr << "Can't open: '" << args[1] << "'" << std::endl;
+		return 1;
+	}
+	img.format = PNG_FORMAT_GRAY;
+	std::vector<uint8_t> gray(PNG_IMAGE_SIZE(img));
+	if(!png_image_finish_read(&img, nullptr, gray.data(), 0, nullptr)) {
+		std::cerr << "Can't decode: '" << args[1] << "'" << std::endl;
+		return 1;
+	}
+	if(w < 0) w = img.width - ox;
+	if(h < 0) h = img.height - oy;
+	if(w <= 0 || h <= 0 || w > 255 || h > 255) {
+		std::cerr << "Illegal size: " << w << ", " << h << std::endl;
+		return 1;
+	}
+
+	std::vector<uint8_t> bits((w * h + 7) / 8, 0);
+	for(int y = 0; y < h; ++y) {
+		for(int x = 0; x < w; ++x) {
+			int px = ox + x;
+			int py = oy + y;
+			bool c = false;
+			if(px >= 0 && px < static_cast<int>(img.width) && py >= 0 && py < static_cast<int>(img.height)) {
+				c = gray[py * img.width + px] >= 128;
+			}
+			if(inv) c = !c;
+			if(c) {
+				int pos = y * w + x;
+				bits[pos >> 3] |= 1 << (pos & 7);
+			}
+		}
+	}
+	std::ofstream ofs(args[2], append ? std::ios::app : std::ios::trunc);
+	if(!ofs) {
+		std::cerr << "Can't open: '" << args[2] << "'" << std::endl;
+		return 1;
+	}
+	tools::write_mobj(ofs, args[0], w, h, bits, !raw);
+	return 0;
+}
@@ -0,0 +1,87 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	PackBits 圧縮と、モーションオブジェクトの出力（ホスト用） @n
+			mobj_pack と、mono_bench（圧縮、展開の往復検査）で使う。@n
+			展開は common/packbits.hpp（utils::packbits_in）
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace tools {
+
+	//-----------------------------------------------------------------//
+	/*!
+		@brief	PackBits 圧縮 @n
+				２バイト以上の繰り返しは、繰り返し（最大１２８）にする
+		@param[in]	src	元データ
+		@return 圧縮データ
+	*/
+	//-----------------------------------------------------------------//
+	inline std::vector<uint8_t> packbits(const std::vector<uint8_t>& src)
+	{
+		std::vector<uint8_t> out;
+		size_t i = 0;
+		while(i < src.size()) {
+			size_t run = 1;
+			while((i + run) < src.size() && run < 128 && src[i + run] == src[i]) ++run;
+			if(run >= 2) {
+				out.push_back(static_cast<uint8_t>(257 - run));
+				out.push_back(src[i]);
+				i += run;
+				continue;
+			}
+			// ２バイト以上の繰り返しが始まるまでをそのまま
+			size_t n = 0;
+			while((i + n) < src.size() && n < 128) {
+				if((i + n + 1) < src.size() && src[i + n] == src[i + n + 1]) break;
+				++n;
+			}
+			out.push_back(static_cast<uint8_t>(n - 1));
+			out.insert(out.end(), src.begin() + i, src.begin() + i + n);
+			i += n;
+		}
+		return out;
+	}
+
+
+	//-----------------------------------------------------------------//
+	/*!
+		@brief	モーションオブジェクトを C の配列として出力 @n
+				先頭２バイトが幅と高さ、以降がビット列（圧縮、又は、そのまま）
+		@param[in]	ofs		出力
+		@param[in]	name	配列名
+		@param[in]	w		幅
+		@param[in]	h		高さ
+		@param[in]	bits	ビット列（行単位、LSB から）
+		@param[in]	pack	PackBits 圧縮する場合「true」
+	*/
+	//-----------------------------------------------------------------//
+	inline void write_mobj(std::ostream& ofs, const std::string& name, int w, int h,
+		const std::vector<uint8_t>& bits, bool pack)
+	{
+		auto out = pack ? packbits(bits) : bits;
+		ofs << std::dec;
+		ofs << "// " << w << " x " << h << ", " << bits.size() << " -> " << out.size() << " bytes"
+			<< (pack ? "" : " (raw)") << std::endl;
+		ofs << "static const uint8_t " << name << "[] = {" << std::endl;
+		ofs << "    0x" << std::hex << std::setw(2) << std::setfill('0') << w
+			<< ",0x" << std::setw(2) << h << ",";
+		int n = 2;
+		for(auto v : out) {
+			if((n & 15) == 0) ofs << std::endl << "    ";
+			ofs << "0x" << std::setw(2) << static_cast<int>(v) << ",";
+			++n;
+		}
+		ofs << " };" << std::endl;
+		ofs << std::dec << std::setfill(' ');
+	}
+}
@@ -0,0 +1,171 @@
+// 18 x 32, 72 -> 71 bytes
+static const uint8_t pnmb_0[] = {
+    0x12,0x20,0x04,0xfc,0xff,0xf8,0xff,0xf7,0xfd,0xff,0x35,0x1f,0xe0,0x3f,0x00,0xff,
+    0x00,0xfc,0x03,0xf0,0x0f,0xc0,0x3f,0x00,0xff,0x00,0xfc,0x03,0xf0,0x0f,0xc0,0x3f,
+    0x00,0xff,0x00,0xfc,0x03,0xf0,0x0f,0xc0,0x3f,0x00,0xff,0x00,0xfc,0x03,0xf0,0x0f,
+    0xc0,0x3f,0x00,0xff,0x00,0xfc,0x03,0xf0,0x0f,0xc0,0x3f,0x00,0xff,0x00,0xfc,0x07,
+    0xf8,0xfd,0xff,0x04,0xef,0xff,0x1f,0xff,0x3f, };
+// 18 x 32, 72 -> 73 bytes
+static const uint8_t pnmb_1[] = {
+    0x12,0x20,0x47,0x80,0x07,0x00,0x1f,0x00,0x7e,0x00,0xfc,0x01,0xf0,0x07,0x00,0x1e,
+    0x00,0x78,0x00,0xe0,0x01,0x80,0x07,0x00,0x1e,0x00,0x78,0x00,0xe0,0x01,0x80,0x07,
+    0x00,0x1e,0x00,0x78,0x00,0xe0,0x01,0x80,0x07,0x00,0x1e,0x00,0x78,0x00,0xe0,0x01,
+    0x80,0x07,0x00,0x1e,0x00,0x78,0x00,0xe0,0x01,0x80,0x07,0x00,0x1e,0x00,0x78,0x00,
+    0xe0,0x01,0xe0,0x1f,0x80,0x7f,0x00,0xfe,0x01,0xf8,0x07, };
+// 18 x 32, 72 -> 65 bytes
+static const uint8_t pnmb_2[] = {
+    0x12,0x20,0x04,0xfc,0xff,0xf8,0xff,0xf7,0xfd,0xff,0x35,0x1f,0xe0,0x3f,0x00,0xff,
+    0x00,0x3c,0x00,0xf0,0x00,0xc0,0x03,0x00,0x0f,0x00,0x3c,0x00,0xf0,0x00,0xe0,0x03,
+    0x80,0x0f,0x00,0x3f,0x00,0x7f,0xe0,0xff,0xe1,0xff,0xc3,0xff,0x87,0xff,0x07,0xfe,
+    0x00,0xfc,0x00,0xf0,0x01,0xc0,0x07,0x00,0x0f,0x00,0x3c,0x00,0xf0,0x00,0xc0,0x03,
+    0x00,0xf8,0xff, };
+// 18 x 32, 72 -> 69 bytes
+static const uint8_t pnmb_3[] = {
+    0x12,0x20,0xff,0xff,0x02,0xfc,0xff,0xf7,0xfd,0xff,0x35,0x00,0xe0,0x03,0x00,0x0f,
+    0x00,0x3c,0x00,0xf0,0x00,0xc0,0x03,0x00,0x0f,0x00,0x3c,0x00,0xf0,0x00,0xe0,0x03,
+    0xc0,0xcf,0xff,0x1f,0xff,0x3f,0xfc,0xff,0xf0,0xff,0x07,0x00,0x3f,0x00,0xf8,0x00,
+    0xc0,0x03,0x00,0x0f,0x00,0x3c,0x00,0xf0,0x00,0xc0,0x03,0x00,0x0f,0x00,0x3c,0x00,
+    0xf8,0xfb,0xff,0x02,0xdf,0xff,0x3f, };
+// 18 x 32, 72 -> 69 bytes
+static const uint8_t pnmb_4[] = {
+    0x12,0x20,0x02,0xe0,0xc3,0x83,0xff,0x0f,0x02,0x3e,0x3c,0x7c,0xff,0xf0,0x1d,0xc1,
+    0xc3,0x07,0x8f,0x0f,0x3c,0x3e,0xf0,0xf8,0xc0,0xf3,0x01,0xcf,0x07,0x3c,0x1f,0xf0,
+    0x3e,0xc0,0xfb,0x00,0xef,0x03,0xfc,0x07,0xf0,0x1f,0xc0,0x7f,0x00,0xf8,0xff,0x16,
+    0x0f,0x00,0x3c,0x00,0xf0,0x00,0xc0,0x03,0x00,0x0f,0x00,0x3c,0x00,0xf0,0x00,0xc0,
+    0x03,0x00,0x0f,0x00,0x3c,0x00,0xf0, };
+// 18 x 32, 72 -> 62 bytes
+static const uint8_t pnmb_5[] = {
+    0x12,0x20,0xf8,0xff,0x1a,0x0f,0x00,0x3c,0x00,0xf0,0x00,0xc0,0x03,0x00,0x0f,0x00,
+    0x3c,0x00,0xf0,0x00,0xc0,0x03,0x00,0x0f,0x00,0x3c,0x00,0xf0,0xff,0xcf,0xff,0x7f,
+    0xfd,0xff,0x16,0x0f,0x00,0x3e,0x00,0xf0,0x00,0xc0,0x03,0x00,0x0f,0x00,0x3c,0x00,
+    0xf0,0x00,0xc0,0x03,0x00,0x0f,0x00,0x3c,0x00,0xf8,0xfb,0xff,0x02,0xdf,0xff,0x3f, };
+// 18 x 32, 72 -> 69 bytes
+static const uint8_t pnmb_6[] = {
+    0x12,0x20,0x04,0xfc,0xff,0xf8,0xff,0xf7,0xfd,0xff,0x1a,0x1f,0xe0,0x3f,0x00,0xff,
+    0x00,0xfc,0x03,0x00,0x0f,0x00,0x3c,0x00,0xf0,0x00,0xc0,0x03,0x00,0x0f,0x00,0x3c,
+    0x00,0xf0,0xff,0xcf,0xff,0x7f,0xfc,0xff,0x15,0x00,0xfe,0x03,0xf0,0x0f,0xc0,0x3f,
+    0x00,0xff,0x00,0xfc,0x03,0xf0,0x0f,0xc0,0x3f,0x00,0xff,0x00,0xfc,0x07,0xf8,0xfd,
+    0xff,0x04,0xef,0xff,0x1f,0xff,0x3f, };
+// 18 x 32, 72 -> 72 bytes
+static const uint8_t pnmb_7[] = {
+    0x12,0x20,0xff,0xff,0x02,0xfc,0xff,0xf7,0xfd,0xff,0x3e,0x00,0xf0,0x03,0x80,0x0f,
+    0x00,0x3e,0x00,0xf8,0x00,0xf0,0x01,0xc0,0x07,0x00,0x1f,0x00,0x3e,0x00,0xf8,0x00,
+    0xe0,0x03,0xc0,0x07,0x00,0x1f,0x00,0x7c,0x00,0xf8,0x00,0xe0,0x03,0x80,0x0f,0x00,
+    0x1f,0x00,0x7c,0x00,0xf0,0x01,0xe0,0x03,0x80,0x0f,0x00,0x3e,0x00,0x7c,0x00,0xf0,
+    0x01,0xc0,0x07,0x80,0x0f,0x00,0x3e,0x00,0xf8,0x00, };
+// 18 x 32, 72 -> 71 bytes
+static const uint8_t pnmb_8[] = {
+    0x12,0x20,0x04,0xfc,0xff,0xf8,0xff,0xf7,0xfd,0xff,0x35,0x1f,0xe0,0x3f,0x00,0xff,
+    0x00,0xfc,0x03,0xf0,0x0f,0xc0,0x3f,0x00,0xff,0x00,0xfc,0x03,0xf0,0x1f,0xe0,0xff,
+    0xc0,0xef,0xff,0x1f,0xff,0x3f,0xfc,0xff,0xf8,0xff,0xf7,0x03,0xff,0x07,0xf8,0x0f,
+    0xc0,0x3f,0x00,0xff,0x00,0xfc,0x03,0xf0,0x0f,0xc0,0x3f,0x00,0xff,0x00,0xfc,0x07,
+    0xf8,0xfd,0xff,0x04,0xef,0xff,0x1f,0xff,0x3f, };
+// 18 x 32, 72 -> 67 bytes
+static const uint8_t pnmb_9[] = {
+    0x12,0x20,0x04,0xfc,0xff,0xf8,0xff,0xf7,0xfd,0xff,0x15,0x1f,0xe0,0x3f,0x00,0xff,
+    0x00,0xfc,0x03,0xf0,0x0f,0xc0,0x3f,0x00,0xff,0x00,0xfc,0x03,0xf0,0x0f,0xc0,0x7f,
+    0x00,0xfc,0xff,0x1a,0xfe,0xff,0xf3,0xff,0x0f,0x00,0x3c,0x00,0xf0,0x00,0xc0,0x03,
+    0x00,0x0f,0x00,0x3c,0x00,0xf0,0x00,0xc0,0x03,0x00,0x0f,0x00,0x3c,0x00,0xf8,0xfb,
+    0xff,0x02,0xdf,0xff,0x3f, };
+// 19 x 32, 76 -> 40 bytes
+static const uint8_t ptxt_hz[] = {
+    0x13,0x20,0xd7,0x00,0xff,0xc0,0x00,0x00,0xff,0x06,0xff,0x30,0x02,0x80,0x81,0x01,
+    0xff,0x0c,0xff,0x60,0x05,0x00,0xff,0xf3,0xff,0x9f,0xff,0xff,0xc0,0xff,0x06,0x09,
+    0x33,0x30,0x8c,0x81,0x31,0x0c,0xcc,0x7f,0x60,0xfe, };
+// 9 x 32, 36 -> 19 bytes
+static const uint8_t ptxt_k[] = {
+    0x09,0x20,0xed,0x00,0x0f,0x0c,0x18,0x30,0x78,0xd8,0x98,0x19,0x1b,0x1e,0x3c,0xd8,
+    0x30,0x63,0xcc,0xb0,0xc1, };
+// 128 x 64, 1024 -> 1024 bytes (raw)
+static const uint8_t screen_raw[] = {
+    0x80,0x40,0xff,0x00,0x18,0x00,0xff,0x00,0xff,0x00,0xc3,0x00,0xff,0x00,0xff,0x00,
+    0xff,0x00,0xff,0x00,0x18,0x00,0xff,0x00,0xff,0x00,0xc3,0x00,0xff,0x00,0xff,0x00,
+    0xff,0x00,0xc3,0x00,0x18,0x00,0xc0,0x00,0xc0,0x00,0xc3,0x00,0x03,0x00,0x03,0x00,
+    0xc0,0x00,0xc3,0x00,0x18,0x00,0xc0,0x00,0xc0,0x00,0xc3,0x00,0x03,0x00,0x03,0x00,
+    0xc0,0x00,0xc3,0x00,0x18,0x00,0xc0,0x00,0xc0,0x00,0xc3,0x00,0x03,0x00,0x03,0x00,
+    0xc0,0x00,0xc3,0x00,0x18,0x00,0xff,0x00,0xfe,0x00,0xff,0x00,0xff,0x00,0xff,0x00,
+    0xc0,0x00,0xc3,0x00,0x18,0x00,0xff,0x00,0xfe,0x00,0xff,0x00,0xff,0x00,0xff,0x00,
+    0xc0,0x00,0xc3,0x00,0x18,0x00,0x03,0x00,0xc0,0x00,0xc0,0x00,0xc0,0x00,0xc3,0x00,
+    0xc0,0x00,0xc3,0x00,0x18,0x00,0x03,0x00,0xc0,0x00,0xc0,0x00,0xc0,0x00,0xc3,0x00,
+    0xc0,0x00,0xc3,0x00,0x18,0x00,0x03,0x00,0xc0,0x00,0xc0,0x00,0xc0,0x00,0xc3,0x00,
+    0xc0,0x00,0xff,0x00,0x18,0x00,0xff,0x00,0xff,0x00,0xc0,0x00,0xff,0x00,0xff,0x00,
+    0xc0,0x00,0xff,0x00,0x18,0x00,0xff,0x00,0xff,0x00,0xc0,0x00,0xff,0x00,0xff,0x00,
+    0xc0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0xc3,0x00,0x7e,0x00,0x06,0x00,0xff,0xff,0x07,0x00,0xbf,0xb1,0x1f,0x00,
+    0x00,0x00,0xc3,0x00,0xff,0x00,0x09,0x00,0xff,0xff,0x07,0x00,0xbf,0xb1,0x1f,0x00,
+    0x00,0x00,0xc3,0x00,0xc3,0x00,0x09,0x00,0x23,0x22,0x06,0x00,0x83,0x31,0x06,0x00,
+    0x00,0x00,0x66,0x00,0x03,0x00,0x06,0x00,0x23,0x22,0x1e,0x00,0x03,0x1b,0x06,0x00,
+    0x00,0x00,0x66,0x00,0x03,0x00,0x00,0x00,0x23,0x22,0x1e,0x00,0x1f,0x0e,0x06,0x00,
+    0x00,0x00,0x66,0x00,0x03,0x00,0x00,0x00,0x23,0x22,0x1e,0x00,0x1f,0x0e,0x06,0x00,
+    0x00,0x00,0x3c,0x00,0x03,0x00,0x00,0x00,0x23,0x22,0x1e,0x00,0x03,0x1b,0x06,0x00,
+    0x00,0x00,0x3c,0x00,0x03,0x00,0x00,0x00,0x23,0x22,0x06,0x00,0x83,0x31,0x06,0x00,
+    0x00,0x00,0x3c,0x00,0x03,0x00,0x00,0x00,0xff,0xff,0x07,0x00,0xbf,0x31,0x06,0x00,
+    0x00,0x00,0x18,0x00,0xc3,0x00,0x00,0x00,0xff,0xff,0x07,0x00,0xbf,0x31,0x06,0x00,
+    0x00,0x00,0x18,0x00,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x18,0x00,0x7e,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00, };
+// 128 x 64, 1024 -> 377 bytes
+static const uint8_t screen_pack[] = {
+    0x80,0x40,0x7f,0xff,0x00,0x18,0x00,0xff,0x00,0xff,0x00,0xc3,0x00,0xff,0x00,0xff,
+    0x00,0xff,0x00,0xff,0x00,0x18,0x00,0xff,0x00,0xff,0x00,0xc3,0x00,0xff,0x00,0xff,
+    0x00,0xff,0x00,0xc3,0x00,0x18,0x00,0xc0,0x00,0xc0,0x00,0xc3,0x00,0x03,0x00,0x03,
+    0x00,0xc0,0x00,0xc3,0x00,0x18,0x00,0xc0,0x00,0xc0,0x00,0xc3,0x00,0x03,0x00,0x03,
+    0x00,0xc0,0x00,0xc3,0x00,0x18,0x00,0xc0,0x00,0xc0,0x00,0xc3,0x00,0x03,0x00,0x03,
+    0x00,0xc0,0x00,0xc3,0x00,0x18,0x00,0xff,0x00,0xfe,0x00,0xff,0x00,0xff,0x00,0xff,
+    0x00,0xc0,0x00,0xc3,0x00,0x18,0x00,0xff,0x00,0xfe,0x00,0xff,0x00,0xff,0x00,0xff,
+    0x00,0xc0,0x00,0xc3,0x00,0x18,0x00,0x03,0x00,0xc0,0x00,0xc0,0x00,0xc0,0x00,0xc3,
+    0x00,0xc0,0x00,0x3e,0xc3,0x00,0x18,0x00,0x03,0x00,0xc0,0x00,0xc0,0x00,0xc0,0x00,
+    0xc3,0x00,0xc0,0x00,0xc3,0x00,0x18,0x00,0x03,0x00,0xc0,0x00,0xc0,0x00,0xc0,0x00,
+    0xc3,0x00,0xc0,0x00,0xff,0x00,0x18,0x00,0xff,0x00,0xff,0x00,0xc0,0x00,0xff,0x00,
+    0xff,0x00,0xc0,0x00,0xff,0x00,0x18,0x00,0xff,0x00,0xff,0x00,0xc0,0x00,0xff,0x00,
+    0xff,0x00,0xc0,0xc0,0x00,0x05,0xc3,0x00,0x7e,0x00,0x06,0x00,0xff,0xff,0x04,0x07,
+    0x00,0xbf,0xb1,0x1f,0xfe,0x00,0x05,0xc3,0x00,0xff,0x00,0x09,0x00,0xff,0xff,0x04,
+    0x07,0x00,0xbf,0xb1,0x1f,0xfe,0x00,0x0c,0xc3,0x00,0xc3,0x00,0x09,0x00,0x23,0x22,
+    0x06,0x00,0x83,0x31,0x06,0xfe,0x00,0x0c,0x66,0x00,0x03,0x00,0x06,0x00,0x23,0x22,
+    0x1e,0x00,0x03,0x1b,0x06,0xfe,0x00,0x02,0x66,0x00,0x03,0xfe,0x00,0x06,0x23,0x22,
+    0x1e,0x00,0x1f,0x0e,0x06,0xfe,0x00,0x02,0x66,0x00,0x03,0xfe,0x00,0x06,0x23,0x22,
+    0x1e,0x00,0x1f,0x0e,0x06,0xfe,0x00,0x02,0x3c,0x00,0x03,0xfe,0x00,0x06,0x23,0x22,
+    0x1e,0x00,0x03,0x1b,0x06,0xfe,0x00,0x02,0x3c,0x00,0x03,0xfe,0x00,0x06,0x23,0x22,
+    0x06,0x00,0x83,0x31,0x06,0xfe,0x00,0x02,0x3c,0x00,0x03,0xfe,0x00,0xff,0xff,0x04,
+    0x07,0x00,0xbf,0x31,0x06,0xfe,0x00,0x02,0x18,0x00,0xc3,0xfe,0x00,0xff,0xff,0x04,
+    0x07,0x00,0xbf,0x31,0x06,0xfe,0x00,0x02,0x18,0x00,0xff,0xf4,0x00,0x02,0x18,0x00,
+    0x7e,0x81,0x00,0x81,0x00,0x81,0x00,0x81,0x00,0xb4,0x00, };
@@ -0,0 +1,206 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	ホスト用フレームバッファ・クラス @n
+			１ピクセルを１バイトで持つ、最も単純な PLOT の実装。@n
+			operator() だけを持つので、monograph は点単位で描画する。@n
+			（page_fb 等、最適化した PLOT の結果と比較する基準になる）@n
+			PBM、PNG での保存と、PBM の読み込みが出来る。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <fstream>
+#include <png.h>
+
+namespace graphics {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	ホスト用フレームバッファ・クラス
+		@param[in]	W	横幅
+		@param[in]	H	高さ
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <int16_t W, int16_t H>
+	class host_fb {
+	public:
+		typedef int16_t value_type;
+
+		static const int16_t WIDTH  = W;
+		static const int16_t HEIGHT = H;
+
+	private:
+		uint8_t		fb_[W * H];
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		host_fb() { clear(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	全体をクリア
+			@param[in]	c	カラー
+		*/
+		//-----------------------------------------------------------------//
+		void clear(bool c = false)
+		{
+			for(int32_t i = 0; i < (W * H); ++i) fb_[i] = c;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	点を描画
+			@param[in]	x	位置 X
+			@param[in]	y	位置 Y
+			@param[in]	c	カラー
+		*/
+		//-----------------------------------------------------------------//
+		void operator() (value_type x, value_type y, bool c)
+		{
+			if(x < 0 || x >= WIDTH) return;
+			if(y < 0 || y >= HEIGHT) return;
+			fb_[y * WIDTH + x] = c;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	点を取得
+			@param[in]	x	位置 X
+			@param[in]	y	位置 Y
+			@return カラー
+		*/
+		//-----------------------------------------------------------------//
+		bool get(value_type x, value_type y) const
+		{
+			return fb_[y * WIDTH + x] != 0;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ページ構成のフレームバッファ（page_fb の fb()）から設定
+			@param[in]	src	ソース
+		*/
+		//-----------------------------------------------------------------//
+		void set_pages(const uint8_t* src)
+		{
+			for(int16_t y = 0; y < HEIGHT; ++y) {
+				for(int16_t x = 0; x < WIDTH; ++x) {
+					fb_[y * WIDTH + x] = (src[(y >> 3) * WIDTH + x] >> (y & 7)) & 1;
+				}
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	一致するか検査
+			@param[in]	src	比較対象
+			@return 異なるピクセル数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t compare(const host_fb& src) const
+		{
+			uint32_t n = 0;
+			for(int32_t i = 0; i < (W * H); ++i) {
+				if(fb_[i] != src.fb_[i]) ++n;
+			}
+			return n;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	PBM（P4 バイナリー）で保存
+			@param[in]	file	ファイル名
+			@return 成功なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool save_pbm(const std::string& file) const
+		{
+			std::ofstream ofs(file, std::ios::binary);
+			if(!ofs) return false;
+			ofs << "P4\n" << WIDTH << ' ' << HEIGHT << '\n';
+			for(int16_t y = 0; y < HEIGHT; ++y) {
+				uint8_t v = 0;
+				for(int16_t x = 0; x < WIDTH; ++x) {
+					v <<= 1;
+					if(get(x, y)) v |= 1;
+					if((x & 7) == 7) {
+						ofs.put(v);
+						v = 0;
+					}
+				}
+				if(WIDTH & 7) ofs.put(v << (8 - (WIDTH & 7)));
+			}
+			return static_cast<bool>(ofs);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	PBM（P4 バイナリー）を読み込む
+			@param[in]	file	ファイル名
+			@return サイズが異なる場合、読めない場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool load_pbm(const std::string& file)
+		{
+			std::ifstream ifs(file, std::ios::binary);
+			if(!ifs) return false;
+			std::string id;
+			int w = 0;
+			int h = 0;
+			ifs >> id >> w >> h;
+			if(id != "P4" || w != WIDTH || h != HEIGHT) return false;
+			ifs.get();  // 区切りの空白
+			for(int16_t y = 0; y < HEIGHT; ++y) {
+				uint8_t v = 0;
+				for(int16_t x = 0; x < WIDTH; ++x) {
+					if((x & 7) == 0) v = ifs.get();
+					fb_[y * WIDTH + x] = (v >> (7 - (x & 7))) & 1;
+				}
+			}
+			return static_cast<bool>(ifs);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	PNG（グレースケール）で保存
+			@param[in]	file	ファイル名
+			@param[in]	scale	拡大率
+			@return 成功なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool save_png(const std::string& file, int scale = 4) const
+		{
+			png_image img;
+			std::memset(&img, 0, sizeof(img));
+			img.version = PNG_IMAGE_VERSION;
+			img.width = WIDTH * scale;
+			img.height = HEIGHT * scale;
+			img.format = PNG_FORMAT_GRAY;
+			std::string tmp(img.width * img.height, 0);
+			for(uint32_t y = 0; y < img.height; ++y) {
+				for(uint32_t x = 0; x < img.width; ++x) {
+					if(get(x / scale, y / scale)) tmp[y * img.width + x] = static_cast<char>(255);
+				}
+			}
+			return png_image_write_to_file(&img, file.c_str(), 0, tmp.data(), 0, nullptr) != 0;
+		}
+	};
+}
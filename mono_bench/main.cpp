@@ -0,0 +1,607 @@
+//=====================================================================//
+/*!	@file
+	@brief	monograph 描画ベンチマーク @n
+			host_fb（点単位）と page_fb（バイト単位）の両方で描画して、@n
+			描画毎の処理回数（ops/s）を表示する。@n
+			（line、fill、text、image、level、circle）@n
+			描画結果は、二つの PLOT で一致するかを常に検査する。@n
+			文字（glyph）は、page_fb で、点単位（font6x12）と、ページ構成の @n
+			テーブル（font6x12_page）からの書き込みを比べる。@n
+			-save で基準画像（PBM）を保存し、-check で基準画像と比較する。@n
+			基準画像は golden にあり、mono_bench -check golden で検査する。@n
+			圧縮イメージ（pack）は、同じ素材を draw_image（draw_mobj）と、@n
+			draw_image_pack（draw_pmobj）で描画して比べ、描画結果の一致も @n
+			検査する。素材の font32 は、bmc の出力（PLUSE_OUT_LCD/bitmap）と、@n
+			mobj_pack の出力（bitmap/pmobj.h）で、展開結果の一致も検査する。@n
+			使い方： mono_bench [-time ms] [-save dir] [-check dir] [-png dir]
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "common/monograph.hpp"
+#include "common/page_fb.hpp"
+#include "common/font6x12.hpp"
+#include "host_fb.hpp"
+#include "mobj_pack/mobj_pack.hpp"
+#include "PLUSE_OUT_LCD/bitmap/font32.h"
+#include "bitmap/pmobj.h"
+
+namespace {
+
+	static const int16_t WIDTH = 128;
+	static const int16_t HEIGHT = 64;
+
+	typedef graphics::host_fb<WIDTH, HEIGHT> HOST;
+	typedef graphics::page_fb<WIDTH, HEIGHT> PAGE;
+
+	graphics::kfont_null kfont_;
+
+	// 基準画像を作る時の描画回数
+	static const uint32_t golden_loop_ = 64;
+
+	// 再現性のある乱数
+	class rand_t {
+		uint32_t	v_;
+	public:
+		rand_t() : v_(1) { }
+		uint16_t operator() (uint16_t n) {
+			v_ = v_ * 1103515245 + 12345;
+			return (v_ >> 16) % n;
+		}
+	};
+
+	// 24 x 20 のイメージ（行単位、LSB から）
+	uint8_t bits_[(24 * 20 + 7) / 8];
+
+	void make_image_()
+	{
+		for(int y = 0; y < 20; ++y) {
+			for(int x = 0; x < 24; ++x) {
+				int dx = x - 12;
+				int dy = y - 10;
+				int r = dx * dx + dy * dy;
+				if(r < 90 && (r > 40 || ((x ^ y) & 2))) {
+					int pos = y * 24 + x;
+					bits_[pos >> 3] |= 1 << (pos & 7);
+				}
+			}
+		}
+	}
+
+
+	template <class MONO>
+	void line_(MONO& m, rand_t& r)
+	{
+		int16_t x0 = r(WIDTH);
+		int16_t y0 = r(HEIGHT);
+		int16_t x1 = r(WIDTH);
+		int16_t y1 = r(HEIGHT);
+		m.line(x0, y0, x1, y1, r(4) != 0);
+	}
+
+
+	template <class MONO>
+	void fill_(MONO& m, rand_t& r)
+	{
+		int16_t x = r(WIDTH + 16) - 8;
+		int16_t y = r(HEIGHT + 16) - 8;
+		int16_t w = r(48) + 1;
+		int16_t h = r(32) + 1;
+		m.fill(x, y, w, h, r(2) != 0);
+	}
+
+
+	template <class MONO>
+	void text_(MONO& m, rand_t& r)
+	{
+		static const char* text[] = {
+			"Hello R8C/M120AN", "0123456789 +-*/", "monograph bench", "ABCDEFGHIJKLMNOP"
+		};
+		int16_t x = r(WIDTH) - 16;
+		int16_t y = r(HEIGHT) - 6;
+		const char* t = text[r(4)];
+		m.draw_text(x, y, t, r(2) != 0);
+	}
+
+
+	template <class MONO>
+	void glyph_(MONO& m, rand_t& r)
+	{
+		int16_t x = r(WIDTH + 12) - 6;
+		int16_t y = r(HEIGHT + 12) - 6;
+		m.draw_font(x, y, static_cast<char>(0x20 + r(0x60)));
+	}
+
+
+	template <class MONO>
+	void image_(MONO& m, rand_t& r)
+	{
+		int16_t x = r(WIDTH) - 8;
+		int16_t y = r(HEIGHT) - 8;
+		m.draw_image(x, y, bits_, 24, 20);
+	}
+
+
+	// bits_ を mobj_pack で圧縮したもの
+	std::vector<uint8_t> bits_pack_;
+
+	// 13 x 21 のイメージ（ビット数が８の倍数ではなく、最後が０の繰り返し）
+	uint8_t odd_bits_[(13 * 21 + 7) / 8];
+	std::vector<uint8_t> odd_bits_pack_;
+
+	void make_odd_()
+	{
+		for(int y = 0; y < 8; ++y) {
+			for(int x = 0; x < 13; ++x) {
+				if(((x + y) % 5) == 0) {
+					int pos = y * 13 + x;
+					odd_bits_[pos >> 3] |= 1 << (pos & 7);
+				}
+			}
+		}
+	}
+
+	template <class MONO, bool PACK>
+	void image_pack_(MONO& m, rand_t& r)
+	{
+		int16_t x = r(WIDTH + 24) - 24;
+		int16_t y = r(HEIGHT + 20) - 20;
+		if(PACK) m.draw_image_pack(x, y, &bits_pack_[0], 24, 20);
+		else m.draw_image(x, y, bits_, 24, 20);
+	}
+
+
+	template <class MONO, bool PACK>
+	void odd_pack_(MONO& m, rand_t& r)
+	{
+		int16_t x = r(WIDTH + 13) - 13;
+		int16_t y = r(HEIGHT + 21) - 21;
+		if(PACK) m.draw_image_pack(x, y, &odd_bits_pack_[0], 13, 21);
+		else m.draw_image(x, y, odd_bits_, 13, 21);
+	}
+
+
+	// font32（bmc の出力と、mobj_pack の出力）
+	struct mobj_t {
+		const uint8_t*	raw;
+		const uint8_t*	pack;
+		uint32_t		pack_size;
+	};
+
+#define MOBJ_(raw, pack) { raw, pack, sizeof(pack) - 2 }
+	const mobj_t font32_[] = {
+		MOBJ_(nmb_0, pnmb_0), MOBJ_(nmb_1, pnmb_1), MOBJ_(nmb_2, pnmb_2), MOBJ_(nmb_3, pnmb_3),
+		MOBJ_(nmb_4, pnmb_4), MOBJ_(nmb_5, pnmb_5), MOBJ_(nmb_6, pnmb_6), MOBJ_(nmb_7, pnmb_7),
+		MOBJ_(nmb_8, pnmb_8), MOBJ_(nmb_9, pnmb_9), MOBJ_(txt_hz, ptxt_hz), MOBJ_(txt_k, ptxt_k),
+	};
+	const mobj_t screen_ = MOBJ_(screen_raw, screen_pack);
+#undef MOBJ_
+
+	template <class MONO, bool PACK>
+	void font32_pack_(MONO& m, rand_t& r)
+	{
+		const mobj_t& o = font32_[r(12)];
+		int16_t x = r(WIDTH + 20) - 20;
+		int16_t y = r(HEIGHT + 32) - 32;
+		if(PACK) m.draw_pmobj(x, y, o.pack);
+		else m.draw_mobj(x, y, o.raw);
+	}
+
+
+	template <class MONO, bool PACK>
+	void screen_pack_(MONO& m, rand_t& r)
+	{
+		int16_t x = r(WIDTH) - WIDTH / 2;
+		int16_t y = r(HEIGHT) - HEIGHT / 2;
+		if(PACK) m.draw_pmobj(x, y, screen_.pack);
+		else m.draw_mobj(x, y, screen_.raw);
+	}
+
+
+	// 圧縮したものを展開して、元と比べる（get、get_run、skip_run を混ぜる）
+	bool unpack_(const uint8_t* pack, const uint8_t* raw, uint32_t len, rand_t& r)
+	{
+		utils::packbits_in in(pack);
+		uint32_t i = 0;
+		while(i < len) {
+			uint8_t v = in.get();
+			if(v != raw[i]) return false;
+			++i;
+			uint8_t run = in.get_run();
+			if(run > 0 && r(2) != 0) {
+				uint8_t n = r(run) + 1;
+				if((i + n) > len) return false;
+				for(uint8_t j = 0; j < n; ++j) {
+					if(raw[i + j] != v) return false;
+				}
+				in.skip_run(n);
+				i += n;
+			}
+		}
+		return true;
+	}
+
+
+	// mobj_pack の出力を展開して、bmc の出力と比べる
+	uint32_t check_mobj_(const mobj_t& o, rand_t& r)
+	{
+		if(o.raw[0] != o.pack[0] || o.raw[1] != o.pack[1]) return 1;
+		uint32_t len = (o.raw[0] * o.raw[1] + 7) / 8;
+		// 展開の方法を変えて試す
+		uint32_t err = 0;
+		for(uint32_t i = 0; i < 16; ++i) {
+			if(!unpack_(o.pack + 2, o.raw + 2, len, r)) ++err;
+		}
+		return err;
+	}
+
+
+	// 境界になる長さの繰り返し、そのままの並び、乱数で、圧縮と展開の往復
+	uint32_t check_round_trip_(rand_t& r)
+	{
+		std::vector<std::vector<uint8_t> > src;
+		static const uint32_t len[] = { 1, 2, 3, 127, 128, 129, 130, 255, 256, 257, 300 };
+		for(auto n : len) {
+			src.push_back(std::vector<uint8_t>(n, 0x00));	// 繰り返し
+			std::vector<uint8_t> lit;
+			for(uint32_t i = 0; i < n; ++i) lit.push_back(i);	// そのまま
+			src.push_back(lit);
+			lit.push_back(lit.back());	// そのままの後に繰り返し
+			lit.push_back(lit.back());
+			src.push_back(lit);
+		}
+		for(uint32_t i = 0; i < 200; ++i) {
+			std::vector<uint8_t> v;
+			uint32_t n = r(600) + 1;
+			uint16_t k = r(3) == 0 ? 256 : 3;  // 値の種類が少ないと、繰り返しが多い
+			for(uint32_t j = 0; j < n; ++j) v.push_back(r(k));
+			src.push_back(v);
+		}
+		uint32_t err = 0;
+		for(const auto& v : src) {
+			auto pack = tools::packbits(v);
+			pack.push_back(0x80);	// 余分に読まない事を確かめる為の番兵
+			if(!unpack_(&pack[0], &v[0], v.size(), r)) ++err;
+		}
+		// 128（何もしない）を挟んだ列
+		static const uint8_t nop[] = { 0x80, 0x01, 0x12, 0x34, 0x80, 0x80, 0xfe, 0x56 };
+		static const uint8_t out[] = { 0x12, 0x34, 0x56, 0x56, 0x56 };
+		if(!unpack_(nop, out, sizeof(out), r)) ++err;
+		return err;
+	}
+
+
+	template <class MONO>
+	void level_(MONO& m, rand_t& r)
+	{
+		int16_t y = r(HEIGHT - 8);
+		int16_t x = r(16);
+		int16_t w = r(80) + 32;
+		int16_t h = r(6) + 4;
+		m.draw_holizontal_level(x, y, w, h, r(120));
+	}
+
+
+	template <class MONO>
+	void circle_(MONO& m, rand_t& r)
+	{
+		// 引数の評価順に依らない様に、乱数は順番に取る
+		int16_t x = r(WIDTH);
+		int16_t y = r(HEIGHT);
+		switch(r(4)) {
+		case 0:
+			m.circle(x, y, r(24), true);
+			break;
+		case 1:
+			{
+				int16_t rad = r(24);
+				m.fill_circle(x, y, rad, r(2) != 0);
+			}
+			break;
+		case 2:
+			{
+				int16_t w = r(48) + 1;
+				int16_t h = r(24) + 1;
+				int16_t rad = r(8);
+				m.round_fill(x - 16, y - 8, w, h, rad, r(2) != 0);
+			}
+			break;
+		default:
+			{
+				int16_t len = r(24);
+				m.needle(x, y, 0, len, r(256), true);
+			}
+			break;
+		}
+	}
+
+
+	template <class PLOT, class AFONT = graphics::font6x12>
+	struct bench_t {
+		typedef graphics::monograph<PLOT, AFONT> MONO;
+		typedef void (*func_type)(MONO& m, rand_t& r);
+
+		// 指定時間、描画を繰り返す
+		static double ops(func_type func, uint32_t ms)
+		{
+			MONO m(kfont_);
+			rand_t r;
+			uint32_t n = 0;
+			auto org = std::chrono::steady_clock::now();
+			auto end = org + std::chrono::milliseconds(ms);
+			auto now = org;
+			do {
+				for(uint32_t i = 0; i < 256; ++i) func(m, r);
+				n += 256;
+				now = std::chrono::steady_clock::now();
+			} while(now < end);
+			double t = std::chrono::duration<double>(now - org).count();
+			return static_cast<double>(n) / t;
+		}
+
+		// 基準画像用の描画
+		static void render(func_type func, MONO& m)
+		{
+			rand_t r;
+			for(uint32_t i = 0; i < golden_loop_; ++i) func(m, r);
+		}
+	};
+
+
+	struct scene_t {
+		const char*		name;
+		bench_t<HOST>::func_type	host;
+		bench_t<PAGE>::func_type	page;
+	};
+
+	const scene_t scene_[] = {
+		{ "line",  line_<bench_t<HOST>::MONO>,  line_<bench_t<PAGE>::MONO> },
+		{ "fill",  fill_<bench_t<HOST>::MONO>,  fill_<bench_t<PAGE>::MONO> },
+		{ "text",  text_<bench_t<HOST>::MONO>,  text_<bench_t<PAGE>::MONO> },
+		{ "image", image_<bench_t<HOST>::MONO>, image_<bench_t<PAGE>::MONO> },
+		{ "level", level_<bench_t<HOST>::MONO>, level_<bench_t<PAGE>::MONO> },
+		{ "circle", circle_<bench_t<HOST>::MONO>, circle_<bench_t<PAGE>::MONO> },
+	};
+
+	typedef bench_t<PAGE, graphics::font6x12_page> STRIKE;
+
+	struct pack_scene_t {
+		const char*		name;
+		bench_t<HOST>::func_type	host_raw;
+		bench_t<HOST>::func_type	host_pack;
+		bench_t<PAGE>::func_type	page_raw;
+		bench_t<PAGE>::func_type	page_pack;
+		void (*size)(uint32_t& raw, uint32_t& pack);	///< 素材のバイト数
+	};
+
+	void image_size_(uint32_t& raw, uint32_t& pack)
+	{
+		raw = sizeof(bits_);
+		pack = bits_pack_.size();
+	}
+
+	void odd_size_(uint32_t& raw, uint32_t& pack)
+	{
+		raw = sizeof(odd_bits_);
+		pack = odd_bits_pack_.size();
+	}
+
+	void font32_size_(uint32_t& raw, uint32_t& pack)
+	{
+		raw = 0;
+		pack = 0;
+		for(const auto& o : font32_) {
+			raw += (o.raw[0] * o.raw[1] + 7) / 8;
+			pack += o.pack_size;
+		}
+	}
+
+	void screen_size_(uint32_t& raw, uint32_t& pack)
+	{
+		raw = (screen_.raw[0] * screen_.raw[1] + 7) / 8;
+		pack = screen_.pack_size;
+	}
+
+#define PACK_SCENE_(name, func) { #name, func<bench_t<HOST>::MONO, false>, \
+	func<bench_t<HOST>::MONO, true>, func<bench_t<PAGE>::MONO, false>, func<bench_t<PAGE>::MONO, true>, name##_size_ }
+	const pack_scene_t pack_scene_[] = {
+		PACK_SCENE_(image,  image_pack_),
+		PACK_SCENE_(odd,    odd_pack_),
+		PACK_SCENE_(font32, font32_pack_),
+		PACK_SCENE_(screen, screen_pack_),
+	};
+#undef PACK_SCENE_
+}
+
+
+int main(int argc, char* argv[])
+{
+	uint32_t ms = 200;
+	std::string save;
+	std::string check;
+	std::string png;
+	for(int i = 1; i < argc; ++i) {
+		std::string s = argv[i];
+		if(s == "-time" && (i + 1) < argc) {
+			ms = std::atoi(argv[++i]);
+		} else if(s == "-save" && (i + 1) < argc) {
+			save = argv[++i];
+		} else if(s == "-check" && (i + 1) < argc) {
+			check = argv[++i];
+		} else if(s == "-png" && (i + 1) < argc) {
+			png = argv[++i];
+		} else {
+			std::cout << "monograph render benchmark" << std::endl;
+			std::cout << "usage: " << argv[0]
+				<< " [-time ms] [-save dir] [-check dir] [-png dir]" << std::endl;
+			return 0;
+		}
+	}
+
+	make_image_();
+	make_odd_();
+	bits_pack_ = tools::packbits(std::vector<uint8_t>(bits_, bits_ + sizeof(bits_)));
+	odd_bits_pack_ = tools::packbits(std::vector<uint8_t>(odd_bits_, odd_bits_ + sizeof(odd_bits_)));
+
+	int err = 0;
+	std::cout << "scene      host_fb(ops/s)  page_fb(ops/s)  result" << std::endl;
+	for(const auto& sc : scene_) {
+		double h = ms > 0 ? bench_t<HOST>::ops(sc.host, ms) : 0.0;
+		double p = ms > 0 ? bench_t<PAGE>::ops(sc.page, ms) : 0.0;
+
+		static bench_t<HOST>::MONO hm(kfont_);
+		static bench_t<PAGE>::MONO pm(kfont_);
+		hm.at_plot().clear();
+		pm.at_plot().clear();
+		bench_t<HOST>::render(sc.host, hm);
+		bench_t<PAGE>::render(sc.page, pm);
+		HOST img;
+		img.set_pages(pm.at_plot().fb());
+
+		std::string res = "ok";
+		if(hm.at_plot().compare(img) != 0) {
+			res = "host/page differ: " + std::to_string(hm.at_plot().compare(img));
+			++err;
+		}
+		std::string base = std::string("/") + sc.name;
+		if(!check.empty()) {
+			HOST gold;
+			if(!gold.load_pbm(check + base + ".pbm")) {
+				res += ", no golden";
+				++err;
+			} else if(gold.compare(hm.at_plot()) != 0) {
+				res += ", golden differ: " + std::to_string(gold.compare(hm.at_plot()));
+				++err;
+			}
+		}
+		if(!save.empty() && !hm.at_plot().save_pbm(save + base + ".pbm")) {
+			res += ", save error";
+			++err;
+		}
+		if(!png.empty() && !hm.at_plot().save_png(png + base + ".png")) {
+			res += ", png error";
+			++err;
+		}
+
+		std::cout << std::left << std::setw(8) << sc.name << std::right << std::fixed
+			<< std::setprecision(0) << std::setw(16) << h << std::setw(16) << p
+			<< "  " << res << std::endl;
+	}
+
+	{
+		double p = ms > 0 ? bench_t<PAGE>::ops(glyph_<bench_t<PAGE>::MONO>, ms) : 0.0;
+		double s = ms > 0 ? STRIKE::ops(glyph_<STRIKE::MONO>, ms) : 0.0;
+
+		static bench_t<PAGE>::MONO pm(kfont_);
+		static STRIKE::MONO sm(kfont_);
+		pm.at_plot().clear();
+		sm.at_plot().clear();
+		bench_t<PAGE>::render(glyph_<bench_t<PAGE>::MONO>, pm);
+		STRIKE::render(glyph_<STRIKE::MONO>, sm);
+		HOST a;
+		HOST b;
+		a.set_pages(pm.at_plot().fb());
+		b.set_pages(sm.at_plot().fb());
+		std::string res = "ok";
+		if(a.compare(b) != 0) {
+			res = "pixel/strike differ: " + std::to_string(a.compare(b));
+			++err;
+		}
+		if(!check.empty()) {
+			HOST gold;
+			if(!gold.load_pbm(check + "/glyph.pbm")) {
+				res += ", no golden";
+				++err;
+			} else if(gold.compare(a) != 0) {
+				res += ", golden differ: " + std::to_string(gold.compare(a));
+				++err;
+			}
+		}
+		if(!save.empty() && !a.save_pbm(save + "/glyph.pbm")) {
+			res += ", save error";
+			++err;
+		}
+		std::cout << std::endl;
+		std::cout << "glyph      per-pixel(ops/s)  page strike(ops/s)  result" << std::endl;
+		std::cout << std::left << std::setw(8) << "font6x12" << std::right << std::fixed
+			<< std::setprecision(0) << std::setw(18) << p << std::setw(20) << s
+			<< "  " << res << std::endl;
+	}
+
+	{
+		std::cout << std::endl;
+		std::cout << "pack          raw(ops/s)     pack(ops/s)    bytes      result" << std::endl;
+		for(const auto& sc : pack_scene_) {
+			double r = ms > 0 ? bench_t<PAGE>::ops(sc.page_raw, ms) : 0.0;
+			double p = ms > 0 ? bench_t<PAGE>::ops(sc.page_pack, ms) : 0.0;
+
+			static bench_t<HOST>::MONO hraw(kfont_);
+			static bench_t<HOST>::MONO hpack(kfont_);
+			static bench_t<PAGE>::MONO praw(kfont_);
+			static bench_t<PAGE>::MONO ppack(kfont_);
+			hraw.at_plot().clear();
+			hpack.at_plot().clear();
+			praw.at_plot().clear();
+			ppack.at_plot().clear();
+			bench_t<HOST>::render(sc.host_raw, hraw);
+			bench_t<HOST>::render(sc.host_pack, hpack);
+			bench_t<PAGE>::render(sc.page_raw, praw);
+			bench_t<PAGE>::render(sc.page_pack, ppack);
+			HOST a;
+			HOST b;
+			a.set_pages(praw.at_plot().fb());
+			b.set_pages(ppack.at_plot().fb());
+
+			std::string res = "ok";
+			uint32_t d = hraw.at_plot().compare(hpack.at_plot()) + a.compare(b) + hraw.at_plot().compare(a);
+			if(d != 0) {
+				res = "raw/pack differ: " + std::to_string(d);
+				++err;
+			}
+			std::string base = std::string("/pack_") + sc.name;
+			if(!check.empty()) {
+				HOST gold;
+				if(!gold.load_pbm(check + base + ".pbm")) {
+					res += ", no golden";
+					++err;
+				} else if(gold.compare(hpack.at_plot()) != 0) {
+					res += ", golden differ: " + std::to_string(gold.compare(hpack.at_plot()));
+					++err;
+				}
+			}
+			if(!save.empty() && !hpack.at_plot().save_pbm(save + base + ".pbm")) {
+				res += ", save error";
+				++err;
+			}
+
+			uint32_t raw;
+			uint32_t pack;
+			sc.size(raw, pack);
+			std::cout << std::left << std::setw(8) << sc.name << std::right << std::fixed
+				<< std::setprecision(0) << std::setw(16) << r << std::setw(16) << p
+				<< std::setw(7) << raw << " ->" << std::setw(4) << pack
+				<< "  " << res << std::endl;
+		}
+
+		// 展開の往復
+		rand_t r;
+		uint32_t e = 0;
+		for(const auto& o : font32_) e += check_mobj_(o, r);
+		e += check_mobj_(screen_, r);
+		std::cout << "mobj_pack output vs raw: " << (e == 0 ? "ok" : "NG " + std::to_string(e)) << std::endl;
+		err += e;
+		e = check_round_trip_(r);
+		std::cout << "packbits round trip:     " << (e == 0 ? "ok" : "NG " + std::to_string(e)) << std::endl;
+		err += e;
+	}
+	return err != 0 ? 1 : 0;
+}
@@ -2,6 +2,9 @@
 //=====================================================================//
 /*!	@file
 	@brief	MMC（SD カード）pFatFS ドライバー @n
+			set_multi(true) で、連続したセクターの読み書きを、CMD18、CMD25 の @n
+			マルチ・ブロック転送で行う（転送中はカードを選択したままになる）。@n
+			同じ SPI バスを他のデバイスで使う前や、カードを外す前には stop() を呼ぶ。@n
 			Copyright 2016 Kunihito Hiramatsu
 	@author	平松邦仁 (hira@rvf-rc45.net)
 */
@@ -32,9 +35,12 @@ namespace pfatfs {
 			CMD1    = 0x40 + 1,		/* SEND_OP_COND (MMC) */
 			ACMD41  = 0xC0 + 41,	/* SEND_OP_COND (SDC) */
 			CMD8    = 0x40 + 8,		/* SEND_IF_COND */
+			CMD12   = 0x40 + 12,	/* STOP_TRANSMISSION */
 			CMD16   = 0x40 + 16,	/* SET_BLOCKLEN */
 			CMD17   = 0x40 + 17,	/* READ_SINGLE_BLOCK */
+			CMD18   = 0x40 + 18,	/* READ_MULTIPLE_BLOCK */
 			CMD24   = 0x40 + 24,	/* WRITE_BLOCK */
+			CMD25   = 0x40 + 25,	/* WRITE_MULTIPLE_BLOCK */
 			CMD55   = 0x40 + 55,	/* APP_CMD */
 			CMD58   = 0x40 + 58,	/* READ_OCR */
 		};
@@ -47,6 +53,18 @@ namespace pfatfs {
 
 		BYTE CardType;			/* b0:MMC, b1:SDv1, b2:SDv2, b3:Block addressing */
 
+		// マルチ・ブロック転送の状態
+		enum class stream : uint8_t {
+			NONE,	///< 転送無し
+			READ,	///< CMD18 で読み出し中
+			WRITE,	///< CMD25 で書き込み中
+		};
+
+		bool	multi_;
+		stream	stream_;
+		DWORD	sector_;	///< 読み出し中のセクター（書き込みでは、次のセクター）
+		UINT	pos_;		///< 読み出し中のセクター内の位置
+
 		void forward_(BYTE d) { }
 
 		void skip_(uint16_t num)
@@ -67,6 +85,83 @@ namespace pfatfs {
 		}
 
 
+		//---------------------------------------------------------------//
+		//  Wait for a data token in timeout of 100ms
+		//---------------------------------------------------------------//
+		BYTE wait_token_()
+		{
+			UINT tmr = 1000;
+			BYTE d;
+			while((d = spi_.xchg()) == 0xFF && --tmr) {
+				utils::delay::micro_second(100);
+			}
+			return d;
+		}
+
+
+		//---------------------------------------------------------------//
+		//  Wait for the card ready in timeout of 1000ms
+		//---------------------------------------------------------------//
+		bool wait_ready_()
+		{
+			uint16_t tmr;
+			for(tmr = 10000; spi_.xchg() != 0xFF && tmr; tmr--) {
+				utils::delay::micro_second(100);
+			}
+			return tmr != 0;
+		}
+
+
+		//---------------------------------------------------------------//
+		//  Read a part of the sector in the multiple block read
+		//---------------------------------------------------------------//
+		DRESULT read_multi_(BYTE* buff, DWORD sector, UINT offset, UINT count)
+		{
+			if(stream_ == stream::READ) {
+				if(sector == (sector_ + 1)) {  // 次のセクターなら、そのまま続ける
+					skip_(512 - pos_ + 2);  // Skip trailing bytes and CRC
+					if(wait_token_() != 0xFE) {
+						stop();
+						return RES_ERROR;
+					}
+					++sector_;
+					pos_ = 0;
+				} else if(sector != sector_ || offset < pos_) {
+					stop();
+				}
+			}
+
+			if(stream_ != stream::READ) {
+				DWORD adr = sector;
+				if(!(CardType & CT_BLOCK)) adr *= 512;  // Convert to byte address if needed
+				if(send_cmd_(command::CMD18, adr) != 0) {  // READ_MULTIPLE_BLOCK
+					release_spi_();
+					return RES_ERROR;
+				}
+				stream_ = stream::READ;
+				if(wait_token_() != 0xFE) {
+					stop();
+					return RES_ERROR;
+				}
+				sector_ = sector;
+				pos_ = 0;
+			}
+
+			skip_(offset - pos_);
+			if(buff) {
+				spi_.recv(buff, count);
+			} else {
+				UINT n = count;
+				do {
+					auto d = spi_.xchg();
+					forward_(d);
+				} while(--n) ;
+			}
+			pos_ = offset + count;
+			return RES_OK;
+		}
+
+
 		//---------------------------------------------------------------//
 		//  Send a command packet to MMC
 		//---------------------------------------------------------------//
@@ -79,12 +174,14 @@ namespace pfatfs {
 				if(res > 1) return res;
 			}
 
-			// Select the card
-			SEL::P = 1;
-			spi_.xchg();
+			// Select the card (CMD12 is sent in the multiple block read)
+			if(cm != command::CMD12) {
+				SEL::P = 1;
+				spi_.xchg();
 
-			SEL::P = 0;
-			spi_.xchg();
+				SEL::P = 0;
+				spi_.xchg();
+			}
 
 			// Send a command packet
 			uint8_t tmp[5];
@@ -99,6 +196,8 @@ namespace pfatfs {
 			if(cm == command::CMD8) n = 0x87;  // Valid CRC for CMD8(0x1AA)
 			spi_.xchg(n);
 
+			if(cm == command::CMD12) spi_.xchg();  // Discard following one byte when CMD12
+
 			// Receive a command response
 			BYTE res;
 			{
@@ -117,7 +216,45 @@ namespace pfatfs {
 			@brief  コンストラクター
 		*/
 		//-----------------------------------------------------------------//
-		mmc_io(SPI& spi) : spi_(spi) { }
+		mmc_io(SPI& spi) : spi_(spi), CardType(0), multi_(false), stream_(stream::NONE),
+			sector_(0), pos_(0) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  マルチ・ブロック転送を許可
+			@param[in]	ena	不許可なら「false」
+		*/
+		//-----------------------------------------------------------------//
+		void set_multi(bool ena = true)
+		{
+			stop();
+			multi_ = ena;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  マルチ・ブロック転送を終了して、カードの選択を解除 @n
+					（読み出しは CMD12、書き込みは Stop Tran トークン）
+			@return ビジーがタイムアウトした場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool stop()
+		{
+			if(stream_ == stream::NONE) return true;
+
+			if(stream_ == stream::READ) {
+				send_cmd_(command::CMD12, 0);
+			} else {
+				spi_.xchg(0xFD);  // Stop Tran token
+				spi_.xchg();
+			}
+			stream_ = stream::NONE;
+			bool ok = wait_ready_();
+			release_spi_();
+			return ok;
+		}
 
 
 		//-----------------------------------------------------------------//
@@ -128,6 +265,8 @@ namespace pfatfs {
 		//-----------------------------------------------------------------//
 		DSTATUS disk_initialize()
 		{
+			stream_ = stream::NONE;
+
 			spi_.start(10);  // setup slow clock
 
 			SEL::DIR = 1;
@@ -193,18 +332,14 @@ namespace pfatfs {
 		//-----------------------------------------------------------------//
 		DRESULT disk_readp(BYTE* buff, DWORD sector, UINT offset, UINT count)
 		{
+			if(stream_ == stream::WRITE) stop();
+			if(multi_) return read_multi_(buff, sector, offset, count);
+
 			if(!(CardType & CT_BLOCK)) sector *= 512;  // Convert to byte address if needed
 
 			DRESULT res = RES_ERROR;
 			if(send_cmd_(command::CMD17, sector) == 0) {  // READ_SINGLE_BLOCK
-				UINT tmr = 1000;
-				BYTE d;
-				do {  // wait for data packet in timeout of 100ms
-					utils::delay::micro_second(100);
-					d = spi_.xchg();
-				} while (d == 0xFF && --tmr) ;
-
-				if(d == 0xFE) {  // A data packet arrived
+				if(wait_token_() == 0xFE) {  // A data packet arrived
 					UINT bc = 514 - offset - count;
 
 					// Skip leading bytes
@@ -257,12 +392,27 @@ namespace pfatfs {
 				res = RES_OK;
 			} else {
 				if(sc) {	// Initiate sector write transaction
-					if(!(CardType & CT_BLOCK)) sc *= 512;	// Convert to byte address if needed
-					if(send_cmd_(command::CMD24, sc) == 0) {  // WRITE_SINGLE_BLOCK
+					if(stream_ == stream::READ) stop();
+					if(stream_ == stream::WRITE && sc != sector_) stop();
+					DWORD adr = sc;
+					if(!(CardType & CT_BLOCK)) adr *= 512;	// Convert to byte address if needed
+					if(stream_ == stream::WRITE) {  // 次のセクターなら、そのまま続ける
+						res = RES_OK;
+					} else if(multi_) {
+						if(send_cmd_(command::CMD25, adr) == 0) {  // WRITE_MULTIPLE_BLOCK
+							stream_ = stream::WRITE;
+							res = RES_OK;
+						}
+					} else if(send_cmd_(command::CMD24, adr) == 0) {  // WRITE_SINGLE_BLOCK
+						res = RES_OK;
+					}
+					if(res == RES_OK) {
 						spi_.xchg(0xFF);
-						spi_.xchg(0xFE);  // Data block header
+						spi_.xchg(stream_ == stream::WRITE ? 0xFC : 0xFE);  // Data block header
 						wc = 512;		  // Set byte counter
-						res = RES_OK;
+						sector_ = sc + 1;
+					} else {
+						release_spi_();
 					}
 				} else {	// Finalize sector write transaction
 					bc = wc + 2;
@@ -272,13 +422,13 @@ namespace pfatfs {
 					// Receive data resp and wait for end of write process in timeout of 300ms
 					if((spi_.xchg() & 0x1F) == 0x05) {
 						// Wait for ready (max 1000ms)
-						uint16_t tmr;
-						for(tmr = 10000; spi_.xchg() != 0xFF && tmr; tmr--) {
-							utils::delay::micro_second(100);
-						}
-						if(tmr) res = RES_OK;
+						if(wait_ready_()) res = RES_OK;
+					}
+					if(stream_ == stream::WRITE) {
+						if(res != RES_OK) stop();
+					} else {
+						release_spi_();
 					}
-					release_spi_();
 				}
 			}
 			return res;
@@ -409,6 +409,29 @@ DWORD clust2sect (	/* !=0: Sector number, 0: Failed - invalid cluster# */
 }
 
 
+#if _USE_FASTSEEK
+static
+CLUST clmt_clust (	/* Cluster# of the file offset */
+	DWORD ofs		/* File offset (must be less than the file size) */
+)
+{
+	DWORD cl, *tbl;
+	UINT lo, hi, mid;
+	FATFS *fs = FatFs;
+
+
+	tbl = fs->cltbl + 1;					/* Top of the fragment table {file cluster offset, start cluster} */
+	cl = ofs / 512 / fs->csize;				/* Cluster offset from top of the file */
+	lo = 0; hi = (UINT)((fs->cltbl[0] - 1) / 2);	/* Number of fragments */
+	while (hi - lo > 1) {					/* Binary search the fragment */
+		mid = (lo + hi) / 2;
+		if (tbl[mid * 2] <= cl) lo = mid; else hi = mid;
+	}
+	return (CLUST)(tbl[lo * 2 + 1] + (cl - tbl[lo * 2]));
+}
+#endif
+
+
 static
 CLUST get_clust (
 	BYTE* dir		/* Pointer to directory entry */
@@ -839,6 +862,9 @@ FRESULT pf_open (
 	if (!fs) return FR_NOT_ENABLED;		/* Check file system */
 
 	fs->flag = 0;
+#if _USE_FASTSEEK
+	fs->cltbl = 0;						/* Cluster link map is not valid */
+#endif
 	dj.fn = sp;
 	res = follow_path(&dj, dir, path);	/* Follow the file path */
 	if (res != FR_OK) return res;		/* Follow failed */
@@ -890,6 +916,11 @@ FRESULT pf_read (
 				if (fs->fptr == 0)					/* On the top of the file? */
 					clst = fs->org_clust;
 				else
+#if _USE_FASTSEEK
+				if (fs->cltbl)						/* Get next cluster from the link map */
+					clst = clmt_clust(fs->fptr);
+				else
+#endif
 					clst = get_fat(fs->curr_clust);
 				if (clst <= 1) ABORT(FR_DISK_ERR);
 				fs->curr_clust = clst;				/* Update current cluster */
@@ -954,6 +985,11 @@ FRESULT pf_write (
 				if (fs->fptr == 0)					/* On the top of the file? */
 					clst = fs->org_clust;
 				else
+#if _USE_FASTSEEK
+				if (fs->cltbl)						/* Get next cluster from the link map */
+					clst = clmt_clust(fs->fptr);
+				else
+#endif
 					clst = get_fat(fs->curr_clust);
 				if (clst <= 1) ABORT(FR_DISK_ERR);
 				fs->curr_clust = clst;				/* Update current cluster */
@@ -1000,6 +1036,19 @@ FRESULT pf_lseek (
 			return FR_NOT_OPENED;
 
 	if (ofs > fs->fsize) ofs = fs->fsize;	/* Clip offset with the file size */
+#if _USE_FASTSEEK
+	if (fs->cltbl) {					/* Fast seek with the cluster link map */
+		fs->fptr = ofs;
+		if (ofs > 0) {
+			clst = clmt_clust(ofs - 1);
+			sect = clust2sect(clst);
+			if (!sect) ABORT(FR_DISK_ERR);
+			fs->curr_clust = clst;
+			fs->dsect = sect + (fs->fptr / 512 & (fs->csize - 1));
+		}
+		return FR_OK;
+	}
+#endif
 	ifptr = fs->fptr;
 	fs->fptr = 0;
 	if (ofs > 0) {
@@ -1032,6 +1081,54 @@ FRESULT pf_lseek (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Create Cluster Link Map of the Open File                              */
+/*-----------------------------------------------------------------------*/
+#if _USE_FASTSEEK
+
+FRESULT pf_linkmap (
+	DWORD* tbl		/* Pointer to the link map table (tbl[0]:Number of items in the table) */
+)
+{
+	CLUST clst, pclst;
+	DWORD bcs, ncl, fcl, ulen, tlen;
+	FATFS *fs = FatFs;
+
+
+	if (!fs) return FR_NOT_ENABLED;		/* Check file system */
+	if (!(fs->flag & FA_OPENED))		/* Check if opened */
+			return FR_NOT_OPENED;
+
+	fs->cltbl = 0;
+	tlen = tbl[0];						/* Given table size */
+	ulen = 1;							/* Required table size */
+	bcs = (DWORD)fs->csize * 512;		/* Cluster size (byte) */
+	ncl = fs->fsize ? (fs->fsize - 1) / bcs + 1 : 0;	/* Number of clusters of the file */
+	clst = fs->org_clust;
+	pclst = 0;
+	for (fcl = 0; fcl < ncl; fcl++) {
+		if (fcl) clst = get_fat(pclst);	/* Follow cluster chain */
+		if (clst <= 1 || clst >= fs->n_fatent) ABORT(FR_DISK_ERR);
+		if (clst != pclst + 1) {		/* Top of a fragment? */
+			if (ulen + 2 <= tlen) {
+				tbl[ulen] = fcl;		/* File cluster offset */
+				tbl[ulen + 1] = clst;	/* Start cluster */
+			}
+			ulen += 2;
+		}
+		pclst = clst;
+	}
+	tbl[0] = ulen;						/* Number of items used (or required) */
+	if (ulen > tlen) return FR_NOT_ENOUGH_CORE;	/* Given table size is smaller than required */
+
+	fs->cltbl = tbl;					/* Enable fast seek */
+
+	return FR_OK;
+}
+#endif
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Create a Directroy Object                                             */
 /*-----------------------------------------------------------------------*/
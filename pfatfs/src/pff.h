@@ -52,6 +52,9 @@ typedef struct {
 	CLUST	org_clust;	/* File start cluster */
 	CLUST	curr_clust;	/* File current cluster */
 	DWORD	dsect;		/* File current data sector */
+#if _USE_FASTSEEK
+	DWORD*	cltbl;		/* Pointer to the cluster link map table (null:not used) */
+#endif
 } FATFS;
 
 
@@ -89,7 +92,8 @@ typedef enum {
 	FR_NO_FILE,			/* 3 */
 	FR_NOT_OPENED,		/* 4 */
 	FR_NOT_ENABLED,		/* 5 */
-	FR_NO_FILESYSTEM	/* 6 */
+	FR_NO_FILESYSTEM,	/* 6 */
+	FR_NOT_ENOUGH_CORE	/* 7 */
 } FRESULT;
 
 
@@ -102,6 +106,7 @@ FRESULT pf_open (const char* path);							/* Open a file */
 FRESULT pf_read (void* buff, UINT btr, UINT* br);			/* Read data from the open file */
 FRESULT pf_write (const void* buff, UINT btw, UINT* bw);	/* Write data to the open file */
 FRESULT pf_lseek (DWORD ofs);								/* Move file pointer of the open file */
+FRESULT pf_linkmap (DWORD* tbl);							/* Create the cluster link map of the open file */
 FRESULT pf_opendir (DIR* dj, const char* path);				/* Open a directory */
 FRESULT pf_readdir (DIR* dj, FILINFO* fno);					/* Read a directory item from the open directory */
 
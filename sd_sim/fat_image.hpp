@@ -0,0 +1,157 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	FAT16 ディスク・イメージの作成（ホスト用） @n
+			ルート・ディレクトリにファイルを置いた、小さな FAT16 イメージを @n
+			メモリー上に作る。ファイルのクラスターは呼び出し側が指定するので、@n
+			断片化したファイルも作れる。（mkfs.vfat、mcopy が無くても試験出来る）@n
+			パーティション・テーブルは無し（SFD 形式）、１クラスター１セクター。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace sim {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	FAT16 ディスク・イメージ・クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class fat_image {
+	public:
+		static const uint32_t SECTORS = 16384;	///< 全セクター数（8 MB）
+		static const uint16_t FAT_SIZE = 64;	///< FAT のセクター数
+		static const uint16_t ROOT_ENTS = 512;	///< ルート・ディレクトリのエントリー数
+
+	private:
+		static const uint32_t fat_ = 1;
+		static const uint32_t root_ = fat_ + FAT_SIZE * 2;
+		static const uint32_t data_ = root_ + ROOT_ENTS / 16;
+
+		std::vector<uint8_t>&	img_;
+		uint16_t				files_;
+
+		static void put16_(uint8_t* p, uint16_t v) {
+			p[0] = v & 0xff;
+			p[1] = v >> 8;
+		}
+
+		static void put32_(uint8_t* p, uint32_t v) {
+			put16_(p, v & 0xffff);
+			put16_(p + 2, v >> 16);
+		}
+
+		void set_fat_(uint16_t clust, uint16_t v) {
+			for(uint32_t n = 0; n < 2; ++n) {
+				put16_(&img_[(fat_ + FAT_SIZE * n) * 512 + clust * 2], v);
+			}
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター（フォーマットする）
+			@param[in]	img	ディスク・イメージ
+		*/
+		//-----------------------------------------------------------------//
+		fat_image(std::vector<uint8_t>& img) : img_(img), files_(0)
+		{
+			img_.assign(SECTORS * 512, 0);
+			uint8_t* p = &img_[0];
+			p[0] = 0xEB;
+			p[1] = 0x3C;
+			p[2] = 0x90;
+			std::memcpy(&p[3], "R8C SIM ", 8);
+			put16_(&p[11], 512);		// BPB_BytsPerSec
+			p[13] = 1;					// BPB_SecPerClus
+			put16_(&p[14], fat_);		// BPB_RsvdSecCnt
+			p[16] = 2;					// BPB_NumFATs
+			put16_(&p[17], ROOT_ENTS);	// BPB_RootEntCnt
+			put16_(&p[19], SECTORS);	// BPB_TotSec16
+			p[21] = 0xF8;				// BPB_Media
+			put16_(&p[22], FAT_SIZE);	// BPB_FATSz16
+			p[38] = 0x29;				// BS_BootSig
+			std::memcpy(&p[43], "NO NAME    ", 11);
+			std::memcpy(&p[54], "FAT16   ", 8);
+			p[510] = 0x55;
+			p[511] = 0xAA;
+			set_fat_(0, 0xFFF8);
+			set_fat_(1, 0xFFFF);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	クラスター数を取得
+			@return クラスター数
+		*/
+		//-----------------------------------------------------------------//
+		static uint32_t get_clusters() { return SECTORS - data_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ファイルを追加
+			@param[in]	name	8.3 形式の名前（空白で埋めた１１文字、"FONT    FNT"）
+			@param[in]	src		内容
+			@param[in]	clust	使うクラスター（２以上、内容を収める数）
+			@return 成功なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool add(const char* name, const std::vector<uint8_t>& src, const std::vector<uint16_t>& clust)
+		{
+			if(files_ >= ROOT_ENTS) return false;
+			if((clust.size() * 512) < src.size()) return false;
+			for(uint32_t i = 0; i < clust.size(); ++i) {
+				uint16_t c = clust[i];
+				if(c < 2 || c >= (get_clusters() + 2)) return false;
+				uint32_t ofs = i * 512;
+				uint32_t n = ofs < src.size() ? src.size() - ofs : 0;
+				if(n > 512) n = 512;
+				if(n > 0) std::memcpy(&img_[(data_ + c - 2) * 512], &src[ofs], n);
+				set_fat_(c, (i + 1) < clust.size() ? clust[i + 1] : 0xFFFF);
+			}
+			uint8_t* d = &img_[root_ * 512 + files_ * 32];
+			std::memcpy(d, name, 11);
+			d[11] = 0x20;	// ARCHIVE
+			put16_(&d[20], 0);
+			put16_(&d[26], clust.empty() ? 0 : clust[0]);
+			put32_(&d[28], src.size());
+			++files_;
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	クラスターの並びを作る
+			@param[in]	top		先頭クラスター
+			@param[in]	num		クラスター数
+			@param[in]	step	間隔（１なら連続）
+			@return クラスターの並び
+		*/
+		//-----------------------------------------------------------------//
+		static std::vector<uint16_t> clusters(uint16_t top, uint32_t num, uint16_t step = 1)
+		{
+			std::vector<uint16_t> out;
+			for(uint32_t i = 0; i < num; ++i) out.push_back(top + i * step);
+			return out;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	内容に必要なクラスター数
+			@param[in]	size	バイト数
+			@return クラスター数
+		*/
+		//-----------------------------------------------------------------//
+		static uint32_t count(uint32_t size) { return (size + 511) / 512; }
+	};
+}
@@ -0,0 +1,537 @@
+//=====================================================================//
+/*!	@file
+	@brief	SD カード・シミュレーターで、mmc_io と Petit FatFs を評価する @n
+			ディスク・イメージ上のファイルを読み書きして、SPI クロック数、@n
+			コマンド数、プロトコル違反の有無を表示する。@n
+			シングル・ブロック（CMD17、CMD24）とマルチ・ブロック（CMD18、CMD25）@n
+			の両方で行い、読んだ内容が一致するかを検査する。@n
+			-seek では、ランダム・シークの時間を、FAT を辿る場合と、@n
+			クラスター・リンク・マップ（pf_linkmap）を使う場合で比較する。@n
+			-kfont では、生成した BDF フォントを kfont_pack.hpp で変換して、@n
+			メモリー上の FAT16 イメージに置き、kfont_sd で読んだグリフを元の @n
+			ビットマップと比較する。（シングル、マルチ・ブロックの両方、@n
+			LRU キャッシュのヒット、ミス、断片化したファイルの拒否） @n
+			ディスク・イメージは、Linux では mkfs.vfat、mcopy で作成出来る。@n
+			  dd if=/dev/zero of=sd.img bs=1M count=32 @n
+			  mkfs.vfat sd.img @n
+			  mcopy -i sd.img TEST.WAV :: @n
+			使い方： sd_sim [-card sdv1|sdv2|sdhc] [-latency read,busy] @n
+			         [-chunk bytes] [-write] [-seek count] image file @n
+			         sd_sim [-card sdv1|sdv2|sdhc] [-latency read,busy] -kfont
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include "pfatfs/mmc_io.hpp"
+#include "common/kfont_sd.hpp"
+#include "kfont_pack/kfont_pack.hpp"
+#include "sd_spi.hpp"
+#include "fat_image.hpp"
+
+namespace {
+
+	typedef sim::sd_spi SPI;
+	SPI		spi_;
+
+	typedef pfatfs::mmc_io<SPI, sim::sd_sel<> > MMC;
+	MMC		mmc_io_(spi_);
+
+	FATFS	fatfs_;
+
+	// クラスター・リンク・マップ（断片数 n で、1 + n * 2 個必要）
+	DWORD	linkmap_[512];
+
+	struct result_t {
+		uint64_t	clock;
+		uint32_t	bytes;
+		uint32_t	sum;
+		bool		ok;
+	};
+
+
+	void report_(const char* title, const result_t& t)
+	{
+		std::cout << std::left << std::setw(14) << title << std::right;
+		if(!t.ok) {
+			std::cout << "error" << std::endl;
+			return;
+		}
+		double bpc = t.clock > 0 ? static_cast<double>(t.bytes) / static_cast<double>(t.clock) : 0.0;
+		std::cout << std::setw(10) << t.bytes << " bytes" << std::setw(12) << t.clock << " clocks"
+			<< std::fixed << std::setprecision(4) << std::setw(10) << bpc << " bytes/clock"
+			<< "  CMD17:" << spi_.get_cmd_count(17) << " CMD18:" << spi_.get_cmd_count(18)
+			<< " CMD12:" << spi_.get_cmd_count(12) << " CMD24:" << spi_.get_cmd_count(24)
+			<< " CMD25:" << spi_.get_cmd_count(25)
+			<< " error:" << spi_.get_error() << std::endl;
+	}
+
+
+	// ファイルを先頭から順に読む
+	result_t read_file_(const char* file, uint16_t chunk)
+	{
+		result_t t;
+		t.clock = 0;
+		t.bytes = 0;
+		t.sum = 0;
+		t.ok = false;
+		if(pf_open(file) != FR_OK) return t;
+		spi_.reset_count();
+		std::vector<uint8_t> buf(chunk);
+		for(;;) {
+			UINT br;
+			if(pf_read(buf.data(), chunk, &br) != FR_OK) return t;
+			for(UINT i = 0; i < br; ++i) t.sum = t.sum * 31 + buf[i];
+			t.bytes += br;
+			if(br < chunk) break;
+		}
+		mmc_io_.stop();
+		t.clock = spi_.get_clock();
+		t.ok = true;
+		return t;
+	}
+
+
+	// ファイル全体に書き込む（サイズは変わらない）
+	result_t write_file_(const char* file, uint16_t chunk, uint8_t seed)
+	{
+		result_t t;
+		t.clock = 0;
+		t.bytes = 0;
+		t.sum = 0;
+		t.ok = false;
+		if(pf_open(file) != FR_OK) return t;
+		spi_.reset_count();
+		std::vector<uint8_t> buf(chunk);
+		uint8_t v = seed;
+		DWORD size = fatfs_.fsize & ~static_cast<DWORD>(511);  // 最後のセクターまで
+		while(t.bytes < size) {
+			UINT n = chunk;
+			if(n > (size - t.bytes)) n = size - t.bytes;
+			for(UINT i = 0; i < n; ++i) {
+				buf[i] = v;
+				v = v * 5 + 1;
+			}
+			UINT bw;
+			if(pf_write(buf.data(), n, &bw) != FR_OK || bw != n) return t;
+			t.bytes += n;
+		}
+		UINT bw;
+		if(pf_write(nullptr, 0, &bw) != FR_OK) return t;
+		mmc_io_.stop();
+		t.clock = spi_.get_clock();
+		t.ok = true;
+		return t;
+	}
+
+
+	// ランダムな位置へシークして、少し読む
+	result_t seek_file_(const char* file, uint32_t count, bool map)
+	{
+		result_t t;
+		t.clock = 0;
+		t.bytes = 0;
+		t.sum = 0;
+		t.ok = false;
+		if(pf_open(file) != FR_OK || fatfs_.fsize == 0) return t;
+		if(map) {
+			linkmap_[0] = sizeof(linkmap_) / sizeof(DWORD);
+			auto ret = pf_linkmap(linkmap_);
+			std::cout << "Link map: " << (linkmap_[0] - 1) / 2 << " fragments, "
+				<< linkmap_[0] * 4 << " bytes (R8C)" << std::endl;
+			if(ret != FR_OK) return t;
+		}
+		spi_.reset_count();
+		uint32_t v = 1;
+		for(uint32_t i = 0; i < count; ++i) {
+			v = v * 1103515245 + 12345;
+			DWORD ofs = (v >> 8) % fatfs_.fsize;
+			if(pf_lseek(ofs) != FR_OK) return t;
+			uint8_t buf[16];
+			UINT br;
+			if(pf_read(buf, sizeof(buf), &br) != FR_OK) return t;
+			for(UINT j = 0; j < br; ++j) t.sum = t.sum * 31 + buf[j];
+			t.bytes += br;
+		}
+		mmc_io_.stop();
+		t.clock = spi_.get_clock();
+		t.ok = true;
+		return t;
+	}
+
+
+	// 生成フォントの画素（BBX 内の座標）
+	bool pix_(uint16_t code, int x, int y)
+	{
+		uint32_t v = code * 2654435761u ^ static_cast<uint32_t>(x * 97 + y * 131) * 40503u;
+		v ^= v >> 13;
+		v *= 0x5bd1e995;
+		v ^= v >> 15;
+		return (v & 1) != 0;
+	}
+
+
+	// ひらがな U+3041 〜 U+3093 と、U+4E00 〜 U+4EFE の偶数（奇数は無いグリフ）
+	bool has_glyph_(uint16_t code)
+	{
+		if(code >= 0x3041 && code <= 0x3093) return true;
+		if(code >= 0x4e00 && code <= 0x4efe && (code & 1) == 0) return true;
+		return false;
+	}
+
+
+	struct bbx_t {
+		int		w;
+		int		h;
+		int		xo;
+		int		yo;
+	};
+
+	// コード毎に BBX を変える（セルは W x H、原点は（0, -2））
+	bbx_t bbx_(uint16_t code, int fw, int fh)
+	{
+		switch(code % 3) {
+		case 1:  return bbx_t { fw - 2, fh - 3, 1, -1 };
+		case 2:  return bbx_t { fw - 4, fh, 2, -2 };
+		default: return bbx_t { fw, fh, 0, -2 };
+		}
+	}
+
+
+	// BDF を作る（kfont_pack の入力）
+	std::string make_bdf_(int fw, int fh)
+	{
+		std::ostringstream oss;
+		oss << "STARTFONT 2.1\nFONT sd_sim\nSIZE " << fh << " 75 75\n";
+		oss << "FONTBOUNDINGBOX " << fw << ' ' << fh << " 0 -2\n";
+		oss << "STARTPROPERTIES 2\nCHARSET_REGISTRY \"ISO10646\"\nCHARSET_ENCODING \"1\"\nENDPROPERTIES\n";
+		for(uint32_t code = 0x3000; code < 0x5000; ++code) {
+			if(!has_glyph_(code)) continue;
+			auto b = bbx_(code, fw, fh);
+			oss << "STARTCHAR u" << std::hex << code << std::dec << "\nENCODING " << code << '\n';
+			oss << "BBX " << b.w << ' ' << b.h << ' ' << b.xo << ' ' << b.yo << "\nBITMAP\n";
+			int bytes = (b.w + 7) / 8;
+			for(int y = 0; y < b.h; ++y) {
+				for(int i = 0; i < bytes; ++i) {
+					int v = 0;
+					for(int j = 0; j < 8; ++j) {
+						int x = i * 8 + j;
+						if(x < b.w && pix_(code, x, y)) v |= 0x80 >> j;
+					}
+					oss << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << v
+						<< std::dec << std::nouppercase << std::setfill(' ');
+				}
+				oss << '\n';
+			}
+			oss << "ENDCHAR\n";
+		}
+		oss << "ENDFONT\n";
+		return oss.str();
+	}
+
+
+	// 元のビットマップ（セル内、行単位、LSB から）
+	std::vector<uint8_t> glyph_(uint16_t code, int fw, int fh)
+	{
+		std::vector<uint8_t> out((fw * fh + 7) / 8, 0);
+		auto b = bbx_(code, fw, fh);
+		int top = (fh - 2) - (b.yo + b.h);
+		int left = b.xo;
+		for(int y = 0; y < b.h; ++y) {
+			for(int x = 0; x < b.w; ++x) {
+				if(!pix_(code, x, y)) continue;
+				int pos = (top + y) * fw + (left + x);
+				out[pos >> 3] |= 1 << (pos & 7);
+			}
+		}
+		return out;
+	}
+
+
+	//-----------------------------------------------------------------//
+	/*!
+		@brief	kfont_sd の検査
+		@param[in]	W	横幅
+		@param[in]	H	高さ
+		@param[in]	N	キャッシュするグリフ数
+		@param[in]	ty	カードの種類
+		@return エラー数
+	*/
+	//-----------------------------------------------------------------//
+	template <int8_t W, int8_t H, uint8_t N>
+	uint32_t kfont_test_(SPI::card ty)
+	{
+		uint32_t err = 0;
+
+		// BDF を作り、kfont_pack と同じ変換を行う
+		tools::bdf_t bdf;
+		{
+			std::istringstream iss(make_bdf_(W, H));
+			if(!tools::load_bdf(iss, bdf) || bdf.glyphs.empty()) {
+				std::cout << "kfont " << int(W) << "x" << int(H) << ": BDF error" << std::endl;
+				return 1;
+			}
+		}
+		uint32_t pack_err = 0;
+		for(const auto& g : bdf.glyphs) {
+			if(g.second != glyph_(g.first, W, H)) ++pack_err;
+		}
+		auto font = tools::make_kfont(bdf);
+
+		// FONT.FNT（連続）、FRAG.FNT と PAD.BIN（互い違いのクラスター）
+		std::vector<uint8_t> pad(font.size());
+		for(uint32_t i = 0; i < pad.size(); ++i) pad[i] = (i * 7 + (i >> 9)) & 0xff;
+		uint32_t nc = sim::fat_image::count(font.size());
+		bool img_ok = true;
+		{
+			sim::fat_image img(spi_.at_image());
+			img_ok &= img.add("FONT    FNT", font, sim::fat_image::clusters(2, nc));
+			img_ok &= img.add("FRAG    FNT", font, sim::fat_image::clusters(2 + nc, nc, 2));
+			img_ok &= img.add("PAD     BIN", pad, sim::fat_image::clusters(3 + nc, nc, 2));
+		}
+		spi_.set_card(ty);
+		if(!img_ok || pf_mount(&fatfs_) != FR_OK) {
+			std::cout << "kfont " << int(W) << "x" << int(H) << ": image error" << std::endl;
+			return 1;
+		}
+
+		std::cout << "kfont " << int(W) << "x" << int(H) << " (cache " << int(N) << "): "
+			<< bdf.glyphs.size() << " glyphs, " << font.size() << " bytes, "
+			<< nc << " clusters, pack error: " << pack_err << std::endl;
+		err += pack_err;
+
+		graphics::kfont_sd<W, H, N> kfont;
+		bool frag = kfont.start(fatfs_, "FRAG.FNT");
+		bool none = kfont.start(fatfs_, "NONE.FNT");
+		bool cont = kfont.start(fatfs_, "FONT.FNT");
+		std::cout << "  start: FONT.FNT " << (cont ? "OK" : "NG")
+			<< ", FRAG.FNT " << (frag ? "NG (accepted)" : "OK (rejected)")
+			<< ", NONE.FNT " << (none ? "NG" : "OK") << std::endl;
+		if(!cont || frag || none) ++err;
+		if(!cont) return err;
+
+		// 文字列：近くのコードを繰り返し使い、時々、無いグリフと範囲外
+		std::vector<uint16_t> text;
+		uint32_t v = 1;
+		uint16_t base = 0x3041;
+		for(uint32_t i = 0; i < 2000; ++i) {
+			v = v * 1103515245 + 12345;
+			uint32_t r = (v >> 16) & 0xff;
+			if((i % 100) == 0) base = (r & 1) ? 0x3041 + (r % 70) : 0x4e00 + (r % 200);
+			uint16_t code;
+			if(r < 8) code = 0x3000;
+			else if(r < 12) code = 0x5000;
+			else code = base + ((v >> 8) % (N * 2));
+			text.push_back(code);
+		}
+
+		uint64_t clock[2] = { 0, 0 };
+		for(uint32_t m = 0; m < 2; ++m) {
+			mmc_io_.set_multi(m != 0);
+			kfont.flush();
+			spi_.reset_count();
+			uint16_t miss0 = kfont.get_miss();
+
+			std::vector<uint16_t> lru;	// 参照モデル（先頭が最も新しい）
+			uint32_t miss = 0;
+			uint32_t data_err = 0;
+			uint32_t lru_err = 0;
+			uint32_t pad_err = 0;
+			uint32_t found = 0;
+			uint32_t range = 0;
+			uint32_t i = 0;
+			for(auto code : text) {
+				if(code >= 0x3041 && code <= 0x4efe) {
+					++range;
+					auto it = std::find(lru.begin(), lru.end(), code);
+					if(it != lru.end()) {
+						lru.erase(it);
+					} else {
+						++miss;
+						if(lru.size() >= N) lru.pop_back();
+					}
+					lru.insert(lru.begin(), code);
+				}
+				const uint8_t* g = kfont.get(code);
+				if(has_glyph_(code)) {
+					if(g == nullptr || std::memcmp(g, glyph_(code, W, H).data(), kfont.BYTES) != 0) {
+						++data_err;
+					} else {
+						++found;
+					}
+				} else if(g != nullptr) {
+					++data_err;
+				}
+				if(static_cast<uint16_t>(kfont.get_miss() - miss0) != miss) ++lru_err;
+
+				// 他のファイルを読んでも、フォントは読める
+				if((i % 64) == 63) {
+					UINT br;
+					uint8_t tmp[40];
+					DWORD ofs = (i * 37) % (pad.size() - sizeof(tmp));
+					if(pf_open("PAD.BIN") != FR_OK || pf_lseek(ofs) != FR_OK
+						|| pf_read(tmp, sizeof(tmp), &br) != FR_OK || br != sizeof(tmp)
+						|| std::memcmp(tmp, &pad[ofs], sizeof(tmp)) != 0) ++pad_err;
+				}
+				++i;
+			}
+			mmc_io_.stop();
+			clock[m] = spi_.get_clock();
+			std::cout << (m == 0 ? "  CMD17 " : "  CMD18 ") << text.size() << " get, "
+				<< found << " glyphs, " << (range - miss) << " hit, " << miss << " miss"
+				<< std::setw(10) << clock[m] << " clocks  CMD17:" << spi_.get_cmd_count(17)
+				<< " CMD18:" << spi_.get_cmd_count(18) << " CMD12:" << spi_.get_cmd_count(12)
+				<< "  data error: " << data_err << ", LRU error: " << lru_err
+				<< ", PAD.BIN error: " << pad_err << ", SPI error: " << spi_.get_error() << std::endl;
+			err += data_err + lru_err + pad_err + spi_.get_error();
+		}
+		mmc_io_.set_multi(false);
+		return err;
+	}
+}
+
+
+extern "C" {
+
+	DSTATUS disk_initialize(void) {
+		return mmc_io_.disk_initialize();
+	}
+
+
+	DRESULT disk_readp(BYTE* buff, DWORD sector, UINT offset, UINT count) {
+		return mmc_io_.disk_readp(buff, sector, offset, count);
+	}
+
+
+	DRESULT disk_writep(const BYTE* buff, DWORD sc) {
+		return mmc_io_.disk_writep(buff, sc);
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	SPI::card ty = SPI::card::SDHC;
+	uint16_t chunk = 64;
+	bool write = false;
+	uint32_t seek = 0;
+	bool kfont = false;
+	std::vector<std::string> args;
+	for(int i = 1; i < argc; ++i) {
+		std::string s = argv[i];
+		if(s == "-card" && (i + 1) < argc) {
+			std::string c = argv[++i];
+			if(c == "sdv1") ty = SPI::card::SDV1;
+			else if(c == "sdv2") ty = SPI::card::SDV2;
+			else ty = SPI::card::SDHC;
+		} else if(s == "-latency" && (i + 1) < argc) {
+			std::string l = argv[++i];
+			auto n = l.find(',');
+			uint16_t r = std::atoi(l.substr(0, n).c_str());
+			uint16_t b = n != std::string::npos ? std::atoi(l.substr(n + 1).c_str()) : r;
+			spi_.set_latency(r, b);
+		} else if(s == "-chunk" && (i + 1) < argc) {
+			chunk = std::atoi(argv[++i]);
+			if(chunk == 0) chunk = 1;
+		} else if(s == "-write") {
+			write = true;
+		} else if(s == "-seek" && (i + 1) < argc) {
+			seek = std::atoi(argv[++i]);
+		} else if(s == "-kfont") {
+			kfont = true;
+		} else {
+			args.push_back(s);
+		}
+	}
+	if(kfont && args.empty()) {
+		uint32_t err = kfont_test_<12, 12, 8>(ty);
+		err += kfont_test_<16, 16, 4>(ty);
+		std::cout << (err == 0 ? "Pass" : "Fail") << std::endl;
+		return err != 0 ? 1 : 0;
+	}
+
+	if(args.size() != 2) {
+		std::cout << "SD card SPI simulator for mmc_io / Petit FatFs" << std::endl;
+		std::cout << "usage: " << argv[0]
+			<< " [-card sdv1|sdv2|sdhc] [-latency read,busy] [-chunk bytes] [-write] [-seek count]"
+			<< " image file"
+			<< std::endl;
+		std::cout << "       " << argv[0]
+			<< " [-card sdv1|sdv2|sdhc] [-latency read,busy] -kfont" << std::endl;
+		return 0;
+	}
+
+	spi_.set_card(ty);
+	if(!spi_.open(args[0])) {
+		std::cerr << "Can't open image: '" << args[0] << "'" << std::endl;
+		return 1;
+	}
+
+	spi_.reset_count();
+	if(pf_mount(&fatfs_) != FR_OK) {
+		std::cerr << "Mount error (error: " << spi_.get_error() << ")" << std::endl;
+		return 1;
+	}
+	std::cout << "Mount: " << spi_.get_clock() << " clocks" << std::endl;
+
+	const char* file = args[1].c_str();
+	int err = 0;
+
+	mmc_io_.set_multi(false);
+	auto s = read_file_(file, chunk);
+	report_("read CMD17", s);
+	mmc_io_.set_multi(true);
+	auto m = read_file_(file, chunk);
+	report_("read CMD18", m);
+	if(!s.ok || !m.ok || s.sum != m.sum || spi_.get_error() != 0) {
+		std::cout << "Read data mismatch" << std::endl;
+		++err;
+	} else if(s.clock > 0) {
+		std::cout << "Read speed up: " << std::fixed << std::setprecision(2)
+			<< static_cast<double>(s.clock) / static_cast<double>(m.clock) << std::endl;
+	}
+
+	if(write) {
+		mmc_io_.set_multi(false);
+		auto ws = write_file_(file, chunk, 1);
+		report_("write CMD24", ws);
+		auto rs = read_file_(file, chunk);
+		mmc_io_.set_multi(true);
+		auto wm = write_file_(file, chunk, 1);
+		report_("write CMD25", wm);
+		auto rm = read_file_(file, chunk);
+		if(!ws.ok || !wm.ok || rs.sum != rm.sum || spi_.get_error() != 0) {
+			std::cout << "Write data mismatch" << std::endl;
+			++err;
+		} else if(wm.clock > 0) {
+			std::cout << "Write speed up: " << std::fixed << std::setprecision(2)
+				<< static_cast<double>(ws.clock) / static_cast<double>(wm.clock) << std::endl;
+		}
+	}
+
+	if(seek > 0) {
+		mmc_io_.set_multi(false);
+		auto sf = seek_file_(file, seek, false);
+		report_("seek FAT", sf);
+		auto sm = seek_file_(file, seek, true);
+		report_("seek linkmap", sm);
+		if(!sf.ok || !sm.ok || sf.sum != sm.sum || spi_.get_error() != 0) {
+			std::cout << "Seek data mismatch" << std::endl;
+			++err;
+		} else if(sm.clock > 0) {
+			std::cout << "Seek: " << sf.clock / seek << " -> " << sm.clock / seek
+				<< " clocks/seek, speed up: " << std::fixed << std::setprecision(2)
+				<< static_cast<double>(sf.clock) / static_cast<double>(sm.clock) << std::endl;
+		}
+	}
+	return err != 0 ? 1 : 0;
+}
@@ -0,0 +1,564 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	SD カード SPI モード・シミュレーター（ホスト用） @n
+			device::spi_io と同じ start、xchg、send、recv を持ち、@n
+			pfatfs::mmc_io の SPI クラスとして使う。（SEL は sd_sel<>） @n
+			ディスク・イメージ・ファイルを、SDv1、SDv2、SDHC カードとして @n
+			R1、R3、R7 レスポンス、データ・トークン、ビジー、CRC を再現する。@n
+			SPI のクロック数、コマンド数を数えるので、ドライバーや @n
+			ファイル・システムの変更を、クロック当たりのバイト数で比較出来る。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <fstream>
+
+namespace sim {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	SD カード SPI モード・シミュレーター・クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class sd_spi {
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	カードの種類
+		*/
+		//-----------------------------------------------------------------//
+		enum class card : uint8_t {
+			SDV1,	///< SD ver 1（バイト・アドレス）
+			SDV2,	///< SD ver 2 標準容量（バイト・アドレス）
+			SDHC,	///< SD ver 2 大容量（ブロック・アドレス）
+		};
+
+	private:
+		enum class state : uint8_t {
+			IDLE,			///< コマンド待ち
+			READ_MULTI,		///< CMD18 のデータ送信中
+			WRITE_TOKEN,	///< CMD24、CMD25 のデータ・トークン待ち
+			WRITE_DATA,		///< データ受信中
+		};
+
+		std::vector<uint8_t>	image_;
+		card		card_;
+
+		bool		select_;
+		state		state_;
+		bool		idle_;		///< アイドル・ステート（初期化前）
+		bool		app_;		///< 次は ACMD
+		bool		multi_;		///< CMD25
+		uint8_t		acmd41_;
+
+		uint8_t		cmd_[6];
+		uint8_t		cmd_pos_;
+
+		std::deque<uint8_t>	out_;
+
+		uint32_t	sector_;
+		uint8_t		block_[514];
+		uint16_t	block_pos_;
+
+		uint16_t	read_latency_;
+		uint16_t	busy_;
+
+		uint64_t	clock_;
+		uint32_t	cmd_count_[64];
+		uint32_t	read_block_;
+		uint32_t	write_block_;
+		uint32_t	error_;
+
+		static uint8_t crc7_(const uint8_t* p, uint8_t len) {
+			uint8_t crc = 0;
+			for(uint8_t i = 0; i < len; ++i) {
+				uint8_t d = p[i];
+				for(uint8_t j = 0; j < 8; ++j) {
+					crc <<= 1;
+					if((d ^ crc) & 0x80) crc ^= 0x09;
+					d <<= 1;
+				}
+			}
+			return (crc << 1) | 1;
+		}
+
+		static uint16_t crc16_(const uint8_t* p, uint16_t len) {
+			uint16_t crc = 0;
+			for(uint16_t i = 0; i < len; ++i) {
+				crc ^= static_cast<uint16_t>(p[i]) << 8;
+				for(uint8_t j = 0; j < 8; ++j) {
+					crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+				}
+			}
+			return crc;
+		}
+
+		uint8_t r1_() const { return idle_ ? 0x01 : 0x00; }
+
+		void busy_out_() {
+			for(uint16_t i = 0; i < busy_; ++i) out_.push_back(0x00);
+		}
+
+		// 引数をセクターに変換（範囲外なら「false」）
+		bool sector_of_(uint32_t arg, uint32_t& sector) const {
+			if(card_ == card::SDHC) {
+				sector = arg;
+			} else {
+				if(arg & 511) return false;
+				sector = arg / 512;
+			}
+			return (static_cast<uint64_t>(sector) * 512) < image_.size();
+		}
+
+		// データ・ブロックを送信キューに積む
+		void block_out_(uint32_t sector) {
+			for(uint16_t i = 0; i < read_latency_; ++i) out_.push_back(0xFF);
+			if((static_cast<uint64_t>(sector) * 512) >= image_.size()) {
+				out_.push_back(0x08);  // Error token: out of range
+				state_ = state::IDLE;
+				return;
+			}
+			out_.push_back(0xFE);
+			const uint8_t* p = &image_[static_cast<size_t>(sector) * 512];
+			for(uint16_t i = 0; i < 512; ++i) out_.push_back(p[i]);
+			uint16_t crc = crc16_(p, 512);
+			out_.push_back(crc >> 8);
+			out_.push_back(crc & 0xff);
+			++read_block_;
+		}
+
+		void command_() {
+			uint8_t idx = cmd_[0] & 0x3f;
+			uint32_t arg = (static_cast<uint32_t>(cmd_[1]) << 24) | (static_cast<uint32_t>(cmd_[2]) << 16)
+				| (static_cast<uint32_t>(cmd_[3]) << 8) | cmd_[4];
+			++cmd_count_[idx];
+			bool app = app_;
+			app_ = false;
+
+			if(idx == 12) {  // STOP_TRANSMISSION
+				if(state_ != state::READ_MULTI) ++error_;
+				state_ = state::IDLE;
+				out_.clear();
+				out_.push_back(0xFF);  // Stuff byte
+				out_.push_back(r1_());
+				out_.push_back(0x00);  // 読み出しの停止は、ビジーが短い
+				return;
+			}
+
+			if(state_ != state::IDLE || !out_.empty()) {  // 転送中、ビジー中のコマンド
+				++error_;
+				out_.clear();
+				state_ = state::IDLE;
+			}
+
+			out_.push_back(0xFF);  // Ncr
+			if((idx == 0 || idx == 8) && crc7_(cmd_, 5) != cmd_[5]) {
+				out_.push_back(r1_() | 0x08);  // Com CRC error
+				return;
+			}
+
+			switch(idx) {
+			case 0:  // GO_IDLE_STATE
+				idle_ = true;
+				acmd41_ = 0;
+				out_.push_back(0x01);
+				break;
+			case 8:  // SEND_IF_COND
+				if(card_ == card::SDV1) {
+					out_.push_back(r1_() | 0x04);  // Illegal command
+				} else {
+					out_.push_back(r1_());
+					out_.push_back(0x00);
+					out_.push_back(0x00);
+					out_.push_back((arg >> 8) & 0x0f);
+					out_.push_back(arg & 0xff);
+				}
+				break;
+			case 41:  // SD_SEND_OP_COND
+				if(!app) {
+					out_.push_back(r1_() | 0x04);
+					break;
+				}
+				// 大容量カードは HCS が無ければ初期化されない
+				if(card_ != card::SDHC || (arg & (1UL << 30))) {
+					++acmd41_;
+					if(acmd41_ >= 3) idle_ = false;
+				}
+				out_.push_back(r1_());
+				break;
+			case 55:  // APP_CMD
+				app_ = true;
+				out_.push_back(r1_());
+				break;
+			case 58:  // READ_OCR
+				out_.push_back(r1_());
+				out_.push_back((idle_ ? 0x00 : 0x80) | (card_ == card::SDHC ? 0x40 : 0x00));
+				out_.push_back(0xff);
+				out_.push_back(0x80);
+				out_.push_back(0x00);
+				break;
+			case 16:  // SET_BLOCKLEN
+				out_.push_back(r1_() | (arg != 512 ? 0x40 : 0x00));
+				break;
+			case 17:  // READ_SINGLE_BLOCK
+			case 18:  // READ_MULTIPLE_BLOCK
+				if(idle_) {
+					out_.push_back(r1_() | 0x04);
+				} else if(!sector_of_(arg, sector_)) {
+					out_.push_back(0x20 | 0x40);  // Address error, parameter error
+				} else {
+					out_.push_back(0x00);
+					block_out_(sector_);
+					if(idx == 18) state_ = state::READ_MULTI;
+				}
+				break;
+			case 24:  // WRITE_BLOCK
+			case 25:  // WRITE_MULTIPLE_BLOCK
+				if(idle_) {
+					out_.push_back(r1_() | 0x04);
+				} else if(!sector_of_(arg, sector_)) {
+					out_.push_back(0x20 | 0x40);
+				} else {
+					out_.push_back(0x00);
+					multi_ = idx == 25;
+					state_ = state::WRITE_TOKEN;
+				}
+				break;
+			default:
+				out_.push_back(r1_() | 0x04);
+				break;
+			}
+		}
+
+		// ホストから受け取ったバイトの処理
+		void input_(uint8_t d) {
+			if(state_ == state::WRITE_TOKEN) {
+				if(!out_.empty()) return;  // レスポンス、ビジー中
+				if(d == 0xFF) return;
+				if(d == 0xFE || (multi_ && d == 0xFC)) {
+					state_ = state::WRITE_DATA;
+					block_pos_ = 0;
+				} else if(multi_ && d == 0xFD) {  // Stop Tran
+					state_ = state::IDLE;
+					out_.push_back(0xFF);
+					busy_out_();
+				} else {
+					++error_;
+					state_ = state::IDLE;
+				}
+				return;
+			}
+			if(state_ == state::WRITE_DATA) {
+				block_[block_pos_++] = d;
+				if(block_pos_ < 514) return;
+				if((static_cast<uint64_t>(sector_) * 512) < image_.size()) {
+					std::copy(block_, block_ + 512, &image_[static_cast<size_t>(sector_) * 512]);
+					++write_block_;
+					out_.push_back(0xE5);  // Data accepted
+				} else {
+					out_.push_back(0xED);  // Write error
+				}
+				busy_out_();
+				++sector_;
+				state_ = multi_ ? state::WRITE_TOKEN : state::IDLE;
+				return;
+			}
+
+			if(cmd_pos_ == 0 && (d & 0xc0) != 0x40) return;
+			cmd_[cmd_pos_++] = d;
+			if(cmd_pos_ < 6) return;
+			cmd_pos_ = 0;
+			command_();
+		}
+
+		static sd_spi*& current_() {
+			static sd_spi* p = nullptr;
+			return p;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+			@param[in]	ty	カードの種類
+		*/
+		//-----------------------------------------------------------------//
+		sd_spi(card ty = card::SDHC) : image_(), card_(ty), select_(false), state_(state::IDLE),
+			idle_(true), app_(false), multi_(false), acmd41_(0), cmd_pos_(0), out_(),
+			sector_(0), block_pos_(0), read_latency_(100), busy_(200)
+		{
+			reset_count();
+			current_() = this;
+		}
+
+
+		~sd_spi() { if(current_() == this) current_() = nullptr; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	sd_sel が操作するカード
+			@return カード
+		*/
+		//-----------------------------------------------------------------//
+		static sd_spi* get_current() { return current_(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	カードの種類を設定（初期化前の状態に戻る）
+			@param[in]	ty	カードの種類
+		*/
+		//-----------------------------------------------------------------//
+		void set_card(card ty)
+		{
+			card_ = ty;
+			state_ = state::IDLE;
+			idle_ = true;
+			app_ = false;
+			acmd41_ = 0;
+			cmd_pos_ = 0;
+			out_.clear();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ディスク・イメージを読み込む（サイズは 512 の倍数に切り上げ）
+			@param[in]	file	ファイル名
+			@return 成功なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool open(const std::string& file)
+		{
+			std::ifstream ifs(file, std::ios::binary);
+			if(!ifs) return false;
+			image_.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+			image_.resize((image_.size() + 511) & ~static_cast<size_t>(511), 0);
+			return !image_.empty();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ディスク・イメージを保存
+			@param[in]	file	ファイル名
+			@return 成功なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool save(const std::string& file) const
+		{
+			std::ofstream ofs(file, std::ios::binary);
+			if(!ofs) return false;
+			ofs.write(reinterpret_cast<const char*>(image_.data()), image_.size());
+			return static_cast<bool>(ofs);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ディスク・イメージの参照
+			@return ディスク・イメージ
+		*/
+		//-----------------------------------------------------------------//
+		std::vector<uint8_t>& at_image() { return image_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	カードの応答時間を設定（バイト数）
+			@param[in]	read	データ・トークンまでの 0xFF の数
+			@param[in]	busy	書き込み後のビジーの数
+		*/
+		//-----------------------------------------------------------------//
+		void set_latency(uint16_t read, uint16_t busy)
+		{
+			read_latency_ = read;
+			busy_ = busy;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	カウンターをリセット
+		*/
+		//-----------------------------------------------------------------//
+		void reset_count()
+		{
+			clock_ = 0;
+			for(auto& n : cmd_count_) n = 0;
+			read_block_ = 0;
+			write_block_ = 0;
+			error_ = 0;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	SPI クロック数を取得
+			@return クロック数
+		*/
+		//-----------------------------------------------------------------//
+		uint64_t get_clock() const { return clock_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コマンド数を取得
+			@param[in]	idx	コマンド番号（CMD17 なら 17）
+			@return コマンド数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_cmd_count(uint8_t idx) const { return cmd_count_[idx & 63]; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	送信したブロック数を取得
+			@return ブロック数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_read_block() const { return read_block_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	書き込んだブロック数を取得
+			@return ブロック数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_write_block() const { return write_block_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	プロトコル違反の回数を取得 @n
+					（転送中の選択解除、転送中やビジー中のコマンド等）
+			@return 回数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_error() const { return error_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	カードの選択（sd_sel から呼ばれる）
+			@param[in]	ena	選択する場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		void select(bool ena)
+		{
+			if(select_ && !ena) {
+				if(state_ != state::IDLE) {
+					++error_;
+					state_ = state::IDLE;
+				}
+				out_.clear();
+				cmd_pos_ = 0;
+			}
+			select_ = ena;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	開始（spi_io と同じ、速度は無視する）
+			@param[in]	speed	速度
+			@return 常に「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool start(uint32_t speed) { return true; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	１バイトの送受信
+			@param[in]	data	送信データ
+			@return 受信データ
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t xchg(uint8_t data = 0xff)
+		{
+			clock_ += 8;
+			if(!select_) return 0xFF;
+
+			uint8_t r = 0xFF;
+			if(!out_.empty()) {
+				r = out_.front();
+				out_.pop_front();
+			} else if(state_ == state::READ_MULTI) {
+				++sector_;
+				block_out_(sector_);
+				r = out_.front();
+				out_.pop_front();
+			}
+			input_(data);
+			return r;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	送信
+			@param[in]	src		ソース
+			@param[in]	size	バイト数
+		*/
+		//-----------------------------------------------------------------//
+		void send(const void* src, uint32_t size)
+		{
+			const uint8_t* p = static_cast<const uint8_t*>(src);
+			while(size > 0) {
+				xchg(*p++);
+				--size;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	受信
+			@param[out]	dst		転送先
+			@param[in]	size	バイト数
+		*/
+		//-----------------------------------------------------------------//
+		void recv(void* dst, uint32_t size)
+		{
+			uint8_t* p = static_cast<uint8_t*>(dst);
+			while(size > 0) {
+				*p++ = xchg();
+				--size;
+			}
+		}
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	SD カード選択ポート（device::PORT の代わり）
+		@param[in]	SD	カード・クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class SD = sd_spi>
+	struct sd_sel {
+		struct port_t {
+			port_t& operator = (uint8_t v) {
+				if(SD::get_current() != nullptr) SD::get_current()->select(v == 0);
+				return *this;
+			}
+		};
+		struct dir_t {
+			dir_t& operator = (uint8_t v) { return *this; }
+		};
+		static port_t	P;
+		static dir_t	DIR;
+	};
+	template <class SD> typename sd_sel<SD>::port_t sd_sel<SD>::P;
+	template <class SD> typename sd_sel<SD>::dir_t sd_sel<SD>::DIR;
+}
@@ -0,0 +1,420 @@
+//=====================================================================//
+/*!	@file
+	@brief	SPI バス・モデルで、spi_queue の CPU 使用率を評価する @n
+			一つの SPI バスに、ST7565（128 x 64）と MCP2515 を繋ぎ、@n
+			一定の周期（-rate）でフレームを描画して LCD へ転送しながら、@n
+			一定の周期（-msg）で届く CAN メッセージを受信する。@n
+			blocking: メインで ST7565::copy し、タイマー毎に check_recv、@n
+			          recv_msg で受信する（転送中は、受信出来ない）@n
+			queue: spi_queue に、ST7565::copy（-chunk バイト毎）と、@n
+			       MCP2515::status、recv_buffer を積み、タイマー割り込みの @n
+			       service で送る（メインは、転送の完了を待つだけ）@n
+			で、フレーム毎秒（fps）、描画、SPI 転送、割り込み、アイドルの @n
+			CPU 使用率、CAN の受信数、溢れた数、最大の遅れを表示する。@n
+			フレーム毎に、LCD の内容とフレームバッファ、受信したメッセージの @n
+			内容を検査する。@n
+			使い方： spi_sim [-frames n] [-rate fps] [-draw clocks] [-msg n/sec] @n
+			         [-tick Hz] [-chunk bytes] [-byte clocks]
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include "spi_model.hpp"
+
+namespace {
+
+	// 待ちループ（sleep_）一回のクロック数
+	static const uint32_t NOP_CYCLES = 8;
+
+	uint64_t	idle_;
+
+	void nop_()
+	{
+		idle_ += NOP_CYCLES;
+		sim::cpu_model::get().step(NOP_CYCLES);
+	}
+}
+
+// spi_queue の待ち（asm("nop")）で、モデルの時間を進める
+#define asm(x) nop_()
+#include "common/spi_queue.hpp"
+#undef asm
+#include "chip/ST7565.hpp"
+#include "chip/MCP2515.hpp"
+
+namespace {
+
+	typedef sim::spi_bus SPI;
+	typedef sim::bus_pin<SPI::pin::LCD_CS> LCD_CS;
+	typedef sim::bus_pin<SPI::pin::LCD_A0> LCD_A0;
+	typedef sim::bus_pin<SPI::pin::LCD_RES> LCD_RES;
+	typedef sim::bus_pin<SPI::pin::CAN_CS> CAN_CS;
+
+	typedef chip::ST7565<SPI, LCD_CS, LCD_A0, LCD_RES> LCD;
+	typedef chip::MCP2515<SPI, CAN_CS> MCP;
+
+	LCD		lcd_(SPI::get());
+	MCP		mcp_(SPI::get());
+
+	static const int16_t WIDTH = 128;
+	static const uint8_t PAGES = 8;
+	typedef graphics::dirty_page<WIDTH, PAGES> DIRTY;
+
+	uint8_t		fb_[WIDTH * PAGES];
+	DIRTY		dirty_;
+
+	uint32_t	frames_;
+	uint32_t	lcd_error_;
+	uint32_t	msg_error_;
+	uint64_t	draw_;
+
+	void draw_frame_(uint32_t frame, uint32_t draw)
+	{
+		for(uint16_t i = 0; i < sizeof(fb_); ++i) fb_[i] = (frame * 7 + i * 3) & 0xff;
+		dirty_.all();
+		sim::cpu_model::get().step(draw);
+		draw_ += draw;
+	}
+
+	bool same_()
+	{
+		auto& lcd = SPI::get().at_lcd();
+		for(uint8_t page = 0; page < PAGES; ++page) {
+			if(std::memcmp(lcd.get_page(page), &fb_[page * WIDTH], WIDTH) != 0) return false;
+		}
+		return true;
+	}
+
+	// フレームの開始を、rate（fps）の周期まで待つ（待つ間、task を呼ぶ）
+	void pace_(uint64_t& next, uint32_t rate, void (*task)())
+	{
+		auto& cpu = sim::cpu_model::get();
+		while(cpu.get_clock() < next) {
+			nop_();
+			if(task != nullptr) (*task)();
+		}
+		next += sim::cpu_model::F_CLK / rate;
+	}
+
+	//-----------------------------------------------------------------//
+	// blocking: メインで転送する
+	//-----------------------------------------------------------------//
+	volatile bool	tick_;
+
+	void blocking_tick_()
+	{
+		SPI::get().at_can().update(sim::cpu_model::get().get_clock());
+		tick_ = true;
+	}
+
+	// タイマー毎に、受信を確認する（timer_b_.sync() の代わり）
+	void blocking_poll_()
+	{
+		if(!tick_) return;
+		tick_ = false;
+		while(mcp_.check_recv()) {
+			mcp_.recv_msg();
+		}
+	}
+
+	//-----------------------------------------------------------------//
+	// queue: タイマー割り込みの service で転送する
+	//-----------------------------------------------------------------//
+	template <uint8_t SLICE>
+	struct queue_t {
+		typedef device::spi_queue<SPI, 8, SLICE> QUEUE;
+		static QUEUE& get() {
+			static QUEUE q(SPI::get());
+			return q;
+		}
+	};
+
+	uint16_t		chunk_;
+	volatile bool	lcd_req_;		///< メインからの転送要求
+	volatile bool	lcd_busy_;		///< 転送中（フレームバッファを使っている）
+	bool			lcd_next_;		///< 次の区間が積めずに、割り込みで積み直す
+	uint8_t			lcd_page_;
+	uint8_t			lcd_col_;
+	uint8_t			lcd_cmd_[3];
+
+	bool			can_busy_;
+	uint8_t			can_sts_[2];
+	uint8_t			can_buf_[MCP::RECV_BUFF_SIZE];
+	uint8_t			can_n_;
+
+	template <uint8_t SLICE> void lcd_task_(void* ctx);
+
+	// 次の更新範囲を（chunk_ バイトまで）積む、無ければフレームの終わり
+	template <uint8_t SLICE>
+	void lcd_put_()
+	{
+		while(lcd_page_ < PAGES) {
+			uint8_t org;
+			uint8_t end;
+			if(dirty_.get(lcd_page_, org, end)) {
+				if(lcd_col_ < org) lcd_col_ = org;
+				if(lcd_col_ < end) {
+					uint16_t len = end - lcd_col_;
+					if(len > chunk_) len = chunk_;
+					if(!lcd_.copy(queue_t<SLICE>::get(), &fb_[lcd_page_ * WIDTH + lcd_col_],
+						lcd_page_, lcd_col_, len, lcd_cmd_, lcd_task_<SLICE>)) {
+						lcd_next_ = true;
+						return;
+					}
+					lcd_next_ = false;
+					lcd_col_ += len;
+					return;
+				}
+			}
+			++lcd_page_;
+			lcd_col_ = 0;
+		}
+		lcd_next_ = false;
+		dirty_.clear();
+		if(!same_()) ++lcd_error_;
+		++frames_;
+		lcd_busy_ = false;
+	}
+
+	template <uint8_t SLICE>
+	void lcd_task_(void* ctx)
+	{
+		lcd_put_<SLICE>();
+	}
+
+	template <uint8_t SLICE> void can_status_task_(void* ctx);
+
+	template <uint8_t SLICE>
+	void can_recv_task_(void* ctx)
+	{
+		uint32_t id;
+		uint8_t ext;
+		uint8_t tmp[8];
+		uint8_t len;
+		MCP::decode_recv(can_buf_, id, ext, tmp, len);
+		bool ok = ext == 0 && len == 8 && id == SPI::get().at_can().get_id(can_n_);
+		for(uint8_t i = 0; i < len; ++i) {
+			if(tmp[i] != sim::mcp2515_dev::make_data(id, i)) ok = false;
+		}
+		if(!ok) ++msg_error_;
+		can_busy_ = false;
+	}
+
+	template <uint8_t SLICE>
+	void can_status_task_(void* ctx)
+	{
+		can_n_ = MCP::get_recv_buffer(can_sts_[1]);
+		if(can_n_ == 0xff || !MCP::recv_buffer(queue_t<SLICE>::get(), can_n_, can_buf_, can_recv_task_<SLICE>)) {
+			can_busy_ = false;
+		}
+	}
+
+	template <uint8_t SLICE>
+	void queue_tick_()
+	{
+		auto& que = queue_t<SLICE>::get();
+		SPI::get().at_can().update(sim::cpu_model::get().get_clock());
+		que.service();
+		if(!can_busy_) {
+			can_busy_ = MCP::status(que, can_sts_, can_status_task_<SLICE>);
+		}
+		if(lcd_req_) {
+			lcd_req_ = false;
+			lcd_page_ = 0;
+			lcd_col_ = 0;
+			lcd_put_<SLICE>();
+		} else if(lcd_next_) {
+			lcd_put_<SLICE>();
+		}
+	}
+
+
+	struct result_t {
+		uint64_t	clock;
+		uint64_t	draw;
+		uint64_t	spi;
+		uint64_t	isr;
+		uint64_t	idle;
+		uint32_t	frames;
+		uint32_t	count;
+		uint32_t	recv;
+		uint32_t	lost;
+		uint64_t	latency;
+		bool		ok;
+	};
+
+	void reset_(uint32_t msg)
+	{
+		auto& cpu = sim::cpu_model::get();
+		cpu.set_timer(0, nullptr);
+		SPI::get().at_lcd().clear();
+		SPI::get().at_can().start(msg, cpu.get_clock());
+		dirty_.all();
+		frames_ = 0;
+		lcd_error_ = 0;
+		msg_error_ = 0;
+		draw_ = 0;
+		idle_ = 0;
+		tick_ = false;
+		lcd_req_ = false;
+		lcd_busy_ = false;
+		lcd_next_ = false;
+		can_busy_ = false;
+		cpu.reset_count();
+	}
+
+	result_t finish_(uint64_t org, uint64_t spi, uint32_t errors)
+	{
+		auto& cpu = sim::cpu_model::get();
+		auto& bus = SPI::get();
+		cpu.set_timer(0, nullptr);
+		result_t t;
+		t.clock = cpu.get_clock() - org;
+		t.draw = draw_;
+		t.spi = bus.get_clock() - spi;
+		t.isr = cpu.get_isr_clock();
+		t.idle = idle_;
+		t.frames = frames_;
+		t.count = bus.at_can().get_count();
+		t.recv = bus.at_can().get_recv();
+		t.lost = bus.at_can().get_lost();
+		t.latency = bus.at_can().get_latency();
+		t.ok = lcd_error_ == 0 && msg_error_ == 0 && bus.get_errors() == errors;
+		return t;
+	}
+
+
+	result_t run_blocking_(uint32_t frames, uint32_t rate, uint32_t draw, uint32_t msg, uint32_t tick)
+	{
+		auto& cpu = sim::cpu_model::get();
+		reset_(msg);
+		uint64_t org = cpu.get_clock();
+		uint64_t spi = SPI::get().get_clock();
+		uint32_t errors = SPI::get().get_errors();
+		cpu.set_timer(tick, blocking_tick_);
+		uint64_t next = org;
+		for(uint32_t i = 0; i < frames; ++i) {
+			pace_(next, rate, blocking_poll_);
+			draw_frame_(i, draw);
+			lcd_.copy(fb_, dirty_);
+			if(!same_()) ++lcd_error_;
+			++frames_;
+			blocking_poll_();
+		}
+		pace_(next, rate, blocking_poll_);
+		return finish_(org, spi, errors);
+	}
+
+
+	template <uint8_t SLICE>
+	result_t run_queue_(uint32_t frames, uint32_t rate, uint32_t draw, uint32_t msg, uint32_t tick)
+	{
+		auto& cpu = sim::cpu_model::get();
+		reset_(msg);
+		uint64_t org = cpu.get_clock();
+		uint64_t spi = SPI::get().get_clock();
+		uint32_t errors = SPI::get().get_errors();
+		cpu.set_timer(tick, queue_tick_<SLICE>);
+		uint64_t next = org;
+		for(uint32_t i = 0; i < frames; ++i) {
+			pace_(next, rate, nullptr);
+			while(lcd_busy_) nop_();
+			draw_frame_(i, draw);
+			lcd_busy_ = true;
+			lcd_req_ = true;
+		}
+		pace_(next, rate, nullptr);
+		while(lcd_busy_) nop_();
+		auto t = finish_(org, spi, errors);
+		if(t.frames != frames) t.ok = false;
+		return t;
+	}
+
+
+	void report_(const std::string& title, const result_t& t)
+	{
+		double sec = static_cast<double>(t.clock) / sim::cpu_model::F_CLK;
+		auto per = [&](uint64_t n) { return static_cast<double>(n) * 100.0 / t.clock; };
+		std::cout << std::left << std::setw(12) << title << std::right << std::fixed
+			<< std::setprecision(1) << std::setw(7) << t.frames / sec
+			<< std::setw(8) << per(t.draw) << " %"
+			<< std::setw(7) << per(t.spi) << " %"
+			<< std::setw(7) << per(t.isr) << " %"
+			<< std::setw(7) << per(t.idle) << " %"
+			<< std::setw(7) << t.recv << "/" << t.count
+			<< std::setw(6) << t.lost
+			<< std::setw(9) << static_cast<double>(t.latency) * 1e6 / sim::cpu_model::F_CLK << " us"
+			<< "   " << (t.ok ? "OK" : "NG") << std::endl;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	uint32_t frames = 120;
+	uint32_t rate = 30;
+	uint32_t draw = 60000;
+	uint32_t msg = 1000;
+	uint32_t tick = 2000;
+	uint32_t byte = 0;  // ０なら、send、recv、xchg 毎の値（sim::spi_cycles）
+	chunk_ = 32;
+	for(int i = 1; i < argc; ++i) {
+		std::string s = argv[i];
+		if(s == "-frames" && (i + 1) < argc) {
+			frames = std::atoi(argv[++i]);
+			if(frames == 0) frames = 1;
+		} else if(s == "-rate" && (i + 1) < argc) {
+			rate = std::atoi(argv[++i]);
+			if(rate == 0) rate = 1;
+		} else if(s == "-draw" && (i + 1) < argc) {
+			draw = std::atoi(argv[++i]);
+		} else if(s == "-msg" && (i + 1) < argc) {
+			msg = std::atoi(argv[++i]);
+		} else if(s == "-tick" && (i + 1) < argc) {
+			tick = std::atoi(argv[++i]);
+			if(tick == 0) tick = 1;
+		} else if(s == "-chunk" && (i + 1) < argc) {
+			chunk_ = std::atoi(argv[++i]);
+			if(chunk_ == 0) chunk_ = 1;
+			if(chunk_ > WIDTH) chunk_ = WIDTH;
+		} else if(s == "-byte" && (i + 1) < argc) {
+			byte = std::atoi(argv[++i]);
+			if(byte == 0) byte = 1;
+		} else {
+			std::cout << "SPI bus model for spi_queue (ST7565 and MCP2515)" << std::endl;
+			std::cout << "usage: " << argv[0] << " [-frames n] [-rate fps] [-draw clocks] [-msg n/sec]"
+				" [-tick Hz] [-chunk bytes] [-byte clocks]" << std::endl;
+			return 0;
+		}
+	}
+	if(byte > 0) SPI::get().set_byte_cycles(byte);
+
+	std::cout << "Frames: " << frames << ", rate: " << rate << " fps, draw: " << draw << " clocks/frame, CAN: "
+		<< msg << " msg/sec, tick: " << tick << " Hz, chunk: " << chunk_ << " bytes, SPI: ";
+	if(byte > 0) std::cout << byte << " clocks/byte" << std::endl;
+	else std::cout << "send " << sim::spi_cycles::SEND << ", recv " << sim::spi_cycles::RECV
+		<< ", xchg " << sim::spi_cycles::XCHG << " clocks/byte" << std::endl;
+	std::cout << "method         fps     draw      SPI      ISR     idle   CAN recv  lost  max delay" << std::endl;
+
+	int err = 0;
+	auto b = run_blocking_(frames, rate, draw, msg, tick);
+	report_("blocking", b);
+	if(!b.ok) ++err;
+	// service 一回で送るバイト数（SLICE）
+	auto q0 = run_queue_<16>(frames, rate, draw, msg, tick);
+	report_("queue 16", q0);
+	auto q1 = run_queue_<32>(frames, rate, draw, msg, tick);
+	report_("queue 32", q1);
+	auto q2 = run_queue_<64>(frames, rate, draw, msg, tick);
+	report_("queue 64", q2);
+	if(!q0.ok || !q1.ok || !q2.ok) ++err;
+
+	std::cout << (err == 0 ? "Pass" : "Fail") << std::endl;
+	return err != 0 ? 1 : 0;
+}
@@ -0,0 +1,364 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	SPI バスと ST7565、MCP2515 のモデル（ホスト用） @n
+			device::spi_io と同じ xchg、send、recv を持ち、chip::ST7565 と @n
+			chip::MCP2515 の SPI クラスとして使う。（ポートは bus_pin<>） @n
+			選択されているデバイスに、バイトを渡す。@n
+			ST7565 は、ページ、カラムのコマンドと、表示 RAM への書き込み、@n
+			MCP2515 は、READ、WRITE、BIT MODIFY、READ STATUS、READ RX BUFFER @n
+			と、一定の周期で届くメッセージ（受信バッファ２つ）を持つ。@n
+			転送時間は、cpu_model（lcd_sim）のクロックで数え、１バイトは、@n
+			send、recv、xchg 毎に sim::spi_cycles の値を使う。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <cstring>
+#include "lcd_sim/lcd_model.hpp"
+
+namespace sim {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	ST7565 デバイス・モデル
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class st7565_dev {
+	public:
+		static const uint8_t PAGES = 8;
+		static const uint8_t COLUMNS = 132;
+
+	private:
+		uint8_t		ram_[PAGES][COLUMNS];
+		uint8_t		page_;
+		uint8_t		col_;
+		uint32_t	errors_;
+
+	public:
+		st7565_dev() : page_(0), col_(0), errors_(0) { clear(); }
+
+		void clear() { std::memset(ram_, 0, sizeof(ram_)); }
+
+		const uint8_t* get_page(uint8_t page) const { return ram_[page]; }
+
+		uint32_t get_errors() const { return errors_; }
+
+		void command(uint8_t cmd) {
+			if((cmd & 0xf0) == 0xb0) {
+				page_ = cmd & 0x0f;
+				if(page_ >= PAGES) ++errors_;
+			} else if((cmd & 0xf0) == 0x10) {
+				col_ = (col_ & 0x0f) | ((cmd & 0x0f) << 4);
+			} else if((cmd & 0xf0) == 0x00) {
+				col_ = (col_ & 0xf0) | (cmd & 0x0f);
+			}
+		}
+
+		void data(uint8_t v) {
+			if(page_ < PAGES && col_ < COLUMNS) ram_[page_][col_] = v;
+			else ++errors_;
+			++col_;
+		}
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	MCP2515 デバイス・モデル
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class mcp2515_dev {
+
+		static const uint8_t CANINTF = 0x2C;
+		static const uint8_t RXB0SIDH = 0x61;
+		static const uint8_t RXB1SIDH = 0x71;
+
+		uint8_t		reg_[128];
+		uint8_t		cmd_;
+		uint8_t		pos_;
+		uint8_t		adrs_;
+		uint8_t		mask_;
+		int8_t		read_rx_;	///< READ RX BUFFER で読んだバッファ（無ければ -1）
+
+		uint64_t	arrive_[2];
+		uint32_t	id_[2];
+
+		uint32_t	period_;
+		uint64_t	next_;
+		uint32_t	count_;
+		uint32_t	recv_;
+		uint32_t	lost_;
+		uint64_t	latency_;
+
+		void release_(uint8_t n, uint64_t clock) {
+			uint8_t bit = 1 << n;
+			if((reg_[CANINTF] & bit) == 0) return;
+			reg_[CANINTF] &= ~bit;
+			uint64_t t = clock - arrive_[n];
+			if(t > latency_) latency_ = t;
+			++recv_;
+		}
+
+		void arrive_msg_(uint64_t clock) {
+			uint8_t n;
+			if((reg_[CANINTF] & 1) == 0) n = 0;
+			else if((reg_[CANINTF] & 2) == 0) n = 1;
+			else {  // 受信バッファが２つとも一杯
+				++lost_;
+				return;
+			}
+			uint32_t id = count_ & 0x7ff;
+			uint8_t* p = &reg_[n == 0 ? RXB0SIDH : RXB1SIDH];
+			p[0] = id >> 3;
+			p[1] = (id & 7) << 5;
+			p[2] = 0;
+			p[3] = 0;
+			p[4] = 8;
+			for(uint8_t i = 0; i < 8; ++i) p[5 + i] = make_data(id, i);
+			reg_[CANINTF] |= 1 << n;
+			arrive_[n] = clock;
+			id_[n] = id;
+		}
+
+	public:
+		mcp2515_dev() : cmd_(0), pos_(0), adrs_(0), mask_(0), read_rx_(-1),
+			arrive_{ 0 }, id_{ 0 }, period_(0), next_(0),
+			count_(0), recv_(0), lost_(0), latency_(0) {
+			std::memset(reg_, 0, sizeof(reg_));
+		}
+
+		/// メッセージ（ID）のデータ
+		static uint8_t make_data(uint32_t id, uint8_t i) { return (id * 7 + i * 13) & 0xff; }
+
+		//-------------------------------------------------------------//
+		/*!
+			@brief	メッセージの周期を設定（受信数などもリセット）
+			@param[in]	freq	毎秒のメッセージ数（０なら届かない）
+			@param[in]	clock	現在のクロック
+		*/
+		//-------------------------------------------------------------//
+		void start(uint32_t freq, uint64_t clock) {
+			reg_[CANINTF] = 0;
+			period_ = freq > 0 ? cpu_model::F_CLK / freq : 0;
+			next_ = clock + period_;
+			count_ = 0;
+			recv_ = 0;
+			lost_ = 0;
+			latency_ = 0;
+		}
+
+		/// クロックまでに届くメッセージを受信バッファに入れる
+		void update(uint64_t clock) {
+			if(period_ == 0) return;
+			while(next_ <= clock) {
+				arrive_msg_(next_);
+				++count_;
+				next_ += period_;
+			}
+		}
+
+		uint32_t get_count() const { return count_; }
+		uint32_t get_recv() const { return recv_; }
+		uint32_t get_lost() const { return lost_; }
+		uint64_t get_latency() const { return latency_; }
+		uint32_t get_id(uint8_t n) const { return id_[n & 1]; }
+
+		void select(bool ena, uint64_t clock) {
+			if(ena) {
+				pos_ = 0;
+				read_rx_ = -1;
+			} else if(read_rx_ >= 0) {  // READ RX BUFFER は、選択解除でフラグをクリア
+				release_(read_rx_, clock);
+				read_rx_ = -1;
+			}
+		}
+
+		uint8_t xchg(uint8_t v, uint64_t clock) {
+			uint8_t out = 0xff;
+			if(pos_ == 0) {
+				cmd_ = v;
+				if((v & 0xf9) == 0x90) {  // READ RX BUFFER
+					read_rx_ = (v >> 2) & 1;
+					adrs_ = (read_rx_ == 0 ? RXB0SIDH : RXB1SIDH) + ((v & 2) ? 5 : 0);
+				}
+			} else if(cmd_ == 0xa0) {  // READ STATUS
+				out = reg_[CANINTF] & 0x03;
+			} else if(read_rx_ >= 0) {
+				out = reg_[adrs_ & 0x7f];
+				++adrs_;
+			} else if(cmd_ == 0x02) {  // READ
+				if(pos_ == 1) adrs_ = v;
+				else {
+					out = reg_[adrs_ & 0x7f];
+					++adrs_;
+				}
+			} else if(cmd_ == 0x03) {  // WRITE
+				if(pos_ == 1) adrs_ = v;
+				else {
+					reg_[adrs_ & 0x7f] = v;
+					++adrs_;
+				}
+			} else if(cmd_ == 0x05) {  // BIT MODIFY
+				if(pos_ == 1) adrs_ = v;
+				else if(pos_ == 2) mask_ = v;
+				else if(pos_ == 3) {
+					uint8_t a = adrs_ & 0x7f;
+					uint8_t old = reg_[a];
+					reg_[a] = (old & ~mask_) | (v & mask_);
+					if(a == CANINTF) {
+						for(uint8_t n = 0; n < 2; ++n) {
+							if((old & ~reg_[a]) & (1 << n)) {
+								reg_[a] |= 1 << n;
+								release_(n, clock);
+							}
+						}
+					}
+				}
+			}
+			if(pos_ < 255) ++pos_;
+			return out;
+		}
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	SPI バス・モデル
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class spi_bus {
+	public:
+		//-------------------------------------------------------------//
+		/*!
+			@brief	ポート
+		*/
+		//-------------------------------------------------------------//
+		enum class pin : uint8_t {
+			LCD_CS,		///< ST7565 /CS
+			LCD_A0,		///< ST7565 A0
+			LCD_RES,	///< ST7565 /RES
+			CAN_CS,		///< MCP2515 /CS
+		};
+
+	private:
+		st7565_dev	lcd_;
+		mcp2515_dev	can_;
+
+		bool		lcd_cs_;
+		bool		lcd_a0_;
+		bool		can_cs_;
+
+		uint32_t	send_cycles_;
+		uint32_t	recv_cycles_;
+		uint32_t	xchg_cycles_;
+		uint32_t	pin_cycles_;
+		uint64_t	clock_;
+		uint32_t	errors_;
+
+		spi_bus() : lcd_cs_(true), lcd_a0_(false), can_cs_(true),
+			send_cycles_(spi_cycles::SEND), recv_cycles_(spi_cycles::RECV), xchg_cycles_(spi_cycles::XCHG),
+			pin_cycles_(10), clock_(0), errors_(0) { }
+
+		void step_(uint32_t n) {
+			clock_ += n;
+			cpu_model::get().step(n);
+		}
+
+		uint8_t xchg_(uint8_t data, uint32_t cycles) {
+			step_(cycles);
+			if(!lcd_cs_ && !can_cs_) {
+				++errors_;
+				return 0xff;
+			}
+			if(!lcd_cs_) {
+				if(lcd_a0_) lcd_.data(data);
+				else lcd_.command(data);
+				return 0xff;
+			} else if(!can_cs_) {
+				return can_.xchg(data, cpu_model::get().get_clock());
+			}
+			++errors_;
+			return 0xff;
+		}
+
+	public:
+		static spi_bus& get() {
+			static spi_bus bus;
+			return bus;
+		}
+
+		st7565_dev& at_lcd() { return lcd_; }
+		mcp2515_dev& at_can() { return can_; }
+
+		/// send、recv、xchg の１バイトのクロック数を同じ値にする
+		void set_byte_cycles(uint32_t n) {
+			send_cycles_ = n;
+			recv_cycles_ = n;
+			xchg_cycles_ = n;
+		}
+
+		/// 転送とポート操作のクロック数
+		uint64_t get_clock() const { return clock_; }
+
+		/// 二つ同時の選択、選択無しの転送の回数（と、デバイスのエラー）
+		uint32_t get_errors() const { return errors_ + lcd_.get_errors(); }
+
+		void set_pin(pin p, bool v) {
+			step_(pin_cycles_);
+			switch(p) {
+			case pin::LCD_CS:
+				lcd_cs_ = v;
+				break;
+			case pin::LCD_A0:
+				lcd_a0_ = v;
+				break;
+			case pin::CAN_CS:
+				if(can_cs_ != v) can_.select(!v, cpu_model::get().get_clock());
+				can_cs_ = v;
+				break;
+			default:
+				break;
+			}
+		}
+
+		uint8_t xchg(uint8_t data = 0xff) { return xchg_(data, xchg_cycles_); }
+
+		void send(const void* src, uint16_t size) {
+			const uint8_t* p = static_cast<const uint8_t*>(src);
+			for(uint16_t i = 0; i < size; ++i) xchg_(p[i], send_cycles_);
+		}
+
+		void recv(void* dst, uint16_t size) {
+			uint8_t* p = static_cast<uint8_t*>(dst);
+			for(uint16_t i = 0; i < size; ++i) p[i] = xchg_(0xff, recv_cycles_);
+		}
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	バスのポート（device::PORT の代わり）
+		@param[in]	PIN	ポート
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <spi_bus::pin PIN>
+	struct bus_pin {
+		struct port_t {
+			port_t& operator = (bool v) {
+				spi_bus::get().set_pin(PIN, v);
+				return *this;
+			}
+		};
+		struct dir_t {
+			dir_t& operator = (uint8_t v) { return *this; }
+		};
+		static port_t	P;
+		static dir_t	DIR;
+	};
+	template <spi_bus::pin PIN> typename bus_pin<PIN>::port_t bus_pin<PIN>::P;
+	template <spi_bus::pin PIN> typename bus_pin<PIN>::dir_t bus_pin<PIN>::DIR;
+}
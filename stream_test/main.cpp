@@ -0,0 +1,173 @@
+//=====================================================================//
+/*!	@file
+	@brief	common/stream_input.hpp の検査 @n
+			同じ行を、「一度に」、「１文字ずつ」、「全ての位置で二つに分けて」 @n
+			投入し、field、end の呼び出し（値、変換数、エラー種別）が、期待 @n
+			と一致するかを検査する。@n
+			行は、CR-LF で閉じて二回続けて流し、エラーの後の行が、正しく @n
+			解析されるかも見る。@n
+			使い方： stream_test [-v]
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <string>
+#include "common/stream_input.hpp"
+
+namespace {
+
+	typedef utils::stream_input_base::error error;
+
+	const char* error_str_(error err)
+	{
+		switch(err) {
+		case error::none:        return "none";
+		case error::cha_sets:    return "cha_sets";
+		case error::partition:   return "partition";
+		case error::input_type:  return "input_type";
+		case error::not_integer: return "not_integer";
+		case error::terminate:   return "terminate";
+		}
+		return "?";
+	}
+
+	// field、end の呼び出しを文字列に記録
+	struct task_t {
+		std::string	log;
+
+		void field(uint8_t idx, int32_t val) {
+			log += "f" + std::to_string(idx) + "=" + std::to_string(val) + " ";
+		}
+
+		void end(uint8_t num, error err) {
+			log += "end(" + std::to_string(num) + "," + error_str_(err) + ") ";
+		}
+	};
+
+	typedef utils::stream_input<task_t, 8> input;
+
+	struct case_t {
+		const char*	form;
+		const char*	line;
+		const char*	expect;		///< 一行分の期待（二回繰り返す）
+	};
+
+	const case_t cases_[] = {
+		// 整数
+		{ "%d,%d",  "123,-45",    "f0=123 f1=-45 end(2,none) " },
+		{ "%d",     "  +7",       "f0=7 end(1,none) " },
+		{ "%b %o",  "1011 17",    "f0=11 f1=15 end(2,none) " },
+		{ "%d%%",   "50%",        "f0=50 end(1,none) " },
+		{ "%d",     "-",          "end(0,not_integer) " },
+		{ "%d",     "a",          "end(0,not_integer) " },
+		{ "%d,%d",  "12",         "f0=12 end(1,terminate) " },
+		{ "%d,%d",  "12;3",       "f0=12 end(1,partition) " },
+		{ "%d",     "12 ",        "f0=12 end(1,terminate) " },
+		// １６進
+		{ "%x:%x",  "1aF:FF",     "f0=431 f1=255 end(2,none) " },
+		{ "%x",     "-10",        "f0=-16 end(1,none) " },
+		{ "%x",     "0x1a",       "f0=0 end(1,terminate) " },
+		{ "%x",     "g",          "end(0,not_integer) " },
+		// 固定小数点（小数部８ビット）
+		{ "%f",     "1.5",        "f0=384 end(1,none) " },
+		{ "%f",     "-0.25",      "f0=-64 end(1,none) " },
+		{ "%f",     "3.14159",    "f0=804 end(1,none) " },
+		{ "%f",     "12.3456789", "f0=3160 end(1,none) " },
+		{ "%f",     "2",          "f0=512 end(1,none) " },
+		{ "%f",     "1.",         "f0=256 end(1,none) " },
+		{ "%f",     ".5",         "f0=128 end(1,none) " },
+		{ "%f,%f",  "-.5,0.75",   "f0=-128 f1=192 end(2,none) " },
+		{ "%f",     ".",          "end(0,not_integer) " },
+		{ "%f",     "-.",         "end(0,not_integer) " },
+		{ "%f,%d",  ".,1",        "end(0,not_integer) " },
+		{ "%f",     "1.2.3",      "f0=307 end(1,terminate) " },
+		// 文字、文字セット、書式
+		{ "%c=%d",  "k=9",        "f0=107 f1=9 end(2,none) " },
+		{ "[abc]%d", "b5",        "f0=5 end(1,none) " },
+		{ "[abc]%d", "x5",        "end(0,cha_sets) " },
+		{ "%q",     "1",          "end(0,input_type) " },
+	};
+
+	// 投入方法
+	enum class feed {
+		whole,	///< 一度に
+		byte,	///< １文字ずつ
+		split,	///< 位置 pos で二つに分ける
+	};
+
+	std::string run_(const char* form, const std::string& text, feed f, uint32_t pos)
+	{
+		input inp(form);
+		switch(f) {
+		case feed::whole:
+			inp.puts(text.c_str());
+			break;
+		case feed::byte:
+			for(char ch : text) inp.put(ch);
+			break;
+		case feed::split:
+			inp.puts(text.substr(0, pos).c_str());
+			inp.puts(text.substr(pos).c_str());
+			break;
+		}
+		return inp.at_task().log;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	bool verbose = false;
+	for(int i = 1; i < argc; ++i) {
+		std::string s = argv[i];
+		if(s == "-v") {
+			verbose = true;
+		} else {
+			std::cout << "stream_input field/end test" << std::endl;
+			std::cout << "usage: " << argv[0] << " [-v]" << std::endl;
+			return 0;
+		}
+	}
+
+	uint32_t runs = 0;
+	uint32_t err = 0;
+	for(const auto& t : cases_) {
+		std::string text = t.line;
+		text += "\r\n";
+		text += t.line;
+		text += "\r\n";
+		std::string expect = t.expect;
+		expect += t.expect;
+
+		uint32_t e = 0;
+		// 一度に、１文字ずつ、全ての分割位置
+		uint32_t n = text.size() + 3;
+		for(uint32_t i = 0; i < n; ++i) {
+			feed f = feed::split;
+			if(i == 0) f = feed::whole;
+			else if(i == 1) f = feed::byte;
+			uint32_t pos = i >= 2 ? i - 2 : 0;
+			std::string log = run_(t.form, text, f, pos);
+			++runs;
+			if(log != expect) {
+				++e;
+				if(verbose) {
+					std::cout << "  \"" << t.form << "\" \"" << t.line << "\" (" << i
+						<< "): " << log << std::endl;
+				}
+			}
+		}
+		if(verbose || e > 0) {
+			std::cout << (e == 0 ? "OK  " : "NG  ") << "\"" << t.form << "\"  \"" << t.line
+				<< "\"  " << t.expect << std::endl;
+		}
+		err += e;
+	}
+	std::cout << "Cases: " << (sizeof(cases_) / sizeof(cases_[0])) << ", runs: " << runs
+		<< ", error: " << err << std::endl;
+	std::cout << (err == 0 ? "Pass" : "Fail") << std::endl;
+	return err != 0 ? 1 : 0;
+}
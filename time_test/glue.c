@@ -0,0 +1,91 @@
+//=====================================================================//
+/*!	@file
+	@brief	common/time.c の呼び出し（ホスト用） @n
+			比較の為、以前のループ版（年、月を一つずつ数える）も置く。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include "common/time.h"
+#include "glue.h"
+
+static void out_(const struct tm* t, int16_t* out)
+{
+	out[0] = t->tm_sec;
+	out[1] = t->tm_min;
+	out[2] = t->tm_hour;
+	out[3] = t->tm_mday;
+	out[4] = t->tm_mon;
+	out[5] = t->tm_year + 1900;
+	out[6] = t->tm_wday;
+	out[7] = t->tm_yday;
+}
+
+
+void r8c_gmtime(uint32_t t, int16_t* out)
+{
+	time_t tt = t;
+	out_(gmtime(&tt), out);
+}
+
+
+uint32_t r8c_mktime(const int16_t* in)
+{
+	struct tm t;
+	t.tm_sec  = in[0];
+	t.tm_min  = in[1];
+	t.tm_hour = in[2];
+	t.tm_mday = in[3];
+	t.tm_mon  = in[4];
+	t.tm_year = in[5] - 1900;
+	return (uint32_t)mktime_gmt(&t);
+}
+
+
+void old_gmtime(uint32_t t, int16_t* out)
+{
+	struct tm st;
+	short i, j, k;
+
+	st.tm_sec  = t % 60;
+	t /= 60;
+	st.tm_min  = t % 60;
+	t /= 60;
+	st.tm_hour = t % 24;
+	t /= 24;
+	st.tm_wday = (t + 4) % 7;
+
+	j = 1970;
+	while(t >= (uint32_t)(i = get_yday(j))) {
+		t -= i;
+		j++;
+	}
+	st.tm_year = j - 1900;
+	st.tm_yday = t;
+
+	k = 0;
+	while(t >= (uint32_t)(i = get_mday(j, k))) {
+		t -= i;
+		k++;
+	}
+	st.tm_mon = k;
+	st.tm_mday = t + 1;
+	out_(&st, out);
+}
+
+
+uint32_t old_mktime(const int16_t* in)
+{
+	uint32_t d = 0;
+	short i;
+	for(i = 1970; i < in[5]; ++i) {
+		d += get_yday(i);
+	}
+	for(i = 0; i < in[4]; ++i) {
+		d += get_mday(in[5], i);
+	}
+	d += in[3] - 1;
+	return d * 86400UL + in[2] * 3600UL + in[1] * 60 + in[0];
+}
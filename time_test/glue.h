@@ -0,0 +1,34 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	common/time.c の呼び出し（ホスト用） @n
+			common/time.h の tm 構造体は、ホストの tm 構造体と同じ名前なので、@n
+			C++ 側からは、この関数を通して使う。@n
+			値の並び： sec、min、hour、mday、mon、year（1900 〜）、wday、yday
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/// common/time.c の gmtime
+	void r8c_gmtime(uint32_t t, int16_t* out);
+
+	/// common/time.c の mktime_gmt（out の sec 〜 year を使う）
+	uint32_t r8c_mktime(const int16_t* in);
+
+	/// 以前の（年、月をループで数える）gmtime
+	void old_gmtime(uint32_t t, int16_t* out);
+
+	/// 以前の（年、月をループで数える）mktime_gmt
+	uint32_t old_mktime(const int16_t* in);
+
+#ifdef __cplusplus
+};
+#endif
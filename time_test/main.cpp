@@ -0,0 +1,177 @@
+//=====================================================================//
+/*!	@file
+	@brief	common/time.c の gmtime、mktime_gmt の検査とベンチマーク @n
+			1970 年 1 月 1 日から 2106 年 2 月 7 日 06:28:15（0xffffffff）まで、@n
+			ホストの gmtime_r と全ての項目を比較し、mktime_gmt で元に戻るかを @n
+			検査する。既定では、全ての日（日毎に６点の時刻）と、997 秒毎の時刻、@n
+			-full では、全ての秒を検査する。@n
+			一回の呼び出しの時間（ns）と、クロック数（x86 の TSC）を、以前の @n
+			ループ版と比べて表示する。@n
+			使い方： time_test [-full] [-loop n]
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ctime>
+#include <cstdlib>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC
+#endif
+#include "glue.h"
+
+namespace {
+
+	static const uint32_t LAST_DAY = 0xffffffffUL / 86400;
+
+	uint64_t	count_;
+	uint32_t	error_;
+
+	void check_(uint32_t t)
+	{
+		++count_;
+		int16_t v[8];
+		r8c_gmtime(t, v);
+		time_t tt = t;
+		struct tm r;
+		gmtime_r(&tt, &r);
+		bool ok = v[0] == r.tm_sec && v[1] == r.tm_min && v[2] == r.tm_hour
+			&& v[3] == r.tm_mday && v[4] == r.tm_mon && v[5] == (r.tm_year + 1900)
+			&& v[6] == r.tm_wday && v[7] == r.tm_yday;
+		if(ok && r8c_mktime(v) != t) ok = false;
+		if(!ok) {
+			if(error_ < 8) {
+				std::cout << "NG: " << t << " -> " << v[5] << "/" << (v[4] + 1) << "/" << v[3]
+					<< " " << v[2] << ":" << v[1] << ":" << v[0] << " wday:" << v[6]
+					<< " yday:" << v[7] << std::endl;
+			}
+			++error_;
+		}
+	}
+
+
+	struct bench_t {
+		double	ns;
+		double	cycles;
+	};
+
+
+	template <typename FUNC>
+	bench_t bench_(FUNC func, const std::vector<uint32_t>& src, uint32_t loop)
+	{
+		auto org = std::chrono::steady_clock::now();
+#ifdef HAVE_TSC
+		uint64_t c0 = __rdtsc();
+#endif
+		for(uint32_t n = 0; n < loop; ++n) {
+			for(auto t : src) func(t);
+		}
+#ifdef HAVE_TSC
+		uint64_t c1 = __rdtsc();
+#endif
+		auto now = std::chrono::steady_clock::now();
+		double calls = static_cast<double>(src.size()) * loop;
+		bench_t b;
+		b.ns = std::chrono::duration<double, std::nano>(now - org).count() / calls;
+#ifdef HAVE_TSC
+		b.cycles = static_cast<double>(c1 - c0) / calls;
+#else
+		b.cycles = 0.0;
+#endif
+		return b;
+	}
+
+
+	volatile int16_t	sink_;
+
+
+	void report_(const char* title, const bench_t& b)
+	{
+		std::cout << std::left << std::setw(14) << title << std::right << std::fixed
+			<< std::setprecision(1) << std::setw(8) << b.ns << " ns/call";
+		if(b.cycles > 0.0) std::cout << std::setw(10) << b.cycles << " cycles/call";
+		std::cout << std::endl;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	bool full = false;
+	uint32_t loop = 64;
+	for(int i = 1; i < argc; ++i) {
+		std::string s = argv[i];
+		if(s == "-full") {
+			full = true;
+		} else if(s == "-loop" && (i + 1) < argc) {
+			loop = std::atoi(argv[++i]);
+			if(loop == 0) loop = 1;
+		} else {
+			std::cout << "gmtime/mktime_gmt round-trip test and benchmark for common/time.c"
+				<< std::endl;
+			std::cout << "usage: " << argv[0] << " [-full] [-loop n]" << std::endl;
+			return 0;
+		}
+	}
+
+	if(full) {
+		uint32_t t = 0;
+		do {
+			check_(t);
+			++t;
+		} while(t != 0);
+	} else {
+		static const uint32_t sec[] = { 0, 1, 59, 3599, 43200, 86399 };
+		for(uint32_t d = 0; d <= LAST_DAY; ++d) {
+			for(auto s : sec) {
+				uint64_t t = static_cast<uint64_t>(d) * 86400 + s;
+				if(t <= 0xffffffffUL) check_(t);
+			}
+		}
+		for(uint64_t t = 0; t <= 0xffffffffUL; t += 997) check_(t);
+		check_(0xffffffffUL);
+	}
+	std::cout << "round-trip " << (error_ == 0 ? "OK  " : "NG  ") << count_ << " times, "
+		<< error_ << " errors (1970/1/1 to 2106/2/7)" << std::endl;
+
+	// 2021 年前後（RTC の典型）と、範囲全体
+	std::vector<uint32_t> now;
+	std::vector<uint32_t> all;
+	srand(1);
+	for(uint32_t i = 0; i < 4096; ++i) {
+		now.push_back(1609459200UL + static_cast<uint32_t>(rand()) % (86400UL * 365 * 2));
+		all.push_back((static_cast<uint32_t>(rand()) << 16) ^ static_cast<uint32_t>(rand()));
+	}
+	std::vector<int16_t> tmp(8);
+	std::vector<std::vector<int16_t>> tm_now;
+	for(auto t : now) {
+		r8c_gmtime(t, tmp.data());
+		tm_now.push_back(tmp);
+	}
+
+	std::cout << "2021 .. 2022:" << std::endl;
+	report_("gmtime", bench_([&](uint32_t t) { int16_t v[8]; r8c_gmtime(t, v); sink_ = v[3]; },
+		now, loop));
+	report_("gmtime (old)", bench_([&](uint32_t t) { int16_t v[8]; old_gmtime(t, v); sink_ = v[3]; },
+		now, loop));
+	std::vector<uint32_t> idx(tm_now.size());
+	for(uint32_t i = 0; i < idx.size(); ++i) idx[i] = i;
+	report_("mktime", bench_([&](uint32_t i) { sink_ = r8c_mktime(tm_now[i].data()); }, idx, loop));
+	report_("mktime (old)", bench_([&](uint32_t i) { sink_ = old_mktime(tm_now[i].data()); },
+		idx, loop));
+	std::cout << "1970 .. 2106:" << std::endl;
+	report_("gmtime", bench_([&](uint32_t t) { int16_t v[8]; r8c_gmtime(t, v); sink_ = v[3]; },
+		all, loop));
+	report_("gmtime (old)", bench_([&](uint32_t t) { int16_t v[8]; old_gmtime(t, v); sink_ = v[3]; },
+		all, loop));
+
+	std::cout << (error_ == 0 ? "Pass" : "Fail") << std::endl;
+	return error_ != 0 ? 1 : 0;
+}
@@ -0,0 +1,22 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	R8C/M110AN, R8C/M120AN グループ・割り込みレジスター（ホスト用の代替）@n
+			uart_io が使うレジスターだけを、メモリー上の変数で置き換える。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+
+namespace device {
+
+	struct ilvl_t {
+		uint8_t	B01;
+		uint8_t	B45;
+	};
+	static ilvl_t ILVL8;
+	static ilvl_t ILVL9;
+}
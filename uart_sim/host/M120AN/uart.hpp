@@ -0,0 +1,307 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	R8C/M110AN, R8C/M120AN グループ・UART レジスター（ホスト用の代替） @n
+			UART0 のレジスターを、送信バッファ（UTBL）と送信シフト・レジスター @n
+			の動作モデルで置き換える。@n
+			・UTBL からシフト・レジスターへ移った時に TI を立て、送信割り込みを起こす @n
+			・１バイトの送信時間は、set_byte_cycles() で設定したクロック数 @n
+			・時間は、step()（asm("nop") を置き換えた待ち）で進める @n
+			送信したバイト、割り込み回数、オーバーラン（UTBL の上書き）を記録する。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <vector>
+
+namespace sim {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	UART 送信モデル・クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class uart_model {
+
+		uint32_t	byte_cycles_;
+		uint64_t	clock_;
+
+		uint8_t		utbl_;
+		bool		full_;		///< UTBL にデータがある
+		uint8_t		shift_;
+		bool		busy_;		///< シフト・レジスターが送信中
+		uint32_t	remain_;
+
+		bool		pending_;	///< 送信割り込み要求（UTIF）
+		bool		in_isr_;
+
+		void (*tx_task_)();
+
+		std::vector<uint8_t>	out_;
+		uint32_t	isr_count_;
+		uint32_t	overrun_;
+
+		void load_() {
+			if(!busy_ && full_) {
+				shift_ = utbl_;
+				full_ = false;
+				busy_ = true;
+				remain_ = byte_cycles_;
+				pending_ = true;
+			}
+		}
+
+		void dispatch_() {
+			while(pending_ && ie && !in_isr_ && tx_task_ != nullptr) {
+				in_isr_ = true;
+				++isr_count_;
+				tx_task_();
+				in_isr_ = false;
+			}
+		}
+
+	public:
+		uint8_t		uc0;
+		uint8_t		uc1;
+		uint8_t		umr;
+		uint8_t		ubrg;
+		bool		ie;			///< 送信割り込み許可（UTIE）
+		bool		rie;		///< 受信割り込み許可（URIE）
+
+		uart_model() : byte_cycles_(1736), clock_(0), utbl_(0), full_(false), shift_(0),
+			busy_(false), remain_(0), pending_(false), in_isr_(false), tx_task_(nullptr),
+			out_(), isr_count_(0), overrun_(0), uc0(0), uc1(0), umr(0), ubrg(0),
+			ie(false), rie(false) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	インスタンスを取得
+			@return インスタンス
+		*/
+		//-----------------------------------------------------------------//
+		static uart_model& get() {
+			static uart_model m;
+			return m;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	１バイトの送信時間を設定
+			@param[in]	cyc	クロック数（F_CLK / baud * 10）
+		*/
+		//-----------------------------------------------------------------//
+		void set_byte_cycles(uint32_t cyc) { byte_cycles_ = cyc; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	送信割り込みタスクを設定
+			@param[in]	task	タスク（UART0_TX_intr 相当）
+		*/
+		//-----------------------------------------------------------------//
+		void set_tx_task(void (*task)()) { tx_task_ = task; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	時間を進める
+			@param[in]	cyc	クロック数
+		*/
+		//-----------------------------------------------------------------//
+		void step(uint32_t cyc)
+		{
+			while(cyc > 0) {
+				if(!busy_) {
+					clock_ += cyc;
+					break;
+				}
+				uint32_t n = cyc < remain_ ? cyc : remain_;
+				clock_ += n;
+				remain_ -= n;
+				cyc -= n;
+				if(remain_ == 0) {
+					out_.push_back(shift_);
+					busy_ = false;
+					load_();
+					dispatch_();
+				}
+			}
+		}
+
+
+		void write_utbl(uint8_t v) {
+			if(full_) ++overrun_;
+			utbl_ = v;
+			full_ = true;
+			load_();
+			dispatch_();
+		}
+
+		bool get_ti() const { return !full_; }
+		bool get_txept() const { return !full_ && !busy_; }
+		bool get_pending() const { return pending_; }
+		void clear_pending() { pending_ = false; }
+		void update() { dispatch_(); }
+
+		uint64_t get_clock() const { return clock_; }
+		const std::vector<uint8_t>& get_out() const { return out_; }
+		uint32_t get_isr_count() const { return isr_count_; }
+		uint32_t get_overrun() const { return overrun_; }
+
+		void reset_count() {
+			clock_ = 0;
+			out_.clear();
+			isr_count_ = 0;
+			overrun_ = 0;
+		}
+	};
+
+
+	// ビット・フィールド（common/io_utils.hpp の bit_rw_t、bits_rw_t 相当）
+	template <class R, uint8_t POS, uint8_t LEN = 1>
+	struct bits_t {
+		typedef typename R::value_type V;
+		static V mask() { return static_cast<V>(((1u << LEN) - 1) << POS); }
+		V b(V v = 1) const { return static_cast<V>((v << POS) & mask()); }
+		V operator () () const { return (R::read() & mask()) >> POS; }
+		void operator = (V v) { R::write(static_cast<V>((R::read() & ~mask()) | b(v))); }
+	};
+
+
+	template <class R>
+	struct reg_t {
+		typedef typename R::value_type V;
+		void operator = (V v) { R::write(v); }
+		V operator () () const { return R::read(); }
+	};
+
+
+	struct umr_io {
+		typedef uint8_t value_type;
+		static uint8_t read() { return uart_model::get().umr; }
+		static void write(uint8_t v) { uart_model::get().umr = v; }
+	};
+	struct umr_t : public reg_t<umr_io> {
+		using reg_t<umr_io>::operator =;
+		bits_t<umr_io, 0, 3> SMD;
+		bits_t<umr_io, 4> STPS;
+		bits_t<umr_io, 5> PRY;
+		bits_t<umr_io, 6> PRYE;
+	};
+
+
+	struct ubrg_io {
+		typedef uint8_t value_type;
+		static uint8_t read() { return uart_model::get().ubrg; }
+		static void write(uint8_t v) { uart_model::get().ubrg = v; }
+	};
+
+
+	struct utbl_io {
+		typedef uint8_t value_type;
+		static uint8_t read() { return 0; }
+		static void write(uint8_t v) { uart_model::get().write_utbl(v); }
+	};
+
+
+	struct uc0_io {
+		typedef uint8_t value_type;
+		static uint8_t read() {
+			auto& m = uart_model::get();
+			return (m.uc0 & ~0x08) | (m.get_txept() ? 0x08 : 0);
+		}
+		static void write(uint8_t v) { uart_model::get().uc0 = v; }
+	};
+	struct uc0_t : public reg_t<uc0_io> {
+		using reg_t<uc0_io>::operator =;
+		bits_t<uc0_io, 0, 2> CLK;
+		bits_t<uc0_io, 3> TXEPT;
+	};
+
+
+	struct uc1_io {
+		typedef uint8_t value_type;
+		static uint8_t read() {
+			auto& m = uart_model::get();
+			return (m.uc1 & ~0x0a) | (m.get_ti() ? 0x02 : 0);  // RI は常に「0」
+		}
+		static void write(uint8_t v) { uart_model::get().uc1 = v; }
+	};
+	struct uc1_t : public reg_t<uc1_io> {
+		using reg_t<uc1_io>::operator =;
+		bits_t<uc1_io, 0> TE;
+		bits_t<uc1_io, 1> TI;
+		bits_t<uc1_io, 2> RE;
+		bits_t<uc1_io, 3> RI;
+	};
+
+
+	struct urb_io {
+		typedef uint16_t value_type;
+		static uint16_t read() { return 0; }
+		static void write(uint16_t v) { }
+	};
+	struct urb_t : public reg_t<urb_io> {
+		bits_t<urb_io, 12> OER;
+		bits_t<urb_io, 13> FER;
+		bits_t<urb_io, 14> PER;
+		bits_t<urb_io, 15> SUM;
+	};
+
+
+	struct uir_io {
+		typedef uint8_t value_type;
+		static uint8_t read() {
+			auto& m = uart_model::get();
+			return (m.rie ? 0x04 : 0) | (m.ie ? 0x08 : 0) | (m.get_pending() ? 0x80 : 0);
+		}
+		static void write(uint8_t v) {
+			auto& m = uart_model::get();
+			m.rie = (v & 0x04) != 0;
+			m.ie = (v & 0x08) != 0;
+			if((v & 0x80) == 0) m.clear_pending();  // フラグは「0」の書き込みでクリア
+			m.update();
+		}
+	};
+	struct uir_t : public reg_t<uir_io> {
+		using reg_t<uir_io>::operator =;
+		bits_t<uir_io, 2> URIE;
+		bits_t<uir_io, 3> UTIE;
+		bits_t<uir_io, 6> URIF;
+		bits_t<uir_io, 7> UTIF;
+	};
+}
+
+
+namespace device {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	UART0（シミュレーター）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <uint16_t base>
+	struct uart {
+		static sim::umr_t	UMR;
+		static sim::reg_t<sim::ubrg_io>	UBRG;
+		static sim::reg_t<sim::utbl_io>	UTBL;
+		static sim::uc0_t	UC0;
+		static sim::uc1_t	UC1;
+		static sim::urb_t	URB;
+		static sim::uir_t	UIR;
+	};
+	template <uint16_t base> sim::umr_t uart<base>::UMR;
+	template <uint16_t base> sim::reg_t<sim::ubrg_io> uart<base>::UBRG;
+	template <uint16_t base> sim::reg_t<sim::utbl_io> uart<base>::UTBL;
+	template <uint16_t base> sim::uc0_t uart<base>::UC0;
+	template <uint16_t base> sim::uc1_t uart<base>::UC1;
+	template <uint16_t base> sim::urb_t uart<base>::URB;
+	template <uint16_t base> sim::uir_t uart<base>::UIR;
+
+	typedef uart<0x0080> UART0;
+}
@@ -0,0 +1,13 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	R8C グループ・ベクター関係定義（ホスト用の代替） @n
+			割り込み関数は、シミュレーターから普通の関数として呼ぶ。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+
+#define INTERRUPT_FUNC
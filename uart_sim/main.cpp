@@ -0,0 +1,212 @@
+//=====================================================================//
+/*!	@file
+	@brief	UART 送信モデルで、uart_io の putch、write、write_ref を評価する @n
+			テレメトリー（バイナリーのフレーム）を、一定の処理時間毎に送り、@n
+			送信の待ちで止まったクロック数、割り込み回数、送信データの一致を @n
+			表示する。割り込みを使わない（ポーリング）場合と、write_ref の後に @n
+			puts した場合の順番、CRLF の変換も検査する。@n
+			使い方： uart_sim [-baud rate] [-frames n] [-size bytes] [-work clocks]
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2021 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/R8C/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include "M120AN/uart.hpp"
+
+namespace {
+
+	// 待ちループ（sleep_）一回のクロック数
+	static const uint32_t NOP_CYCLES = 8;
+
+	uint64_t	blocked_;
+
+	void nop_()
+	{
+		blocked_ += NOP_CYCLES;
+		sim::uart_model::get().step(NOP_CYCLES);
+	}
+}
+
+// uart_io の待ち（asm("nop")）で、モデルの時間を進める
+#define asm(x) nop_()
+#include "common/uart_io.hpp"
+#undef asm
+#include "common/fifo.hpp"
+
+namespace {
+
+	typedef utils::fifo<uint8_t, 32> TX_BUFF;
+	typedef utils::fifo<uint8_t, 16> RX_BUFF;
+	typedef device::uart_io<device::UART0, TX_BUFF, RX_BUFF> UART;
+	UART	uart_;
+
+	void tx_task_()
+	{
+		uart_.isend();
+	}
+
+	enum class method : uint8_t {
+		PUTCH,
+		WRITE,
+		WRITE_REF,
+	};
+
+	struct result_t {
+		uint64_t	clock;
+		uint64_t	blocked;
+		uint32_t	isr;
+		bool		ok;
+	};
+
+
+	void make_frame_(uint8_t* dst, uint16_t size, uint32_t no)
+	{
+		for(uint16_t i = 0; i < size; ++i) {
+			dst[i] = static_cast<uint8_t>(no * 31 + i * 7);
+		}
+	}
+
+
+	// 送信が終わるまで、時間を進める
+	void drain_()
+	{
+		auto& m = sim::uart_model::get();
+		while(uart_.ref_busy() || !m.get_txept()) {
+			m.step(NOP_CYCLES);
+		}
+	}
+
+
+	result_t run_(method mt, uint32_t frames, uint16_t size, uint32_t work)
+	{
+		auto& m = sim::uart_model::get();
+		drain_();
+		m.reset_count();
+		blocked_ = 0;
+
+		std::vector<uint8_t> expect;
+		std::vector<uint8_t> buf[2];
+		buf[0].resize(size);
+		buf[1].resize(size);
+		for(uint32_t no = 0; no < frames; ++no) {
+			auto& b = buf[no & 1];
+			make_frame_(b.data(), size, no);
+			expect.insert(expect.end(), b.begin(), b.end());
+			switch(mt) {
+			case method::PUTCH:
+				for(uint16_t i = 0; i < size; ++i) uart_.putch(b[i]);
+				break;
+			case method::WRITE:
+				uart_.write(b.data(), size);
+				break;
+			case method::WRITE_REF:
+				uart_.write_ref(b.data(), size);  // 前のフレームの完了を待つので、二面で回す
+				break;
+			}
+			m.step(work);  // フレーム間の処理
+		}
+		drain_();
+
+		result_t t;
+		t.clock = m.get_clock();
+		t.blocked = blocked_;
+		t.isr = m.get_isr_count();
+		t.ok = m.get_out() == expect && m.get_overrun() == 0;
+		return t;
+	}
+
+
+	void report_(const char* title, const result_t& t, uint32_t bytes)
+	{
+		std::cout << std::left << std::setw(10) << title << std::right
+			<< (t.ok ? "OK  " : "NG  ")
+			<< std::setw(10) << t.clock << " clocks" << std::setw(10) << t.blocked << " blocked ("
+			<< std::fixed << std::setprecision(1) << std::setw(4)
+			<< static_cast<double>(t.blocked) * 100.0 / static_cast<double>(t.clock) << " %)"
+			<< "  ISR:" << t.isr << " / " << bytes << " bytes" << std::endl;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	uint32_t baud = 115200;
+	uint32_t frames = 200;
+	uint16_t size = 32;
+	uint32_t work = 0;
+	for(int i = 1; i < argc; ++i) {
+		std::string s = argv[i];
+		if(s == "-baud" && (i + 1) < argc) {
+			baud = std::atoi(argv[++i]);
+			if(baud == 0) baud = 115200;
+		} else if(s == "-frames" && (i + 1) < argc) {
+			frames = std::atoi(argv[++i]);
+		} else if(s == "-size" && (i + 1) < argc) {
+			size = std::atoi(argv[++i]);
+			if(size == 0) size = 1;
+		} else if(s == "-work" && (i + 1) < argc) {
+			work = std::atoi(argv[++i]);
+		} else {
+			std::cout << "UART transmit model for uart_io" << std::endl;
+			std::cout << "usage: " << argv[0] << " [-baud rate] [-frames n] [-size bytes] [-work clocks]"
+				<< std::endl;
+			return 0;
+		}
+	}
+
+	auto& m = sim::uart_model::get();
+	uint32_t byte_cycles = F_CLK / baud * 10;
+	m.set_byte_cycles(byte_cycles);
+	m.set_tx_task(tx_task_);
+	if(work == 0) work = byte_cycles * size * 9 / 10;  // 回線の約９割を使う
+	std::cout << "Baud: " << baud << ", " << byte_cycles << " clocks/byte, frame: " << size
+		<< " bytes, work: " << work << " clocks/frame" << std::endl;
+
+	int err = 0;
+	uart_.start(baud, 1);
+	uart_.auto_crlf(false);
+
+	uint32_t bytes = frames * size;
+	auto p = run_(method::PUTCH, frames, size, work);
+	report_("putch", p, bytes);
+	auto w = run_(method::WRITE, frames, size, work);
+	report_("write", w, bytes);
+	auto r = run_(method::WRITE_REF, frames, size, work);
+	report_("write_ref", r, bytes);
+	if(!p.ok || !w.ok || !r.ok) ++err;
+
+	// write_ref の後の puts は、順番を守り、CRLF に変換する事
+	uart_.auto_crlf(true);
+	drain_();
+	m.reset_count();
+	static const char bin[] = { 'B', 'I', 'N', '\n', 0x00, 0x7f };
+	uart_.write_ref(bin, sizeof(bin));
+	uart_.puts("ab\ncd\n");
+	uart_.putch('e');
+	drain_();
+	std::string s(m.get_out().begin(), m.get_out().end());
+	std::string e = std::string(bin, sizeof(bin)) + "ab\r\ncd\r\ne";
+	bool ok = s == e && m.get_overrun() == 0;
+	std::cout << "order     " << (ok ? "OK" : "NG") << std::endl;
+	if(!ok) ++err;
+
+	// ポーリング
+	uart_.start(baud, 0);
+	m.reset_count();
+	uart_.write_ref(bin, sizeof(bin));
+	uart_.write("xyz", 3);
+	drain_();
+	s.assign(m.get_out().begin(), m.get_out().end());
+	ok = s == std::string(bin, sizeof(bin)) + "xyz" && m.get_isr_count() == 0 && m.get_overrun() == 0;
+	std::cout << "polling   " << (ok ? "OK" : "NG") << std::endl;
+	if(!ok) ++err;
+
+	std::cout << (err == 0 ? "Pass" : "Fail") << std::endl;
+	return err != 0 ? 1 : 0;
+}